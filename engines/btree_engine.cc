@@ -0,0 +1,428 @@
+#include "ycsbr/engines/btree_engine.h"
+
+#include <cstring>
+#include <limits>
+
+#include "record.h"
+#include "ycsbr/impl/util.h"
+
+namespace ycsbr {
+namespace engines {
+
+namespace {
+
+// A node's version is incremented by 0b100 on every modification. Bit 0b10 is
+// set while a writer holds the node's lock.
+constexpr uint64_t kLockedBit = 0b10;
+
+}  // namespace
+
+// The nodes' contents are written under the node's lock but read without it;
+// readers only trust what they read if the node's version did not change.
+struct BTreeEngine::Node {
+  explicit Node(bool is_leaf) : version(0b100), count(0), is_leaf(is_leaf) {}
+
+  // Waits until the node is unlocked and returns its version.
+  uint64_t AwaitUnlocked() const {
+    uint64_t current = version.load(std::memory_order_acquire);
+    while ((current & kLockedBit) != 0) {
+      impl::CpuRelax();
+      current = version.load(std::memory_order_acquire);
+    }
+    return current;
+  }
+
+  // Returns true if the node did not change since `start_version` was read,
+  // meaning that anything read from the node in between is consistent.
+  bool Validate(uint64_t start_version) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return version.load(std::memory_order_relaxed) == start_version;
+  }
+
+  // Locks the node if it did not change since `start_version` was read.
+  bool TryLock(uint64_t start_version) {
+    return version.compare_exchange_strong(start_version,
+                                           start_version + kLockedBit,
+                                           std::memory_order_acquire);
+  }
+
+  // Unlocks the node and increments its version.
+  void Unlock() { version.fetch_add(kLockedBit, std::memory_order_release); }
+
+  std::atomic<uint64_t> version;
+  uint32_t count;
+  const bool is_leaf;
+};
+
+// `keys[i]` is the largest key in the subtree `children[i]`; the last child
+// holds the keys larger than `keys[count - 1]`.
+struct BTreeEngine::InnerNode : public Node {
+  static constexpr size_t kMaxKeys = 63;
+
+  InnerNode() : Node(/*is_leaf=*/false) {}
+
+  bool IsFull() const { return count == kMaxKeys; }
+
+  // Returns the index of the child whose subtree holds `key`.
+  size_t LowerBound(const Request::Key key) const {
+    size_t lower = 0, upper = count;
+    while (lower < upper) {
+      const size_t mid = lower + (upper - lower) / 2;
+      if (keys[mid] < key) {
+        lower = mid + 1;
+      } else {
+        upper = mid;
+      }
+    }
+    return lower;
+  }
+
+  // Adds `right`, the node split off the child that holds `separator`.
+  void Insert(const Request::Key separator, Node* right) {
+    const size_t pos = LowerBound(separator);
+    memmove(keys + pos + 1, keys + pos, sizeof(Request::Key) * (count - pos));
+    memmove(children + pos + 2, children + pos + 1,
+            sizeof(Node*) * (count - pos));
+    keys[pos] = separator;
+    children[pos + 1] = right;
+    ++count;
+  }
+
+  // Moves the upper half of this node into a new node and returns it. The
+  // separator between the two nodes is written to `separator`.
+  InnerNode* Split(Request::Key* separator) {
+    InnerNode* right = new InnerNode();
+    const size_t mid = count / 2;
+    right->count = count - mid - 1;
+    memcpy(right->keys, keys + mid + 1, sizeof(Request::Key) * right->count);
+    memcpy(right->children, children + mid + 1,
+           sizeof(Node*) * (right->count + 1));
+    *separator = keys[mid];
+    count = mid;
+    return right;
+  }
+
+  Request::Key keys[kMaxKeys];
+  Node* children[kMaxKeys + 1];
+};
+
+// The leaves are linked in key order, so that scans can move across them.
+struct BTreeEngine::LeafNode : public Node {
+  static constexpr size_t kMaxKeys = 64;
+
+  LeafNode() : Node(/*is_leaf=*/true), next(nullptr) {}
+
+  bool IsFull() const { return count == kMaxKeys; }
+
+  // Returns the index of the first key at least `key`.
+  size_t LowerBound(const Request::Key key) const {
+    size_t lower = 0, upper = count;
+    while (lower < upper) {
+      const size_t mid = lower + (upper - lower) / 2;
+      if (keys[mid] < key) {
+        lower = mid + 1;
+      } else {
+        upper = mid;
+      }
+    }
+    return lower;
+  }
+
+  void InsertAt(const size_t pos, const Request::Key key, Record* record) {
+    memmove(keys + pos + 1, keys + pos, sizeof(Request::Key) * (count - pos));
+    memmove(records + pos + 1, records + pos, sizeof(Record*) * (count - pos));
+    keys[pos] = key;
+    records[pos] = record;
+    ++count;
+  }
+
+  LeafNode* Split(Request::Key* separator) {
+    LeafNode* right = new LeafNode();
+    const size_t mid = count / 2;
+    right->count = count - mid;
+    memcpy(right->keys, keys + mid, sizeof(Request::Key) * right->count);
+    memcpy(right->records, records + mid, sizeof(Record*) * right->count);
+    right->next = next;
+    count = mid;
+    next = right;
+    *separator = keys[mid - 1];
+    return right;
+  }
+
+  Request::Key keys[kMaxKeys];
+  Record* records[kMaxKeys];
+  LeafNode* next;
+};
+
+BTreeEngine::BTreeEngine() : root_(new LeafNode()) {}
+
+BTreeEngine::~BTreeEngine() { FreeSubtree(root_.load()); }
+
+void BTreeEngine::FreeSubtree(Node* node) {
+  if (node->is_leaf) {
+    LeafNode* leaf = static_cast<LeafNode*>(node);
+    for (size_t i = 0; i < leaf->count; ++i) {
+      delete leaf->records[i];
+    }
+    delete leaf;
+    return;
+  }
+  InnerNode* inner = static_cast<InnerNode*>(node);
+  for (size_t i = 0; i <= inner->count; ++i) {
+    FreeSubtree(inner->children[i]);
+  }
+  delete inner;
+}
+
+void BTreeEngine::BulkLoad(const BulkLoadTrace& load) {
+  for (const auto& req : load) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+void BTreeEngine::BulkLoadPartition(const BulkLoadTrace::Partition& partition) {
+  for (const auto& req : partition) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+bool BTreeEngine::Update(const Request::Key key, const char* value,
+                         const size_t value_size) {
+  Record* record = Find(key);
+  return record != nullptr && record->Update(value, value_size);
+}
+
+bool BTreeEngine::Insert(const Request::Key key, const char* value,
+                         const size_t value_size) {
+  FindOrAdd(key)->Write(value, value_size);
+  return true;
+}
+
+bool BTreeEngine::Delete(const Request::Key key, const char* /*tombstone*/,
+                         const size_t /*tombstone_size*/) {
+  Record* record = Find(key);
+  return record != nullptr && record->Delete();
+}
+
+bool BTreeEngine::Read(const Request::Key key, std::string* value_out) {
+  Record* record = Find(key);
+  return record != nullptr && record->Read(value_out);
+}
+
+bool BTreeEngine::Scan(
+    const Request::Key key, const size_t amount,
+    std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+  scan_out->clear();
+  if (amount == 0) return true;
+  scan_out->reserve(amount);
+  ForEachFrom(key, [amount, scan_out](const Request::Key record_key,
+                                      Record* record) {
+    record->Visit([record_key, scan_out](const std::string& value) {
+      scan_out->emplace_back(record_key, value);
+    });
+    return scan_out->size() < amount;
+  });
+  return true;
+}
+
+bool BTreeEngine::VisitScan(const Request::Key key, const size_t amount,
+                            ScanVisitor& visitor) {
+  if (amount == 0) return true;
+  size_t num_visited = 0;
+  bool keep_going = true;
+  ForEachFrom(key, [amount, &visitor, &num_visited, &keep_going](
+                       const Request::Key record_key, Record* record) {
+    if (record->Visit([record_key, &visitor, &keep_going](
+                          const std::string& value) {
+          keep_going = visitor(record_key, std::string_view(value));
+        })) {
+      ++num_visited;
+    }
+    return keep_going && num_visited < amount;
+  });
+  return true;
+}
+
+BTreeEngine::LeafNode* BTreeEngine::FindLeaf(const Request::Key key,
+                                             uint64_t* version) const {
+  while (true) {
+    Node* node = root_.load(std::memory_order_acquire);
+    uint64_t node_version = node->AwaitUnlocked();
+    // The root may have been split (and replaced) before we read its version.
+    if (node != root_.load(std::memory_order_acquire)) continue;
+
+    bool restart = false;
+    while (!node->is_leaf) {
+      InnerNode* inner = static_cast<InnerNode*>(node);
+      Node* child = inner->children[inner->LowerBound(key)];
+      if (!inner->Validate(node_version)) {
+        restart = true;
+        break;
+      }
+      const uint64_t child_version = child->AwaitUnlocked();
+      if (!inner->Validate(node_version)) {
+        restart = true;
+        break;
+      }
+      node = child;
+      node_version = child_version;
+    }
+    if (restart) continue;
+    *version = node_version;
+    return static_cast<LeafNode*>(node);
+  }
+}
+
+Record* BTreeEngine::Find(const Request::Key key) const {
+  while (true) {
+    uint64_t version;
+    const LeafNode* leaf = FindLeaf(key, &version);
+    const size_t pos = leaf->LowerBound(key);
+    Record* record = pos < leaf->count && leaf->keys[pos] == key
+                         ? leaf->records[pos]
+                         : nullptr;
+    if (leaf->Validate(version)) return record;
+  }
+}
+
+Record* BTreeEngine::FindOrAdd(const Request::Key key) {
+  while (true) {
+    Node* node = root_.load(std::memory_order_acquire);
+    uint64_t version = node->AwaitUnlocked();
+    if (node != root_.load(std::memory_order_acquire)) continue;
+
+    // Full nodes are split on the way down, so the parent of the node being
+    // split always has room for the new separator.
+    InnerNode* parent = nullptr;
+    uint64_t parent_version = 0;
+    bool restart = false;
+    while (!node->is_leaf) {
+      InnerNode* inner = static_cast<InnerNode*>(node);
+      if (inner->IsFull()) {
+        SplitNode(inner, version, parent, parent_version);
+        restart = true;
+        break;
+      }
+      if (parent != nullptr && !parent->Validate(parent_version)) {
+        restart = true;
+        break;
+      }
+      parent = inner;
+      parent_version = version;
+      node = inner->children[inner->LowerBound(key)];
+      if (!inner->Validate(version)) {
+        restart = true;
+        break;
+      }
+      version = node->AwaitUnlocked();
+    }
+    if (restart) continue;
+
+    LeafNode* leaf = static_cast<LeafNode*>(node);
+    if (leaf->IsFull()) {
+      // Avoid splitting the leaf if the key is already there.
+      const size_t pos = leaf->LowerBound(key);
+      Record* existing = pos < leaf->count && leaf->keys[pos] == key
+                             ? leaf->records[pos]
+                             : nullptr;
+      if (!leaf->Validate(version)) continue;
+      if (existing != nullptr) return existing;
+      SplitNode(leaf, version, parent, parent_version);
+      continue;
+    }
+
+    if (!leaf->TryLock(version)) continue;
+    if (parent != nullptr && !parent->Validate(parent_version)) {
+      leaf->Unlock();
+      continue;
+    }
+    const size_t pos = leaf->LowerBound(key);
+    Record* record;
+    if (pos < leaf->count && leaf->keys[pos] == key) {
+      record = leaf->records[pos];
+    } else {
+      record = new Record();
+      leaf->InsertAt(pos, key, record);
+    }
+    leaf->Unlock();
+    return record;
+  }
+}
+
+void BTreeEngine::SplitNode(Node* node, const uint64_t version,
+                            InnerNode* parent, const uint64_t parent_version) {
+  if (parent != nullptr && !parent->TryLock(parent_version)) return;
+  if (!node->TryLock(version)) {
+    if (parent != nullptr) parent->Unlock();
+    return;
+  }
+  if (parent == nullptr && node != root_.load(std::memory_order_acquire)) {
+    // Another thread added a new root above this node.
+    node->Unlock();
+    return;
+  }
+
+  Request::Key separator;
+  Node* right;
+  if (node->is_leaf) {
+    right = static_cast<LeafNode*>(node)->Split(&separator);
+  } else {
+    right = static_cast<InnerNode*>(node)->Split(&separator);
+  }
+  if (parent != nullptr) {
+    parent->Insert(separator, right);
+  } else {
+    MakeRoot(separator, node, right);
+  }
+  node->Unlock();
+  if (parent != nullptr) parent->Unlock();
+}
+
+void BTreeEngine::MakeRoot(const Request::Key separator, Node* left,
+                           Node* right) {
+  InnerNode* root = new InnerNode();
+  root->count = 1;
+  root->keys[0] = separator;
+  root->children[0] = left;
+  root->children[1] = right;
+  root_.store(root, std::memory_order_release);
+}
+
+template <class Callback>
+void BTreeEngine::ForEachFrom(const Request::Key start,
+                              Callback&& callback) const {
+  // The entries of the current leaf are copied out while the leaf is
+  // unchanged, and the callback runs on the copies.
+  Request::Key keys[LeafNode::kMaxKeys];
+  Record* records[LeafNode::kMaxKeys];
+
+  // The smallest key that has not been visited yet.
+  Request::Key next_key = start;
+  while (true) {
+    uint64_t version;
+    const LeafNode* leaf = FindLeaf(next_key, &version);
+    while (true) {
+      size_t num_entries = 0;
+      for (size_t pos = leaf->LowerBound(next_key); pos < leaf->count;
+           ++pos, ++num_entries) {
+        keys[num_entries] = leaf->keys[pos];
+        records[num_entries] = leaf->records[pos];
+      }
+      const LeafNode* next = leaf->next;
+      // If the leaf changed, search for the next key from the root again.
+      if (!leaf->Validate(version)) break;
+
+      for (size_t i = 0; i < num_entries; ++i) {
+        if (!callback(keys[i], records[i])) return;
+        if (keys[i] == std::numeric_limits<Request::Key>::max()) return;
+        next_key = keys[i] + 1;
+      }
+      if (next == nullptr) return;
+      leaf = next;
+      version = leaf->AwaitUnlocked();
+    }
+  }
+}
+
+}  // namespace engines
+}  // namespace ycsbr
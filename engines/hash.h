@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+namespace ycsbr {
+namespace engines {
+
+// A bijective 64-bit mixing function (the SplitMix64 finalizer). The engines
+// use it to spread keys over hash map shards and skiplist heights, so that
+// dense key ranges do not all land in the same place.
+inline uint64_t MixKey(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+}  // namespace engines
+}  // namespace ycsbr
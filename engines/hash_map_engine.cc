@@ -0,0 +1,91 @@
+#include "ycsbr/engines/hash_map_engine.h"
+
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "hash.h"
+
+namespace ycsbr {
+namespace engines {
+
+// Each shard is on its own cache lines, so that threads working on different
+// shards do not contend on the locks.
+struct alignas(64) HashMapEngine::Shard {
+  mutable std::shared_mutex mutex;
+  std::unordered_map<Request::Key, std::string> records;
+};
+
+HashMapEngine::HashMapEngine() : shards_(new Shard[kNumShards]) {}
+
+HashMapEngine::~HashMapEngine() = default;
+
+HashMapEngine::Shard& HashMapEngine::ShardFor(const Request::Key key) const {
+  return shards_[MixKey(key) % kNumShards];
+}
+
+void HashMapEngine::BulkLoad(const BulkLoadTrace& load) {
+  for (const auto& req : load) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+void HashMapEngine::BulkLoadPartition(
+    const BulkLoadTrace::Partition& partition) {
+  for (const auto& req : partition) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+bool HashMapEngine::Update(const Request::Key key, const char* value,
+                           const size_t value_size) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  auto it = shard.records.find(key);
+  if (it == shard.records.end()) return false;
+  it->second.assign(value, value_size);
+  return true;
+}
+
+bool HashMapEngine::Insert(const Request::Key key, const char* value,
+                           const size_t value_size) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  shard.records[key].assign(value, value_size);
+  return true;
+}
+
+bool HashMapEngine::Delete(const Request::Key key, const char* /*tombstone*/,
+                           const size_t /*tombstone_size*/) {
+  Shard& shard = ShardFor(key);
+  std::unique_lock<std::shared_mutex> lock(shard.mutex);
+  return shard.records.erase(key) > 0;
+}
+
+bool HashMapEngine::Read(const Request::Key key, std::string* value_out) {
+  const Shard& shard = ShardFor(key);
+  std::shared_lock<std::shared_mutex> lock(shard.mutex);
+  const auto it = shard.records.find(key);
+  if (it == shard.records.end()) return false;
+  value_out->assign(it->second);
+  return true;
+}
+
+bool HashMapEngine::Scan(
+    const Request::Key /*key*/, const size_t /*amount*/,
+    std::vector<std::pair<Request::Key, std::string>>* /*scan_out*/) {
+  // The records are not kept in key order.
+  return false;
+}
+
+size_t HashMapEngine::NumRecords() const {
+  size_t num_records = 0;
+  for (size_t i = 0; i < kNumShards; ++i) {
+    std::shared_lock<std::shared_mutex> lock(shards_[i].mutex);
+    num_records += shards_[i].records.size();
+  }
+  return num_records;
+}
+
+}  // namespace engines
+}  // namespace ycsbr
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+
+#include "ycsbr/impl/util.h"
+
+namespace ycsbr {
+namespace engines {
+
+// A record's value, guarded by a spin lock. The ordered engines index records
+// by pointer and never free a record while the engine exists, so readers can
+// follow a pointer found through an optimistic traversal without any memory
+// reclamation scheme. A deleted record stays in the index (and is revived by
+// a later insert).
+//
+// A new record starts out deleted; it becomes visible once its first value is
+// written.
+class Record {
+ public:
+  Record() : locked_(false), deleted_(true) {}
+
+  Record(const Record&) = delete;
+  Record& operator=(const Record&) = delete;
+
+  // Writes the value (reviving the record if it was deleted).
+  void Write(const char* value, size_t value_size) {
+    Lock();
+    value_.assign(value, value_size);
+    deleted_ = false;
+    Unlock();
+  }
+
+  // Writes the value only if the record exists. Returns false otherwise.
+  bool Update(const char* value, size_t value_size) {
+    Lock();
+    const bool exists = !deleted_;
+    if (exists) value_.assign(value, value_size);
+    Unlock();
+    return exists;
+  }
+
+  // Returns false if the record did not exist.
+  bool Delete() {
+    Lock();
+    const bool existed = !deleted_;
+    deleted_ = true;
+    value_.clear();
+    Unlock();
+    return existed;
+  }
+
+  // Returns false if the record does not exist.
+  bool Read(std::string* value_out) {
+    Lock();
+    const bool exists = !deleted_;
+    if (exists) value_out->assign(value_);
+    Unlock();
+    return exists;
+  }
+
+  // Calls `visitor(value)` (with the lock held) if the record exists. Returns
+  // false if the record does not exist.
+  template <class Visitor>
+  bool Visit(Visitor&& visitor) {
+    Lock();
+    const bool exists = !deleted_;
+    if (exists) visitor(value_);
+    Unlock();
+    return exists;
+  }
+
+ private:
+  void Lock() {
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        impl::CpuRelax();
+      }
+    }
+  }
+  void Unlock() { locked_.store(false, std::memory_order_release); }
+
+  std::atomic<bool> locked_;
+  bool deleted_;
+  std::string value_;
+};
+
+}  // namespace engines
+}  // namespace ycsbr
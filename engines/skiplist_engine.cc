@@ -0,0 +1,205 @@
+#include "ycsbr/engines/skiplist_engine.h"
+
+#include <atomic>
+#include <new>
+
+#include "hash.h"
+#include "record.h"
+
+namespace ycsbr {
+namespace engines {
+
+// A node is allocated with room for `height` next pointers (the array is
+// declared with one element and over-allocated, as in LevelDB's skiplist).
+struct SkipListEngine::Node {
+  Node(const Request::Key key, const int height) : key(key), height(height) {
+    for (int level = 0; level < height; ++level) {
+      new (&next[level]) std::atomic<Node*>(nullptr);
+    }
+  }
+
+  Node* Next(const int level) const {
+    return next[level].load(std::memory_order_acquire);
+  }
+
+  const Request::Key key;
+  const int height;
+  Record record;
+  std::atomic<Node*> next[1];
+};
+
+SkipListEngine::SkipListEngine() : head_(NewNode(0, kMaxHeight)) {}
+
+SkipListEngine::~SkipListEngine() {
+  Node* node = head_;
+  while (node != nullptr) {
+    Node* next = node->Next(0);
+    FreeNode(node);
+    node = next;
+  }
+}
+
+SkipListEngine::Node* SkipListEngine::NewNode(const Request::Key key,
+                                              const int height) {
+  void* memory = ::operator new(sizeof(Node) +
+                                sizeof(std::atomic<Node*>) * (height - 1));
+  return new (memory) Node(key, height);
+}
+
+void SkipListEngine::FreeNode(Node* node) {
+  node->~Node();
+  ::operator delete(node);
+}
+
+int SkipListEngine::HeightFor(const Request::Key key) {
+  // Each level holds about a quarter of the nodes of the level below it.
+  uint64_t bits = MixKey(key);
+  int height = 1;
+  while (height < kMaxHeight && (bits & 0b11) == 0) {
+    ++height;
+    bits >>= 2;
+  }
+  return height;
+}
+
+void SkipListEngine::BulkLoad(const BulkLoadTrace& load) {
+  for (const auto& req : load) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+void SkipListEngine::BulkLoadPartition(
+    const BulkLoadTrace::Partition& partition) {
+  for (const auto& req : partition) {
+    Insert(req.key, req.value, req.value_size);
+  }
+}
+
+bool SkipListEngine::Update(const Request::Key key, const char* value,
+                            const size_t value_size) {
+  Node* node = FindGreaterOrEqual(key);
+  return node != nullptr && node->key == key &&
+         node->record.Update(value, value_size);
+}
+
+bool SkipListEngine::Insert(const Request::Key key, const char* value,
+                            const size_t value_size) {
+  FindOrAdd(key)->Write(value, value_size);
+  return true;
+}
+
+bool SkipListEngine::Delete(const Request::Key key, const char* /*tombstone*/,
+                            const size_t /*tombstone_size*/) {
+  Node* node = FindGreaterOrEqual(key);
+  return node != nullptr && node->key == key && node->record.Delete();
+}
+
+bool SkipListEngine::Read(const Request::Key key, std::string* value_out) {
+  Node* node = FindGreaterOrEqual(key);
+  return node != nullptr && node->key == key && node->record.Read(value_out);
+}
+
+bool SkipListEngine::Scan(
+    const Request::Key key, const size_t amount,
+    std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+  scan_out->clear();
+  if (amount == 0) return true;
+  scan_out->reserve(amount);
+  for (Node* node = FindGreaterOrEqual(key);
+       node != nullptr && scan_out->size() < amount; node = node->Next(0)) {
+    const Request::Key node_key = node->key;
+    node->record.Visit([node_key, scan_out](const std::string& value) {
+      scan_out->emplace_back(node_key, value);
+    });
+  }
+  return true;
+}
+
+bool SkipListEngine::VisitScan(const Request::Key key, const size_t amount,
+                               ScanVisitor& visitor) {
+  size_t num_visited = 0;
+  bool keep_going = true;
+  for (Node* node = FindGreaterOrEqual(key);
+       node != nullptr && keep_going && num_visited < amount;
+       node = node->Next(0)) {
+    const Request::Key node_key = node->key;
+    if (node->record.Visit(
+            [node_key, &visitor, &keep_going](const std::string& value) {
+              keep_going = visitor(node_key, std::string_view(value));
+            })) {
+      ++num_visited;
+    }
+  }
+  return true;
+}
+
+SkipListEngine::Node* SkipListEngine::FindGreaterOrEqual(
+    const Request::Key key) const {
+  Node* node = head_;
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    Node* next = node->Next(level);
+    while (next != nullptr && next->key < key) {
+      node = next;
+      next = node->Next(level);
+    }
+    if (level == 0) return next;
+  }
+  return nullptr;
+}
+
+void SkipListEngine::FindSplice(const Request::Key key, Node** prev,
+                                Node** next) const {
+  Node* node = head_;
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    Node* successor = node->Next(level);
+    while (successor != nullptr && successor->key < key) {
+      node = successor;
+      successor = node->Next(level);
+    }
+    prev[level] = node;
+    next[level] = successor;
+  }
+}
+
+Record* SkipListEngine::FindOrAdd(const Request::Key key) {
+  Node* prev[kMaxHeight];
+  Node* next[kMaxHeight];
+  FindSplice(key, prev, next);
+  if (next[0] != nullptr && next[0]->key == key) return &next[0]->record;
+
+  const int height = HeightFor(key);
+  Node* node = NewNode(key, height);
+
+  // The node is in the list once it is linked into level 0. If another thread
+  // links a node with the same key first, that node is used instead.
+  while (true) {
+    node->next[0].store(next[0], std::memory_order_relaxed);
+    if (prev[0]->next[0].compare_exchange_strong(next[0], node,
+                                                 std::memory_order_release,
+                                                 std::memory_order_relaxed)) {
+      break;
+    }
+    FindSplice(key, prev, next);
+    if (next[0] != nullptr && next[0]->key == key) {
+      FreeNode(node);
+      return &next[0]->record;
+    }
+  }
+
+  // The upper levels only speed up searches, so they are linked afterwards.
+  for (int level = 1; level < height; ++level) {
+    while (true) {
+      node->next[level].store(next[level], std::memory_order_relaxed);
+      if (prev[level]->next[level].compare_exchange_strong(
+              next[level], node, std::memory_order_release,
+              std::memory_order_relaxed)) {
+        break;
+      }
+      FindSplice(key, prev, next);
+    }
+  }
+  return &node->record;
+}
+
+}  // namespace engines
+}  // namespace ycsbr
@@ -1,89 +1,324 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstdlib>
-#include <filesystem>
-#include <fstream>
+#include <cstring>
+#include <future>
 #include <iostream>
-#include <sstream>
+#include <memory>
+#include <stdexcept>
 #include <string>
-#include <unordered_map>
+#include <string_view>
+#include <thread>
+#include <vector>
 
-#include "ycsbr/trace.h"
+#include "ycsb_parser.h"
+#include "ycsbr/impl/thread_pool.h"
 
-namespace fs = std::filesystem;
+// Converts the output of YCSB's `BasicDB` (read from stdin) into a trace that
+// `ycsbr::Trace::LoadFromFile()` can load.
+//
+// The input is processed in large blocks. Each block is split at line
+// boundaries and parsed on all the threads, and each thread's encoded requests
+// are written with one `write()` call. If stdin is a regular file (e.g.,
+// `ycsbextractor out.ycsb < ycsb.log`), it is memory-mapped instead of read.
 
 namespace {
 
-using Op = ycsbr::Request::Operation;
+using ycsbr::extractors::ParsedRequest;
 
-const std::unordered_map<std::string, Op> kStringToOp = {
-    {"INSERT", Op::kInsert},
-    {"READ", Op::kRead},
-    {"UPDATE", Op::kUpdate},
-    {"SCAN", Op::kScan}};
+// The amount of input parsed at a time.
+constexpr size_t kBlockSize = 64ULL << 20;
 
-void ExtractYCSBTrace(const std::string& output_file) {
-  std::ofstream output(output_file, std::ios::out | std::ios::binary);
-  if (!output) {
-    throw std::runtime_error(
-        "Failed to load workload from file. Error opening: " + output_file);
+// Produces the input in blocks that end right after a newline (except for the
+// last block, if the input does not end with a newline).
+class InputReader {
+ public:
+  explicit InputReader(const int fd)
+      : fd_(fd),
+        mapping_(nullptr),
+        mapping_size_(0),
+        offset_(0),
+        buffer_size_(0),
+        buffered_(0),
+        consumed_(0),
+        eof_(false) {
+    struct stat info;
+    if (fstat(fd_, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+      void* mapping =
+          mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+      if (mapping != MAP_FAILED) {
+        madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+        mapping_ = static_cast<const char*>(mapping);
+        mapping_size_ = info.st_size;
+        return;
+      }
+    }
+    buffer_size_ = kBlockSize;
+    buffer_.reset(new char[buffer_size_]);
   }
-  output.exceptions(std::ofstream::failbit | std::ofstream::badbit);
 
-  std::string line;
-  while (std::getline(std::cin, line)) {
-    std::istringstream iss(line);
-    iss.exceptions(std::istringstream::failbit | std::istringstream::badbit);
+  ~InputReader() {
+    if (mapping_ != nullptr) {
+      munmap(const_cast<char*>(mapping_), mapping_size_);
+    }
+  }
 
-    std::string op_candidate;
-    iss >> op_candidate;
+  InputReader(const InputReader&) = delete;
+  InputReader& operator=(const InputReader&) = delete;
 
-    const auto& it = kStringToOp.find(op_candidate);
-    if (it == kStringToOp.end()) {
-      // Not a request output.
-      continue;
+  // Returns an empty view once the input is exhausted. The returned view is
+  // valid until the next call.
+  std::string_view NextBlock() {
+    return mapping_ != nullptr ? NextMappedBlock() : NextReadBlock();
+  }
+
+ private:
+  std::string_view NextMappedBlock() {
+    const char* begin = mapping_ + offset_;
+    const char* const end = mapping_ + mapping_size_;
+    if (begin == end) return std::string_view();
+    const char* block_end =
+        static_cast<size_t>(end - begin) <= kBlockSize
+            ? end
+            : ycsbr::extractors::FindNewline(begin + kBlockSize, end);
+    if (block_end < end) ++block_end;
+    offset_ = block_end - mapping_;
+    return std::string_view(begin, block_end - begin);
+  }
+
+  std::string_view NextReadBlock() {
+    // Keep the partial line left over from the previous block.
+    const size_t leftover = buffered_ - consumed_;
+    memmove(buffer_.get(), buffer_.get() + consumed_, leftover);
+    buffered_ = leftover;
+    consumed_ = 0;
+
+    while (!eof_) {
+      if (buffered_ == buffer_size_) {
+        // The block holds a partial line at most; grow it.
+        if (memchr(buffer_.get(), '\n', buffered_) != nullptr) break;
+        std::unique_ptr<char[]> larger(new char[buffer_size_ * 2]);
+        memcpy(larger.get(), buffer_.get(), buffered_);
+        buffer_ = std::move(larger);
+        buffer_size_ *= 2;
+      }
+      const ssize_t bytes_read =
+          read(fd_, buffer_.get() + buffered_, buffer_size_ - buffered_);
+      if (bytes_read < 0) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error(std::string("Failed to read the input: ") +
+                                 strerror(errno));
+      }
+      if (bytes_read == 0) {
+        eof_ = true;
+      }
+      buffered_ += bytes_read;
     }
-    const Op operation = it->second;
 
-    std::string key_string, discard;
-    iss >> discard;
-    iss >> key_string;
+    if (eof_) {
+      consumed_ = buffered_;
+      return std::string_view(buffer_.get(), buffered_);
+    }
+    // Stop after the last complete line.
+    const char* begin = buffer_.get();
+    const void* last_newline = memrchr(begin, '\n', buffered_);
+    consumed_ = static_cast<const char*>(last_newline) - begin + 1;
+    return std::string_view(begin, consumed_);
+  }
+
+  const int fd_;
+
+  // Used if the input is a regular file.
+  const char* mapping_;
+  size_t mapping_size_;
+  size_t offset_;
+
+  // Used otherwise (e.g., if the input is a pipe).
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_size_;
+  size_t buffered_;
+  size_t consumed_;
+  bool eof_;
+};
+
+class OutputFile {
+ public:
+  // Fails if the file already exists, to avoid overwriting an existing trace.
+  explicit OutputFile(const std::string& path)
+      : fd_(open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL, 0644)) {
+    if (fd_ < 0) {
+      throw std::runtime_error("Failed to create the output file " + path +
+                               ": " + strerror(errno));
+    }
+  }
+  ~OutputFile() { close(fd_); }
+
+  OutputFile(const OutputFile&) = delete;
+  OutputFile& operator=(const OutputFile&) = delete;
 
-    const ycsbr::Request::Key key =
-        strtoull(key_string.c_str() + 4, nullptr, 10);
-    const ycsbr::Request::Encoded encoded(operation, key);
-    output.write(reinterpret_cast<const char*>(&encoded), sizeof(encoded));
+  void Write(std::string_view data) {
+    while (!data.empty()) {
+      const ssize_t written = write(fd_, data.data(), data.size());
+      if (written < 0) {
+        if (errno == EINTR) continue;
+        throw std::runtime_error(
+            std::string("Failed to write to the output file: ") +
+            strerror(errno));
+      }
+      data.remove_prefix(written);
+    }
+  }
 
-    // Encode the scan amount if the request is a SCAN operation
-    if (operation != Op::kScan) {
+ private:
+  const int fd_;
+};
+
+// Sorts `requests` by key using all the threads in `pool`: each thread sorts a
+// run, and then the runs are merged pairwise.
+void ParallelSort(std::vector<ParsedRequest>& requests,
+                  ycsbr::impl::ThreadPool& pool) {
+  const size_t num_runs = pool.NumThreads();
+  std::vector<size_t> bounds;
+  for (size_t i = 0; i <= num_runs; ++i) {
+    bounds.push_back(requests.size() * i / num_runs);
+  }
+  std::vector<std::future<void>> done;
+  for (size_t i = 0; i < num_runs; ++i) {
+    done.push_back(pool.Submit([&requests, &bounds, i]() {
+      std::stable_sort(requests.begin() + bounds[i],
+                       requests.begin() + bounds[i + 1]);
+    }));
+  }
+  for (auto& future : done) future.get();
+
+  for (size_t width = 1; width < num_runs; width *= 2) {
+    done.clear();
+    for (size_t i = 0; i + width < num_runs; i += 2 * width) {
+      const size_t begin = bounds[i];
+      const size_t middle = bounds[i + width];
+      const size_t end = bounds[std::min(i + 2 * width, num_runs)];
+      done.push_back(pool.Submit([&requests, begin, middle, end]() {
+        std::inplace_merge(requests.begin() + begin, requests.begin() + middle,
+                           requests.begin() + end);
+      }));
+    }
+    for (auto& future : done) future.get();
+  }
+}
+
+void ExtractYCSBTrace(const std::string& output_file, const size_t num_threads,
+                      const bool sort_requests) {
+  InputReader input(STDIN_FILENO);
+  OutputFile output(output_file);
+  ycsbr::impl::ThreadPool pool(
+      num_threads, []() {}, []() {});
+
+  std::vector<ParsedRequest> requests;
+  while (true) {
+    const std::string_view block = input.NextBlock();
+    if (block.empty()) break;
+    const auto slices = ycsbr::extractors::SplitAtNewlines(
+        block.data(), block.data() + block.size(), num_threads);
+
+    if (sort_requests) {
+      // Keep the parsed requests; they are sorted and written at the end.
+      std::vector<std::future<std::vector<ParsedRequest>>> parsed;
+      for (const auto& slice : slices) {
+        parsed.push_back(pool.Submit([slice]() {
+          std::vector<ParsedRequest> slice_requests;
+          ycsbr::extractors::ParseLines(
+              slice.data(), slice.data() + slice.size(), &slice_requests);
+          return slice_requests;
+        }));
+      }
+      for (auto& future : parsed) {
+        const std::vector<ParsedRequest> slice_requests = future.get();
+        requests.insert(requests.end(), slice_requests.begin(),
+                        slice_requests.end());
+      }
       continue;
     }
 
-    std::string scan_amount_string;
-    iss >> scan_amount_string;
+    std::vector<std::future<std::string>> encoded;
+    for (const auto& slice : slices) {
+      encoded.push_back(pool.Submit([slice]() {
+        std::string out;
+        // Encoded requests are much shorter than YCSB's output lines.
+        out.reserve(slice.size() / 2);
+        ycsbr::extractors::ParseAndEncodeLines(
+            slice.data(), slice.data() + slice.size(), &out);
+        return out;
+      }));
+    }
+    // The slices are written in order, so the trace keeps the input's order.
+    for (auto& future : encoded) {
+      output.Write(future.get());
+    }
+  }
 
-    const uint32_t scan_amount =
-        strtoul(scan_amount_string.c_str(), nullptr, 10);
-    output.write(reinterpret_cast<const char*>(&scan_amount),
-                 sizeof(scan_amount));
+  if (!sort_requests) return;
+  ParallelSort(requests, pool);
+  std::string out;
+  out.reserve(kBlockSize + sizeof(ycsbr::Request::Encoded) + sizeof(uint32_t));
+  for (const auto& request : requests) {
+    ycsbr::extractors::AppendEncoded(request, &out);
+    if (out.size() >= kBlockSize) {
+      output.Write(out);
+      out.clear();
+    }
   }
+  output.Write(out);
+}
+
+void PrintUsage(const char* program) {
+  std::cerr << "Usage: " << program
+            << " [--threads=<n>] [--sort] <output file> < <YCSB output>"
+            << std::endl
+            << "  --threads=<n>  Parse with <n> threads (default: all cores)."
+            << std::endl
+            << "  --sort         Sort the requests by key (e.g., for load "
+               "traces)."
+            << std::endl;
 }
 
 }  // namespace
 
 int main(int argc, char* argv[]) {
-  if (argc != 2) {
-    std::cerr << "Usage: " << argv[0] << " <output file>" << std::endl;
+  size_t num_threads = std::max(1U, std::thread::hardware_concurrency());
+  bool sort_requests = false;
+  std::string output_file;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    if (arg == "--sort") {
+      sort_requests = true;
+    } else if (arg.rfind("--threads=", 0) == 0) {
+      num_threads = strtoul(arg.c_str() + strlen("--threads="), nullptr, 10);
+      if (num_threads == 0) {
+        PrintUsage(argv[0]);
+        return 1;
+      }
+    } else if (output_file.empty() && arg.rfind("--", 0) != 0) {
+      output_file = arg;
+    } else {
+      PrintUsage(argv[0]);
+      return 1;
+    }
+  }
+  if (output_file.empty()) {
+    PrintUsage(argv[0]);
     return 1;
   }
 
-  const std::string output_file(argv[1]);
-  if (fs::exists(output_file)) {
-    std::cerr
-        << "ERROR: Output file already exists. Aborting to avoid overwriting."
-        << std::endl;
+  try {
+    ExtractYCSBTrace(output_file, num_threads, sort_requests);
+  } catch (const std::exception& ex) {
+    std::cerr << "ERROR: " << ex.what() << std::endl;
     return 1;
   }
-
-  ExtractYCSBTrace(output_file);
-
   return 0;
 }
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ycsbr/request.h"
+
+namespace ycsbr {
+namespace extractors {
+
+// A request parsed from YCSB's output (e.g., from its `BasicDB`, which prints
+// one line per request such as `READ usertable user6284781860667377211 [...]`).
+struct ParsedRequest {
+  ParsedRequest() : ParsedRequest(Request::Operation::kRead, 0, 0) {}
+  ParsedRequest(Request::Operation op, Request::Key key, uint32_t scan_amount)
+      : key(key), scan_amount(scan_amount), op(op) {}
+
+  bool operator<(const ParsedRequest& other) const { return key < other.key; }
+
+  Request::Key key;
+  uint32_t scan_amount;
+  Request::Operation op;
+};
+
+// Returns a pointer to the first newline in `[begin, end)`, or `end` if there
+// is none. `memchr()` is vectorized in glibc (SSE2/AVX2/EVEX), so this scans
+// many bytes per instruction.
+inline const char* FindNewline(const char* begin, const char* end) {
+  const void* newline = memchr(begin, '\n', end - begin);
+  return newline == nullptr ? end : static_cast<const char*>(newline);
+}
+
+// Parses one line of YCSB output (without its newline). Returns false if the
+// line is not a request (e.g., a status or summary line).
+inline bool ParseLine(const char* begin, const char* end, ParsedRequest* out);
+
+// Parses every line in `[begin, end)` and appends the requests to `out`.
+inline void ParseLines(const char* begin, const char* end,
+                       std::vector<ParsedRequest>* out);
+
+// Appends `request` to `out`, encoded in the trace format that
+// `Trace::LoadFromFile()` reads.
+inline void AppendEncoded(const ParsedRequest& request, std::string* out);
+
+// Parses every line in `[begin, end)` and appends the encoded requests to
+// `out`. Returns the number of requests.
+inline size_t ParseAndEncodeLines(const char* begin, const char* end,
+                                  std::string* out);
+
+// Splits `[begin, end)` into at most `num_slices` slices of about the same
+// size that each end right after a newline (except possibly the last one).
+inline std::vector<std::string_view> SplitAtNewlines(const char* begin,
+                                                     const char* end,
+                                                     size_t num_slices);
+
+// Implementation details follow.
+
+namespace internal {
+
+inline const char* SkipSpaces(const char* pos, const char* end) {
+  while (pos < end && (*pos == ' ' || *pos == '\t')) ++pos;
+  return pos;
+}
+
+inline const char* SkipToken(const char* pos, const char* end) {
+  while (pos < end && *pos != ' ' && *pos != '\t') ++pos;
+  return pos;
+}
+
+inline bool IsDigit(const char c) { return c >= '0' && c <= '9'; }
+
+// Parses the decimal number at the start of `[*pos, end)` and advances `*pos`
+// past it. Returns false if there are no digits.
+inline bool ParseNumber(const char** pos, const char* end, uint64_t* value) {
+  const char* digit = *pos;
+  uint64_t result = 0;
+  while (digit < end && IsDigit(*digit)) {
+    result = result * 10 + (*digit - '0');
+    ++digit;
+  }
+  if (digit == *pos) return false;
+  *pos = digit;
+  *value = result;
+  return true;
+}
+
+inline bool TokenEquals(const char* begin, const char* end,
+                        std::string_view expected) {
+  return static_cast<size_t>(end - begin) == expected.size() &&
+         memcmp(begin, expected.data(), expected.size()) == 0;
+}
+
+inline bool ParseOperation(const char* begin, const char* end,
+                           Request::Operation* op) {
+  using Op = Request::Operation;
+  switch (end - begin) {
+    case 4:
+      if (TokenEquals(begin, end, "READ")) {
+        *op = Op::kRead;
+        return true;
+      }
+      if (TokenEquals(begin, end, "SCAN")) {
+        *op = Op::kScan;
+        return true;
+      }
+      return false;
+    case 6:
+      if (TokenEquals(begin, end, "UPDATE")) {
+        *op = Op::kUpdate;
+        return true;
+      }
+      if (TokenEquals(begin, end, "INSERT")) {
+        *op = Op::kInsert;
+        return true;
+      }
+      if (TokenEquals(begin, end, "DELETE")) {
+        *op = Op::kDelete;
+        return true;
+      }
+      return false;
+    case 15:
+      if (TokenEquals(begin, end, "READMODIFYWRITE")) {
+        *op = Op::kReadModifyWrite;
+        return true;
+      }
+      return false;
+    default:
+      return false;
+  }
+}
+
+}  // namespace internal
+
+inline bool ParseLine(const char* begin, const char* end, ParsedRequest* out) {
+  const char* pos = internal::SkipSpaces(begin, end);
+  const char* op_end = internal::SkipToken(pos, end);
+  if (!internal::ParseOperation(pos, op_end, &out->op)) return false;
+
+  // Skip the table name.
+  pos = internal::SkipToken(internal::SkipSpaces(op_end, end), end);
+
+  // YCSB keys are a prefix (usually "user") followed by a number.
+  pos = internal::SkipSpaces(pos, end);
+  while (pos < end && !internal::IsDigit(*pos) && *pos != ' ') ++pos;
+  uint64_t key = 0;
+  if (!internal::ParseNumber(&pos, end, &key)) return false;
+  out->key = key;
+
+  out->scan_amount = 0;
+  if (out->op == Request::Operation::kScan) {
+    pos = internal::SkipSpaces(pos, end);
+    uint64_t scan_amount = 0;
+    if (!internal::ParseNumber(&pos, end, &scan_amount)) return false;
+    out->scan_amount = static_cast<uint32_t>(scan_amount);
+  }
+  return true;
+}
+
+inline void ParseLines(const char* begin, const char* end,
+                       std::vector<ParsedRequest>* out) {
+  ParsedRequest request;
+  while (begin < end) {
+    const char* line_end = FindNewline(begin, end);
+    if (ParseLine(begin, line_end, &request)) {
+      out->push_back(request);
+    }
+    begin = line_end + 1;
+  }
+}
+
+inline void AppendEncoded(const ParsedRequest& request, std::string* out) {
+  const Request::Encoded encoded(request.op, request.key);
+  out->append(reinterpret_cast<const char*>(&encoded), sizeof(encoded));
+  // The scan amount directly follows a scan (or range delete, or transaction)
+  // request.
+  if (request.op == Request::Operation::kScan ||
+      request.op == Request::Operation::kDeleteRange ||
+      request.op == Request::Operation::kTransaction) {
+    out->append(reinterpret_cast<const char*>(&request.scan_amount),
+                sizeof(request.scan_amount));
+  }
+}
+
+inline size_t ParseAndEncodeLines(const char* begin, const char* end,
+                                  std::string* out) {
+  size_t num_requests = 0;
+  ParsedRequest request;
+  while (begin < end) {
+    const char* line_end = FindNewline(begin, end);
+    if (ParseLine(begin, line_end, &request)) {
+      AppendEncoded(request, out);
+      ++num_requests;
+    }
+    begin = line_end + 1;
+  }
+  return num_requests;
+}
+
+inline std::vector<std::string_view> SplitAtNewlines(const char* begin,
+                                                     const char* end,
+                                                     const size_t num_slices) {
+  std::vector<std::string_view> slices;
+  const size_t target_size = (end - begin) / num_slices + 1;
+  while (begin < end) {
+    const char* slice_end =
+        static_cast<size_t>(end - begin) <= target_size
+            ? end
+            : FindNewline(begin + target_size, end);
+    if (slice_end < end) ++slice_end;
+    slices.emplace_back(begin, slice_end - begin);
+    begin = slice_end;
+  }
+  return slices;
+}
+
+}  // namespace extractors
+}  // namespace ycsbr
@@ -1,7 +1,10 @@
 #include "config_impl.h"
 
 #include <cassert>
+#include <chrono>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 
 #include "hotspot_keygen.h"
@@ -10,6 +13,7 @@
 #include "uniform_chooser.h"
 #include "uniform_keygen.h"
 #include "yaml-cpp/yaml.h"
+#include "ycsb_properties.h"
 #include "ycsbr/gen/keyrange.h"
 #include "ycsbr/gen/types.h"
 #include "zipfian_chooser.h"
@@ -22,6 +26,9 @@ using namespace ycsbr;
 const std::string kLoadConfigKey = "load";
 const std::string kRunConfigKey = "run";
 const std::string kRecordSizeBytesKey = "record_size_bytes";
+const std::string kKeyEncodingKey = "key_encoding";
+const std::string kValueCompressionRatioKey = "value_compression_ratio";
+const std::string kMemoryKey = "memory";
 
 // Operation keys.
 const std::string kReadOpKey = "read";
@@ -31,18 +38,27 @@ const std::string kInsertOpKey = "insert";
 const std::string kRMWOpKey = "readmodifywrite";
 const std::string kNegativeReadKey = "negativeread";
 const std::string kDeleteOpKey = "delete";                ///////////////////////////
+const std::string kDeleteRangeOpKey = "deleterange";
+const std::string kMergeOpKey = "merge";
+const std::string kCompareAndSwapOpKey = "compareandswap";
+const std::string kTransactionOpKey = "transaction";
+const std::string kValueSizeKey = "value_size";
 
 // Assorted keys.
 const std::string kNumRecordsKey = "num_records";
 const std::string kNumRequestsKey = "num_requests";
+const std::string kDurationKey = "duration_s";
 const std::string kDistributionKey = "distribution";
 const std::string kDistributionTypeKey = "type";
 const std::string kProportionKey = "proportion_pct";
 const std::string kScanMaxLengthKey = "max_length";
+const std::string kTxnNumReadsKey = "num_reads";
+const std::string kTxnNumWritesKey = "num_writes";
 
 // Distribution names and keys.
-// Access operations are read, scan, update, readmodifywrite, and negativeread
-// (i.e., everything except insert).
+// Access operations are read, scan, update, readmodifywrite, negativeread,
+// delete, deleterange, merge, compareandswap, and transaction (i.e.,
+// everything except insert).
 const std::string kUniformDist = "uniform";    // Insert and access ops
 const std::string kZipfianDist = "zipfian";    // Access ops only
 const std::string kHotspotDist = "hotspot";    // Insert ops only
@@ -65,6 +81,28 @@ const std::string kSaltKey = "salt";
 const std::string kCustomNameKey = "name";
 const std::string kCustomOffsetKey = "offset";
 
+// Value size distribution names and keys. The uniform and zipfian
+// distributions use `range_min` and `range_max` (inclusive); zipfian value
+// sizes favor the smallest sizes.
+const std::string kConstantValueSize = "constant";
+const std::string kHistogramValueSize = "histogram";
+const std::string kValueSizeBytesKey = "size_bytes";
+const std::string kHistogramBucketsKey = "buckets";
+const std::string kHistogramWeightKey = "weight";
+
+// Key encoding types and keys.
+const std::string kBigEndianEncoding = "big_endian";
+const std::string kHashedEncoding = "hashed";
+const std::string kKeyPrefixKey = "prefix";
+const std::string kKeySizeBytesKey = "size_bytes";
+const std::string kMinKeySizeBytesKey = "min_size_bytes";
+const std::string kMaxKeySizeBytesKey = "max_size_bytes";
+
+// Memory keys.
+const std::string kHugePagesKey = "huge_pages";
+const std::string kHugetlbfsKey = "hugetlbfs";
+const std::string kNumaNodeKey = "numa_node";
+
 // Only does a quick high-level structural validation. The semantic validation
 // is done when phases are retrieved.
 bool ValidateConfig(const YAML::Node& raw_config) {
@@ -99,6 +137,53 @@ bool ValidateConfig(const YAML::Node& raw_config) {
   return true;
 }
 
+// Creates the chooser for a phase's `value_size` section. Like
+// `CreateChooser()`, this releases the lock while a zipfian chooser is being
+// constructed.
+std::unique_ptr<gen::ValueSizeChooser> CreateValueSizeChooser(
+    std::unique_lock<std::mutex>& lock, const YAML::Node& size_config) {
+  const std::string& dist_type =
+      size_config[kDistributionTypeKey].as<std::string>();
+  if (dist_type == kConstantValueSize) {
+    return std::make_unique<gen::ValueSizeChooser>(
+        size_config[kValueSizeBytesKey].as<size_t>());
+
+  } else if (dist_type == kHistogramValueSize) {
+    std::vector<size_t> sizes;
+    std::vector<double> weights;
+    for (const auto& bucket : size_config[kHistogramBucketsKey]) {
+      sizes.push_back(bucket[kValueSizeBytesKey].as<size_t>());
+      weights.push_back(bucket[kHistogramWeightKey].as<double>());
+    }
+    return std::make_unique<gen::ValueSizeChooser>(std::move(sizes), weights);
+
+  } else if (dist_type == kUniformDist || dist_type == kZipfianDist) {
+    const size_t min_size = size_config[kRangeMinKey].as<size_t>();
+    const size_t max_size = size_config[kRangeMaxKey].as<size_t>();
+    if (max_size < min_size) {
+      throw std::invalid_argument(
+          "The value size range's maximum must not be less than its minimum.");
+    }
+    const size_t num_sizes = max_size - min_size + 1;
+    if (dist_type == kUniformDist) {
+      return std::make_unique<gen::ValueSizeChooser>(
+          min_size, max_size, std::make_unique<gen::UniformChooser>(num_sizes));
+    }
+    const double theta = size_config[kZipfianThetaKey].as<double>();
+    if (theta <= 0.0 || theta >= 1.0) {
+      throw std::invalid_argument("Zipfian theta must be in the range (0, 1).");
+    }
+    lock.unlock();
+    auto chooser = std::make_unique<gen::ValueSizeChooser>(
+        min_size, max_size,
+        std::make_unique<gen::ZipfianChooser>(num_sizes, theta));
+    lock.lock();
+    return chooser;
+  }
+  throw std::invalid_argument("Unsupported value size distribution: " +
+                              dist_type);
+}
+
 // NOTE: This method will release the lock while the chooser is being
 // constructed. It will the reacquire the lock before returning. This is done to
 // avoid holding the lock while creating the generator, which may take a lot of
@@ -249,6 +334,21 @@ std::shared_ptr<WorkloadConfig> WorkloadConfig::LoadFromString(
                                               set_record_size_bytes);
 }
 
+std::shared_ptr<WorkloadConfig> WorkloadConfig::LoadFromYCSBProperties(
+    const std::filesystem::path& properties_file) {
+  std::ifstream in(properties_file);
+  if (!in) {
+    throw std::invalid_argument("Could not open the YCSB property file.");
+  }
+  return std::make_shared<WorkloadConfigImpl>(TranslateYCSBProperties(in));
+}
+
+std::shared_ptr<WorkloadConfig> WorkloadConfig::LoadFromYCSBPropertiesString(
+    const std::string& raw_properties) {
+  std::istringstream in(raw_properties);
+  return std::make_shared<WorkloadConfigImpl>(TranslateYCSBProperties(in));
+}
+
 WorkloadConfigImpl::WorkloadConfigImpl(YAML::Node raw_config,     
                                        const size_t set_record_size_bytes)
     : raw_config_(std::move(raw_config)),        //初始化raw_config
@@ -291,6 +391,58 @@ size_t WorkloadConfigImpl::GetRecordSizeBytes() const {
   return record_size_bytes;
 }
 
+double WorkloadConfigImpl::GetValueCompressionRatio() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  if (!raw_config_[kValueCompressionRatioKey]) {
+    return 1.0;
+  }
+  const double ratio = raw_config_[kValueCompressionRatioKey].as<double>();
+  if (ratio < 1.0) {
+    throw std::invalid_argument(
+        "The value compression ratio must be at least 1.");
+  }
+  return ratio;
+}
+
+KeyEncoder WorkloadConfigImpl::GetKeyEncoder() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const YAML::Node& encoding = raw_config_[kKeyEncodingKey];
+  if (!encoding) {
+    return KeyEncoder();
+  }
+  const std::string prefix =
+      encoding[kKeyPrefixKey] ? encoding[kKeyPrefixKey].as<std::string>() : "";
+  const std::string type = encoding[kDistributionTypeKey].as<std::string>();
+  if (type == kBigEndianEncoding) {
+    return KeyEncoder::BigEndian(prefix,
+                                 encoding[kKeySizeBytesKey].as<size_t>());
+  } else if (type == kHashedEncoding) {
+    return KeyEncoder::Hashed(prefix,
+                              encoding[kMinKeySizeBytesKey].as<size_t>(),
+                              encoding[kMaxKeySizeBytesKey].as<size_t>());
+  }
+  throw std::invalid_argument("Unknown key encoding type: " + type);
+}
+
+MemoryOptions WorkloadConfigImpl::GetMemoryOptions() const {
+  std::unique_lock<std::mutex> lock(mutex_);
+  MemoryOptions options;
+  const YAML::Node& memory = raw_config_[kMemoryKey];
+  if (!memory) {
+    return options;
+  }
+  if (memory[kHugePagesKey]) {
+    options.use_huge_pages = memory[kHugePagesKey].as<bool>();
+  }
+  if (memory[kHugetlbfsKey]) {
+    options.use_hugetlbfs = memory[kHugetlbfsKey].as<bool>();
+  }
+  if (memory[kNumaNodeKey]) {
+    options.numa_node = memory[kNumaNodeKey].as<int>();
+  }
+  return options;
+}
+
 std::unique_ptr<Generator> WorkloadConfigImpl::GetLoadGenerator() const {
   std::unique_lock<std::mutex> lock(mutex_);
   if (UsingCustomDatasetImpl()) {
@@ -326,12 +478,32 @@ Phase WorkloadConfigImpl::GetPhase(const PhaseID phase_id,
   const YAML::Node& phase_config = raw_config_[kRunConfigKey][phase_id];  //将phase_id的任务加载到phase_config中
   Phase phase(phase_id);
 
+  if (!phase_config[kNumRequestsKey] && !phase_config[kDurationKey]) {
+    throw std::invalid_argument("Each phase must specify '" + kNumRequestsKey +
+                                "', '" + kDurationKey + "', or both.");
+  }
+
+  // Duration-based phases run until a deadline that is shared by all
+  // producers. If `num_requests` is also set, it acts as an upper bound.
+  if (phase_config[kDurationKey]) {
+    const double duration_s = phase_config[kDurationKey].as<double>();
+    if (duration_s <= 0) {
+      throw std::invalid_argument("A phase's duration must be positive.");
+    }
+    phase.duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(duration_s));
+  }
+
   // Compute the number of requests for this producer.    //
-  const size_t total_requests = phase_config[kNumRequestsKey].as<size_t>();
-  phase.num_requests = total_requests / num_producers;  //给各producer平分request数量
-  const size_t remainder = total_requests % num_producers;   //没有整除，有剩余的
-  if (producer_id < remainder) {  //如果producer_id小于剩余量，此阶段多加一个request
-    ++phase.num_requests;  
+  if (phase_config[kNumRequestsKey]) {
+    const size_t total_requests = phase_config[kNumRequestsKey].as<size_t>();
+    phase.num_requests = total_requests / num_producers;  //给各producer平分request数量
+    const size_t remainder = total_requests % num_producers;   //没有整除，有剩余的
+    if (producer_id < remainder) {  //如果producer_id小于剩余量，此阶段多加一个request
+      ++phase.num_requests;  
+    }
+  } else {
+    phase.num_requests = Phase::kUnboundedRequests;
   }
   phase.num_requests_left = phase.num_requests;
 
@@ -373,10 +545,10 @@ Phase WorkloadConfigImpl::GetPhase(const PhaseID phase_id,
         CreateChooser(lock, phase_config[kScanOpKey][kDistributionKey], "scan",
                       initial_chooser_size);
 
-    // We need to add 1 because the UniformChooser returns values in a 0-based
-    // exclusive upper range. //++我们需要加1，因为UniformChooser返回的值在基于0的除了上限的范围内。
+    // The chooser returns values in [0, max_scan_length); the producer adds 1
+    // so that scan lengths are in [1, max_scan_length].
     phase.scan_length_chooser =    //scan_length_chooser 
-        std::make_unique<UniformChooser>(phase.max_scan_length + 1);
+        std::make_unique<UniformChooser>(phase.max_scan_length);
   }
   if (phase_config[kUpdateOpKey]) {    //!update
     phase.update_thres =
@@ -391,6 +563,11 @@ Phase WorkloadConfigImpl::GetPhase(const PhaseID phase_id,
   if (phase_config[kDeleteOpKey]) {   //!delete      
     phase.delete_thres = 
         phase_config[kDeleteOpKey][kProportionKey].as<uint32_t>();
+    if (phase.delete_thres > 0 && !phase_config[kNumRequestsKey]) {
+      // The keys to delete are chosen up front.
+      throw std::invalid_argument(
+          "Phases with deletes must specify '" + kNumRequestsKey + "'.");
+    }
     phase.num_deletes = static_cast<size_t>(phase.num_requests * (phase.delete_thres / 100.0));  //计算delete个数
     phase.num_deletes_left = phase.num_deletes;
     //创建chooser
@@ -399,12 +576,73 @@ Phase WorkloadConfigImpl::GetPhase(const PhaseID phase_id,
                       "delete", initial_chooser_size);
   }
   ///////////////////////
+  if (phase_config[kDeleteRangeOpKey]) {
+    phase.deleterange_thres =
+        phase_config[kDeleteRangeOpKey][kProportionKey].as<uint32_t>();
+    phase.max_delete_range_length =
+        phase_config[kDeleteRangeOpKey][kScanMaxLengthKey].as<size_t>();
+    if (phase.max_delete_range_length == 0) {
+      throw std::invalid_argument(
+          "The maximum range delete length must be at least 1.");
+    }
+    phase.deleterange_chooser =
+        CreateChooser(lock, phase_config[kDeleteRangeOpKey][kDistributionKey],
+                      "deleterange", initial_chooser_size);
+    // Like scan lengths, range lengths are in [1, max_delete_range_length].
+    phase.deleterange_length_chooser =
+        std::make_unique<UniformChooser>(phase.max_delete_range_length);
+  }
+  if (phase_config[kMergeOpKey]) {
+    phase.merge_thres =
+        phase_config[kMergeOpKey][kProportionKey].as<uint32_t>();
+    phase.merge_chooser =
+        CreateChooser(lock, phase_config[kMergeOpKey][kDistributionKey],
+                      "merge", initial_chooser_size);
+  }
+  if (phase_config[kCompareAndSwapOpKey]) {
+    phase.cas_thres =
+        phase_config[kCompareAndSwapOpKey][kProportionKey].as<uint32_t>();
+    phase.cas_chooser = CreateChooser(
+        lock, phase_config[kCompareAndSwapOpKey][kDistributionKey],
+        "compareandswap", initial_chooser_size);
+  }
+  if (phase_config[kTransactionOpKey]) {
+    const YAML::Node& txn_config = phase_config[kTransactionOpKey];
+    phase.txn_thres = txn_config[kProportionKey].as<uint32_t>();
+    if (txn_config[kTxnNumReadsKey]) {
+      phase.txn_num_reads = txn_config[kTxnNumReadsKey].as<uint32_t>();
+    }
+    if (txn_config[kTxnNumWritesKey]) {
+      phase.txn_num_writes = txn_config[kTxnNumWritesKey].as<uint32_t>();
+    }
+    if (phase.txn_num_reads + phase.txn_num_writes == 0) {
+      throw std::invalid_argument(
+          "Transactions must read or write at least one key.");
+    }
+    phase.txn_chooser =
+        CreateChooser(lock, txn_config[kDistributionKey], "transaction",
+                      initial_chooser_size);
+  }
+  if (phase_config[kValueSizeKey]) {
+    phase.value_size_chooser =
+        CreateValueSizeChooser(lock, phase_config[kValueSizeKey]);
+    if (phase.value_size_chooser->MinSize() < sizeof(uint32_t)) {
+      throw std::invalid_argument("Values must be at least 4 bytes.");
+    }
+  }
   if (phase_config[kInsertOpKey]) {     //!insert，只收集插入比例
     insert_pct = phase_config[kInsertOpKey][kProportionKey].as<uint32_t>();
+    if (insert_pct > 0 && !phase_config[kNumRequestsKey]) {
+      // The keys to insert are generated up front.
+      throw std::invalid_argument(
+          "Phases with inserts must specify '" + kNumRequestsKey + "'.");
+    }
   }
   if (insert_pct + phase.read_thres + phase.rmw_thres +     //验证这几个操作加起来的比例是否为100
           phase.negativeread_thres + phase.scan_thres + phase.update_thres 
           + phase.delete_thres            ///////////////////////
+          + phase.deleterange_thres + phase.merge_thres + phase.cas_thres
+          + phase.txn_thres
            !=
       100) {
     throw std::invalid_argument(
@@ -423,7 +661,11 @@ Phase WorkloadConfigImpl::GetPhase(const PhaseID phase_id,
   phase.negativeread_thres += phase.rmw_thres;
   phase.scan_thres += phase.negativeread_thres;
   phase.update_thres += phase.scan_thres;
-  phase.delete_thres += phase.update_thres;        ///////////////////
+  phase.deleterange_thres += phase.update_thres;
+  phase.merge_thres += phase.deleterange_thres;
+  phase.cas_thres += phase.merge_thres;
+  phase.txn_thres += phase.cas_thres;
+  phase.delete_thres += phase.txn_thres;        ///////////////////
 
   return phase;
 }
@@ -17,7 +17,10 @@ class WorkloadConfigImpl : public WorkloadConfig {      //继承WorkloadConfig
   bool UsingCustomDataset() const override;
   size_t GetNumLoadRecords() const override;
   size_t GetRecordSizeBytes() const override;
+  double GetValueCompressionRatio() const override;
   std::unique_ptr<Generator> GetLoadGenerator() const override;
+  KeyEncoder GetKeyEncoder() const override;
+  MemoryOptions GetMemoryOptions() const override;
 
   size_t GetNumPhases() const override;
   Phase GetPhase(PhaseID phase_id, ProducerID producer_id,
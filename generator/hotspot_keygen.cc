@@ -75,7 +75,7 @@ HotspotGenerator::HotspotGenerator(const size_t num_keys,
   }
 }
 
-void HotspotGenerator::Generate(PRNG& prng, std::vector<Request::Key>* dest,
+void HotspotGenerator::Generate(PRNG& prng, KeyList* dest,
                                 const size_t start_index) const {
   size_t curr_index = start_index;
   // Before.
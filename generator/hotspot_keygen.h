@@ -15,7 +15,7 @@ class HotspotGenerator : public Generator {
   HotspotGenerator(size_t num_keys, uint32_t hot_proportion_pct,
                    KeyRange overall, KeyRange hot);
 
-  void Generate(PRNG& prng, std::vector<Request::Key>* dest,
+  void Generate(PRNG& prng, KeyList* dest,
                 size_t start_index) const override;
 
  private:
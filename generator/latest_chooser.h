@@ -36,17 +36,16 @@ class LatestChooser : public Chooser {
   }
 
   void IncreaseItemCountBy(size_t delta) override {   
-    //////////////////////////
-    size_t c = 1 ;
-    if (delta != c ) {
-      item_count_ -= 1;
-    }else{
-    //////////////////////////
     item_count_ += delta;
-    }  ////////////////////////
     zipf_.IncreaseItemCountBy(delta);
   }
 
+  void DecreaseItemCountBy(size_t delta) override {
+    assert(item_count_ > delta);
+    item_count_ -= delta;
+    zipf_.DecreaseItemCountBy(delta);
+  }
+
  private:
   size_t item_count_;
   ZipfianChooser zipf_;
@@ -13,7 +13,7 @@ LinspaceGenerator::LinspaceGenerator(size_t num_keys, Request::Key start_key,
   assert(num_keys > 0);
 }
 
-void LinspaceGenerator::Generate(PRNG& prng, std::vector<Request::Key>* dest,
+void LinspaceGenerator::Generate(PRNG& prng, KeyList* dest,
                                  const size_t start_index) const {
   const Request::Key max_key = start_key_ + (num_keys_ - 1) * step_size_;
   size_t i = start_index;
@@ -14,7 +14,7 @@ class LinspaceGenerator : public Generator {
   // Generates keys that are evenly spaced.
   LinspaceGenerator(size_t num_keys, Request::Key start_key, Request::Key step_size);
 
-  void Generate(PRNG& prng, std::vector<Request::Key>* dest,
+  void Generate(PRNG& prng, KeyList* dest,
                 size_t start_index) const override;
 
  private:
@@ -7,10 +7,10 @@
 namespace ycsbr {
 namespace gen {
 
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 inline void FloydSample(const size_t num_samples, const Range<T>& range,
-                        std::vector<T>* dest, const size_t start_index,
-                        RNG& rng) {
+                        std::vector<T, Allocator>* dest,
+                        const size_t start_index, RNG& rng) {
   assert(range.size() >= num_samples);
   assert(start_index < dest->size());
   assert(start_index + num_samples <= dest->size());
@@ -34,9 +34,10 @@ inline void FloydSample(const size_t num_samples, const Range<T>& range,
   }
 }
 
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void SelectionSample(const size_t num_samples, const Range<T>& range,
-                     std::vector<T>* dest, const size_t start_index, RNG& rng) {
+                     std::vector<T, Allocator>* dest, const size_t start_index,
+                     RNG& rng) {
   assert(range.size() >= num_samples);
   assert(start_index < dest->size());
   assert(start_index + num_samples <= dest->size());
@@ -54,10 +55,10 @@ void SelectionSample(const size_t num_samples, const Range<T>& range,
   }
 }
 
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void FisherYatesSample(const size_t num_samples, const Range<T>& range,
-                       std::vector<T>* dest, const size_t start_index,
-                       RNG& rng) {
+                       std::vector<T, Allocator>* dest,
+                       const size_t start_index, RNG& rng) {
   assert(range.size() >= num_samples);
   assert(start_index < dest->size());
   assert(start_index + num_samples <= dest->size());
@@ -86,10 +87,10 @@ void FisherYatesSample(const size_t num_samples, const Range<T>& range,
   }
 }
 
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void SampleWithoutReplacement(const size_t num_samples, const Range<T>& range,
-                              std::vector<T>* dest, const size_t start_index,
-                              RNG& rng) {
+                              std::vector<T, Allocator>* dest,
+                              const size_t start_index, RNG& rng) {
   constexpr double floyd_selectivity_threshold = 0.05;
   assert(range.size() >= num_samples);  //规定的keyrange必须大于等于要生成的key个数
   const size_t interval = range.max() - range.min() + 1;  //规定的keyrange的个数
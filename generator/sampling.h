@@ -13,28 +13,31 @@ namespace gen {
 
 // An implementation of Floyd sampling. For more details, see:
 // https://www.nowherenearithaca.com/2013/05/robert-floyds-tiny-and-beautiful.html
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void FloydSample(size_t num_samples, const Range<T>& range,
-                 std::vector<T>* dest, size_t start_index, RNG& rng);
+                 std::vector<T, Allocator>* dest,
+                 size_t start_index, RNG& rng);
 
 // An implementation of selection sampling. For more details, see:
 // https://stackoverflow.com/a/311716
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void SelectionSample(size_t num_samples, const Range<T>& range,
-                     std::vector<T>* dest, size_t start_index, RNG& rng);
+                     std::vector<T, Allocator>* dest,
+                     size_t start_index, RNG& rng);
 
 // Sampling based on the Fisher-Yates shuffle algorithm. For more details, see:
 // https://en.wikipedia.org/wiki/Fisher–Yates_shuffle
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void FisherYatesSample(size_t num_samples, const Range<T>& range,
-                       std::vector<T>* dest, size_t start_index, RNG& rng);
+                       std::vector<T, Allocator>* dest,
+                       size_t start_index, RNG& rng);
 
 // Selects which of the above sampling algorithms to run (for performance
 // reasons) using heuristics based on the input parameters.
-template <typename T, class RNG>
+template <typename T, class RNG, class Allocator>
 void SampleWithoutReplacement(size_t num_samples, const Range<T>& range,
-                              std::vector<T>* dest, size_t start_index,
-                              RNG& rng);
+                              std::vector<T, Allocator>* dest,
+                              size_t start_index, RNG& rng);
 
 }  // namespace gen
 }  // namespace ycsbr
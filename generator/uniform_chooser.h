@@ -29,14 +29,13 @@ class UniformChooser : public Chooser {
   }
 
   void IncreaseItemCountBy(size_t delta) override {   
-    //////////////////////////
-    size_t c = 1 ;
-    if (delta != c ) {
-      item_count_ -= 1;
-    }else{
-    //////////////////////////
     item_count_ += delta;
-    }  ////////////////////////
+    UpdateDistribution();
+  }
+
+  void DecreaseItemCountBy(size_t delta) override {
+    assert(item_count_ > delta);
+    item_count_ -= delta;
     UpdateDistribution();
   }
 
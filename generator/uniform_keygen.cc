@@ -17,7 +17,7 @@ UniformGenerator::UniformGenerator(const size_t num_keys, KeyRange range)
   }
 }
 
-void UniformGenerator::Generate(PRNG& prng, std::vector<Request::Key>* dest,
+void UniformGenerator::Generate(PRNG& prng, KeyList* dest,
                                 const size_t start_index) const {
   SampleWithoutReplacement<Request::Key, PRNG>(num_keys_, range_, dest,
                                                start_index, prng);
@@ -15,7 +15,7 @@ class UniformGenerator : public Generator {
   // Uniformly select `num_keys` from [range.min(), range.max()].
   UniformGenerator(size_t num_keys, KeyRange range);
 
-  void Generate(PRNG& prng, std::vector<Request::Key>* dest,
+  void Generate(PRNG& prng, KeyList* dest,
                 size_t start_index) const override;
 
  private:
@@ -2,22 +2,30 @@
 #include <iostream>    //////////////////////////
 #include <thread>   ////////////////////////
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <stdexcept>
 
 #include "ycsbr/buffered_workload.h"
 #include "ycsbr/gen/types.h"
+#include "ycsbr/impl/util.h"
 
 namespace {
 
 using namespace ycsbr;
 using namespace ycsbr::gen;
 
-// Producers will cycle through this many unique values (when inserting or
-// making updates).
-constexpr size_t kNumUniqueValues = 100;
+// Producers in a duration-based phase read the clock once every this many
+// requests.
+constexpr size_t kRequestsPerClockCheck = 128;
 
-void ApplyPhaseAndProducerIDs(std::vector<Request::Key>::iterator begin,
-                              std::vector<Request::Key>::iterator end,
+// Mixed into the workload's seed to derive the tombstone, so that it does not
+// repeat the bytes of any producer's values (producers are seeded with
+// `prng_seed ^ id`).
+constexpr uint32_t kTombstoneSeedTag = 0x70DE1E7E;
+
+void ApplyPhaseAndProducerIDs(KeyList::iterator begin, KeyList::iterator end,
                               const PhaseID phase_id,
                               const ProducerID producer_id) {
   for (auto it = begin; it != end; ++it) {
@@ -53,18 +61,40 @@ std::unique_ptr<PhasedWorkload> PhasedWorkload::LoadFromString(
       prng_seed);
 }
 
+std::unique_ptr<PhasedWorkload> PhasedWorkload::LoadFromYCSBProperties(
+    const std::filesystem::path& properties_file, const uint32_t prng_seed) {
+  return std::make_unique<PhasedWorkload>(
+      WorkloadConfig::LoadFromYCSBProperties(properties_file), prng_seed);
+}
+
+std::unique_ptr<PhasedWorkload> PhasedWorkload::LoadFromYCSBPropertiesString(
+    const std::string& raw_properties, const uint32_t prng_seed) {
+  return std::make_unique<PhasedWorkload>(
+      WorkloadConfig::LoadFromYCSBPropertiesString(raw_properties), prng_seed);
+}
+
 PhasedWorkload::PhasedWorkload(std::shared_ptr<WorkloadConfig> config,
                                const uint32_t prng_seed)
     : prng_(prng_seed),
       prng_seed_(prng_seed),
+      work_distribution_(WorkDistribution::kStatic),
+      chunk_size_(TraceWorkload::kDefaultChunkSize),
       config_(std::move(config)),
       load_keys_(nullptr) {
+  std::seed_seq tombstone_seed{prng_seed, kTombstoneSeedTag};
+  PRNG tombstone_prng(tombstone_seed);
+  auto tombstone = std::make_shared<std::string>(
+      config_->GetRecordSizeBytes() - sizeof(Request::Key), '\0');
+  impl::FillRandomBytes(tombstone->data(), tombstone->size(), tombstone_prng);
+  tombstone_ = std::move(tombstone);
+
   // If we're using a custom dataset, the user will call SetCustomLoadDataset()
   // to configure `load_keys_`.
   if (config_->UsingCustomDataset()) return;
 
-  load_keys_ = std::make_shared<std::vector<Request::Key>>(
-      config_->GetNumLoadRecords(), 0);
+  load_keys_ = std::make_shared<KeyList>(
+      config_->GetNumLoadRecords(), 0,
+      KeyList::allocator_type(config_->GetMemoryOptions()));
   auto load_gen = config_->GetLoadGenerator();
   load_gen->Generate(prng_, load_keys_.get(), 0);
   ApplyPhaseAndProducerIDs(load_keys_->begin(), load_keys_->end(),
@@ -81,7 +111,9 @@ void PhasedWorkload::SetCustomLoadDataset(std::vector<Request::Key> dataset) {
   if (*std::max_element(dataset.begin(), dataset.end()) > kMaxKey) {//?std::max_element 是一个函数，该函数返回vector中的最大元素的迭代器。dataset.begin() 表示容器的起始迭代器，dataset.end() 表示容器的结束迭代器。
     throw std::invalid_argument("The maximum supported key is 2^48 - 1.");
   }
-  load_keys_ = std::make_shared<std::vector<Request::Key>>(std::move(dataset));//!创建一个std::shared_ptr，指向一个std::vector，其中存储着从 dataset 移动而来的数据。//这样，load_keys_ 成员变量指向的地址将包含自定义数据集中的数据
+  load_keys_ = std::make_shared<KeyList>(
+      dataset.begin(), dataset.end(),
+      KeyList::allocator_type(config_->GetMemoryOptions()));//!创建一个std::shared_ptr，指向一个std::vector，其中存储着从 dataset 移动而来的数据。//这样，load_keys_ 成员变量指向的地址将包含自定义数据集中的数据
   ApplyPhaseAndProducerIDs(load_keys_->begin(), load_keys_->end(),
                            /*phase_id=*/0, /*producer_id=*/0);//!在原key后面加入8位phase_id和8位producer_id
 
@@ -103,17 +135,47 @@ void PhasedWorkload::AddCustomInsertList(const std::string& name,
   custom_inserts_->emplace(name, std::move(to_insert));
 }
 
+void PhasedWorkload::SetWorkDistribution(const WorkDistribution distribution,
+                                         const size_t chunk_size) {
+  if (chunk_size == 0) {
+    throw std::invalid_argument("The chunk size must be positive.");
+  }
+  work_distribution_ = distribution;
+  chunk_size_ = chunk_size;
+}
+
 size_t PhasedWorkload::GetRecordSizeBytes() const {
   return config_->GetRecordSizeBytes();
 }
 
+bool PhasedWorkload::HasDurationPhases() const {
+  for (PhaseID phase_id = 0; phase_id < config_->GetNumPhases(); ++phase_id) {
+    if (config_->GetPhase(phase_id, 0, 1).duration.count() > 0) return true;
+  }
+  return false;
+}
+
+KeyEncoder PhasedWorkload::GetKeyEncoder() const {
+  return config_->GetKeyEncoder();
+}
+
 BulkLoadTrace PhasedWorkload::GetLoadTrace(const bool sort_requests) const {
   Trace::Options options;
   options.value_size = config_->GetRecordSizeBytes() - sizeof(Request::Key);
   options.sort_requests = sort_requests;
+  const double compression_ratio = config_->GetValueCompressionRatio();
+  if (compression_ratio > 1.0) {
+    options.value_content = Trace::Options::ValueContent::kCompressible;
+    options.value_compression_ratio = compression_ratio;
+  }
   return BulkLoadTrace::LoadFromKeys(*load_keys_, options);
 }
 
+void PhasedWorkload::ExportSnapshot(const std::filesystem::path& file,
+                                    const size_t num_producers) const {
+  WorkloadSnapshot::Export(*this, num_producers, file);
+}
+
 std::vector<Producer> PhasedWorkload::GetProducers(
     const size_t num_producers) const {
   std::vector<Producer> producers;
@@ -123,13 +185,32 @@ std::vector<Producer> PhasedWorkload::GetProducers(
   std::shared_ptr<std::unordered_set<Request::Key>> keys = std::make_shared<std::unordered_set<Request::Key>>();
   std::shared_ptr<std::set<Request::Key>> set_ = std::make_shared<std::set<Request::Key>>(load_keys_->begin(),load_keys_->end());
   //////////////////////////////
+  const size_t num_phases = config_->GetNumPhases();
+  auto phase_state = std::make_shared<SharedPhaseState>(num_phases, chunk_size_);
+  bool makes_deletes = false;
+  for (PhaseID phase_id = 0; phase_id < num_phases; ++phase_id) {
+    // Retrieve the phase as if there was a single producer to get the total
+    // number of requests.
+    const Phase phase = config_->GetPhase(phase_id, 0, 1);
+    makes_deletes = makes_deletes || phase.num_deletes > 0;
+    if (work_distribution_ != WorkDistribution::kSharedChunks ||
+        phase.num_requests == Phase::kUnboundedRequests ||
+        phase.num_inserts > 0 || phase.num_deletes > 0) {
+      continue;
+    }
+    phase_state->SetRequestBudget(phase_id, phase.num_requests);
+  }
+  // All producers share the tombstone, so that each one recognizes the
+  // records deleted by the others.
+  const std::shared_ptr<const std::string> tombstone =
+      makes_deletes ? tombstone_ : nullptr;
   for (ProducerID id = 0; id < num_producers; ++id) {
     producers.push_back(
         // Each Producer's workload should be deterministic, but we want each
         // Producer to produce different requests from each other. So we include
         // the producer ID in its seed.//++每个Producer的工作负载应该是确定性的，但我们希望每个Producer彼此产生不同的requests。因此，我们在其种子中包含producer ID。
         //Producer(config_, load_keys_,  custom_inserts_, id, num_producers, 
-        Producer(config_, load_keys_, num_load_keys_, mute,  keys, set_, custom_inserts_, id, num_producers,  ///////////////////////////
+        Producer(config_, load_keys_, num_load_keys_, mute,  keys, set_, custom_inserts_, phase_state, tombstone, id, num_producers,  ///////////////////////////
                  prng_seed_ ^ id));
   }
   return producers;
@@ -138,7 +219,7 @@ std::vector<Producer> PhasedWorkload::GetProducers(
 Producer::Producer(
     std::shared_ptr<const WorkloadConfig> config,
     //std::shared_ptr<const std::vector<Request::Key>> load_keys,  
-    std::shared_ptr< std::vector<Request::Key>> load_keys,   /////////////////////////////
+    std::shared_ptr<KeyList> load_keys,   /////////////////////////////
     std::shared_ptr<size_t> num_load_keys,   /////////////////////////////
     std::mutex & mute,   ///////////////////////
     std::shared_ptr<std::unordered_set<Request::Key>> keys,   //////////////////////////
@@ -146,33 +227,60 @@ Producer::Producer(
     std::shared_ptr<
         const std::unordered_map<std::string, std::vector<Request::Key>>>
         custom_inserts,
-    const ProducerID id, const size_t num_producers, const uint32_t prng_seed)
+    std::shared_ptr<SharedPhaseState> phase_state,
+    std::shared_ptr<const std::string> tombstone, const ProducerID id,
+    const size_t num_producers, const uint32_t prng_seed)
     : id_(id),
       num_producers_(num_producers),
       config_(std::move(config)),
       prng_(prng_seed),
       current_phase_(0),
+      phase_state_(std::move(phase_state)),
       load_keys_(std::move(load_keys)),
       //num_load_keys_(load_keys_->size()),
       num_load_keys_(num_load_keys),    /////////////////////////
       custom_inserts_(std::move(custom_inserts)),
+      insert_keys_(KeyList::allocator_type(config_->GetMemoryOptions())),
+      delete_keys_(KeyList::allocator_type(config_->GetMemoryOptions())),
       next_insert_key_index_(0),
       next_delete_key_index_(0),  ///////////////////////////
       mtx(mute),     ///////////////////////////
       load_keys_set(std::move(set_)),  //////////////////////////////
       keys_(keys),   ///////////////////////////////////
       valuegen_(config_->GetRecordSizeBytes() - sizeof(Request::Key),
-                kNumUniqueValues, prng_),     //生成1024个不同的value
-      op_dist_(0, 99) {}
+                config_->GetValueCompressionRatio(), prng_),
+      tombstone_(std::move(tombstone)),
+      op_dist_(0, 99),
+      txn_reads_left_(0),
+      txn_writes_left_(0) {}
 
 void Producer::Prepare() {   //!配置各个phase,生成每个phase的各种chooser，并载入/生成insert keys到producer.insert_keys_
+  // Prepare() runs on the worker thread that will execute this producer's
+  // requests, so everything allocated here is local to that worker's NUMA
+  // node.
+
   // Set up the workload phases.  //++设置每个phase
   const size_t num_phases = config_->GetNumPhases();  //返回phase数量
   phases_.reserve(num_phases);
+  size_t max_value_size = valuegen_.value_size();
   for (PhaseID phase_id = 0; phase_id < num_phases; ++phase_id) {
     phases_.push_back(config_->GetPhase(phase_id, id_, num_producers_));  //以(阶段id,producer id，producer数量)初始化Phase并放入phases_中
+    Phase& phase = phases_.back();
+    if (phase_state_->HasRequestBudget(phase_id)) {
+      // Requests are claimed from the shared budget when the phase starts.
+      phase.shares_request_budget = true;
+      phase.num_requests_left = 0;
+    }
+    if (phase.value_size_chooser != nullptr) {
+      max_value_size =
+          std::max(max_value_size, phase.value_size_chooser->MaxSize());
+    }
   }
 
+  // The values were generated by the thread that created this producer, so
+  // move them over too (and make room for the largest value).
+  valuegen_.Relocate(max_value_size);
+
   // Generate the inserts.  //++为每个phase生成inserts
   size_t insert_index = 0;
   for (auto& phase : phases_) {    //*遍历每个phase,如果phase.num_inserts=0则continue
@@ -238,6 +346,21 @@ void Producer::Prepare() {   //!配置各个phase,生成每个phase的各种choo
   }
   //next_delete_key_index_= delete_keys_.size()-1;    //从delete_insert_最后一个开始删除，便于维护choosekey函数
   ////////////////////////////////
+
+  EnterPhase();
+}
+
+void Producer::FinishPrepare() {
+  // By now, every producer has removed the keys it will delete from the shared
+  // set of load keys. The remaining keys are the ones that exist in the
+  // database when the workload starts (the set is already sorted).
+  if (id_ == 0) {
+    load_keys_->assign(load_keys_set->begin(), load_keys_set->end());
+    *num_load_keys_ = load_keys_->size();
+  }
+  if (!phases_.empty()) {
+    phases_.front().SetItemCount(*num_load_keys_ + delete_keys_.size());
+  }
 }
 
 Request::Key Producer::ChooseKey(const std::unique_ptr<Chooser>& chooser) {       
@@ -249,20 +372,74 @@ Request::Key Producer::ChooseKey(const std::unique_ptr<Chooser>& chooser) {
   ///////////////////////
   else if(index < *num_load_keys_ + next_insert_key_index_){
     return insert_keys_[index - *num_load_keys_];
-    std::cerr << "insert范围错误" << std::endl;
   }
   else if(index < *num_load_keys_ + next_insert_key_index_ +  delete_keys_.size()- next_delete_key_index_){
     return delete_keys_[index - *num_load_keys_ - next_insert_key_index_ + next_delete_key_index_];
-  }else{
-    std::cerr << "范围错误" << std::endl;
   }
   ///////////////////////
+  throw std::runtime_error("Chose a key outside of the workload's key range.");
+}
+
+bool Producer::DeadlinePassed(Phase& phase) {
+  if (!phase.deadline.has_value()) {
+    phase.deadline = phase_state_->DeadlineFor(phase.phase_id, phase.duration);
+    // A producer that starts the phase after its deadline (e.g., because it
+    // took longer to finish the previous phase) makes just one request.
+    phase.requests_until_clock_check =
+        std::chrono::steady_clock::now() >= *phase.deadline
+            ? 1
+            : kRequestsPerClockCheck;
+  }
+  if (--phase.requests_until_clock_check > 0) return false;
+  phase.requests_until_clock_check = kRequestsPerClockCheck;
+  return std::chrono::steady_clock::now() >= *phase.deadline;
+}
+
+void Producer::EnterPhase() {
+  while (current_phase_ < phases_.size()) {
+    Phase& phase = phases_[current_phase_];
+    if (phase.shares_request_budget) {
+      phase.num_requests_left = phase_state_->ClaimRequests(phase.phase_id);
+    }
+    if (phase.HasNext()) return;
+    AdvancePhase();
+  }
+}
+
+void Producer::AdvancePhase() {
+  Phase& finished = phases_[current_phase_];
+  if (finished.num_inserts_left > 0) {
+    // The phase reached its deadline before making all of its inserts. Drop
+    // the unused keys so that the keys inserted by later phases stay
+    // contiguous in `insert_keys_`.
+    const auto unused_begin = insert_keys_.begin() + next_insert_key_index_;
+    insert_keys_.erase(unused_begin, unused_begin + finished.num_inserts_left);
+  }
+  ++current_phase_;
+  // Reset the operation selection distribution.
+  op_dist_ = std::uniform_int_distribution<uint32_t>(0, 99);
+  if (current_phase_ >= phases_.size()) return;
+
+  // Use the number of inserts and deletes that were actually made; a
+  // duration-based phase may end before making all of them.
+  phases_[current_phase_].SetItemCount(
+      *num_load_keys_ + (finished.num_inserts - finished.num_inserts_left) -
+      (finished.num_deletes - finished.num_deletes_left));
 }
 
 Request Producer::Next() {
   assert(HasNext());
   Phase& this_phase = phases_[current_phase_];
 
+  if (txn_reads_left_ + txn_writes_left_ > 0) {
+    const Request to_return = NextTransactionRequest(this_phase);
+    // The transaction's last request completes it.
+    if (txn_reads_left_ + txn_writes_left_ == 0) {
+      FinishRequest(this_phase);
+    }
+    return to_return;
+  }
+
   Request::Operation next_op;
 
   // If there are more requests left than inserts, we can randomly decide what
@@ -282,6 +459,14 @@ Request Producer::Next() {
       next_op = Request::Operation::kScan;
     } else if (choice < this_phase.update_thres) {
       next_op = Request::Operation::kUpdate;
+    } else if (choice < this_phase.deleterange_thres) {
+      next_op = Request::Operation::kDeleteRange;
+    } else if (choice < this_phase.merge_thres) {
+      next_op = Request::Operation::kMerge;
+    } else if (choice < this_phase.cas_thres) {
+      next_op = Request::Operation::kCompareAndSwap;
+    } else if (choice < this_phase.txn_thres) {
+      next_op = Request::Operation::kTransaction;
     //////////////////
     } else if (choice < this_phase.delete_thres) {
       next_op = Request::Operation::kDelete;
@@ -310,9 +495,10 @@ Request Producer::Next() {
     }
 
     case Request::Operation::kReadModifyWrite: {
+      const size_t value_size = NextValueSize(this_phase);
       to_return = Request(Request::Operation::kReadModifyWrite,
                           ChooseKey(this_phase.rmw_chooser), 0,   
-                          valuegen_.NextValue(), valuegen_.value_size());
+                          valuegen_.NextValue(value_size), value_size);
       break;
     }
 
@@ -334,23 +520,59 @@ Request Producer::Next() {
     }
 
     case Request::Operation::kUpdate: {
+      const size_t value_size = NextValueSize(this_phase);
       to_return = Request(Request::Operation::kUpdate,
                           ChooseKey(this_phase.update_chooser), 0,  
-                          valuegen_.NextValue(), valuegen_.value_size());
+                          valuegen_.NextValue(value_size), value_size);
       break;
     }
 
+    case Request::Operation::kDeleteRange: {
+      // Range deletes do not adjust the choosers' item counts, since the
+      // number of records they remove depends on the existing keys.
+      to_return = Request(
+          Request::Operation::kDeleteRange,
+          ChooseKey(this_phase.deleterange_chooser),
+          this_phase.deleterange_length_chooser->Next(prng_) + 1, nullptr, 0);
+      break;
+    }
+
+    case Request::Operation::kMerge: {
+      const size_t value_size = NextValueSize(this_phase);
+      to_return = Request(Request::Operation::kMerge,
+                          ChooseKey(this_phase.merge_chooser), 0,
+                          valuegen_.NextValue(value_size), value_size);
+      break;
+    }
+
+    case Request::Operation::kCompareAndSwap: {
+      const size_t value_size = NextValueSize(this_phase);
+      to_return = Request(Request::Operation::kCompareAndSwap,
+                          ChooseKey(this_phase.cas_chooser), 0,
+                          valuegen_.NextValue(value_size), value_size);
+      break;
+    }
+
+    case Request::Operation::kTransaction: {
+      // The phase moves on only after the transaction's last request.
+      txn_reads_left_ = this_phase.txn_num_reads;
+      txn_writes_left_ = this_phase.txn_num_writes;
+      return Request(Request::Operation::kTransaction, 0,
+                     txn_reads_left_ + txn_writes_left_, nullptr, 0);
+    }
+
     //////////////////////////////
     case Request::Operation::kDelete: {
       to_return = Request(Request::Operation::kDelete,
                           delete_keys_[next_delete_key_index_], 0,
-                          valuegen_.LastValue(), valuegen_.value_size());
+                          tombstone_->data(), tombstone_->size());
       ++next_delete_key_index_;
       --this_phase.num_deletes_left;
-      this_phase.IncreaseItemCountBy(-1);
+      this_phase.DecreaseItemCountBy(1);
       if (this_phase.num_deletes_left ==0) {
-        if (this_phase.update_thres >0 ){
-          op_dist_ = std::uniform_int_distribution<uint32_t>( 0 ,this_phase.update_thres-1);
+        // Transactions are the last operation before deletes.
+        if (this_phase.txn_thres >0 ){
+          op_dist_ = std::uniform_int_distribution<uint32_t>( 0 ,this_phase.txn_thres-1);
         } else {
           assert(this_phase.num_requests_left == 1);
         }
@@ -360,9 +582,10 @@ Request Producer::Next() {
     //////////////////////////////
 
     case Request::Operation::kInsert: {
+      const size_t value_size = NextValueSize(this_phase);
       to_return = Request(Request::Operation::kInsert,
                           insert_keys_[next_insert_key_index_], 0,
-                          valuegen_.NextValue(), valuegen_.value_size());
+                          valuegen_.NextValue(value_size), value_size);
       ++next_insert_key_index_;
       --this_phase.num_inserts_left;
       this_phase.IncreaseItemCountBy(1);
@@ -384,25 +607,34 @@ Request Producer::Next() {
     }
   }
 
+  FinishRequest(this_phase);
+  return to_return;
+}
+
+Request Producer::NextTransactionRequest(Phase& phase) {
+  if (txn_reads_left_ > 0) {
+    --txn_reads_left_;
+    return Request(Request::Operation::kRead, ChooseKey(phase.txn_chooser), 0,
+                   nullptr, 0);
+  }
+  --txn_writes_left_;
+  const size_t value_size = NextValueSize(phase);
+  return Request(Request::Operation::kUpdate, ChooseKey(phase.txn_chooser), 0,
+                 valuegen_.NextValue(value_size), value_size);
+}
+
+void Producer::FinishRequest(Phase& phase) {
   // Advance to the next request.
-  --this_phase.num_requests_left;
-  if(this_phase.num_requests_left==523400) {std::cerr<<std::this_thread::get_id() << ":" <<"已完成三分之二"<<std::endl;}
-  if(this_phase.num_requests_left==1046800) {std::cerr<<std::this_thread::get_id() << ":" <<"已完成三分之一"<<std::endl;}
-  // std::cerr<< std::this_thread::get_id() << ":" << this_phase.num_requests_left<<std::endl;
-  if (this_phase.num_requests_left == 0) {
-    ++current_phase_;
-    /////////////////////////
-    // std::cerr << "我要进入下一个阶段了" <<std::endl;
-     if(current_phase_<phases_.size()){
-    //   std::lock_guard<std::mutex> lock(mtx);
-       phases_[current_phase_].SetItemCount(*num_load_keys_ + phases_[current_phase_-1].num_inserts - phases_[current_phase_-1].num_deletes);
-    //    std::cerr << "我进入了下一个阶段" <<std::endl;
-     }
-    /////////////////////////
-    // Reset the operation selection distribution.
-    op_dist_ = std::uniform_int_distribution<uint32_t>(0, 99);
+  --phase.num_requests_left;
+  if (phase.duration.count() > 0 && DeadlinePassed(phase)) {
+    phase.num_requests_left = 0;
+  } else if (phase.num_requests_left == 0 && phase.shares_request_budget) {
+    phase.num_requests_left = phase_state_->ClaimRequests(phase.phase_id);
+  }
+  if (phase.num_requests_left == 0) {
+    AdvancePhase();
+    EnterPhase();
   }
-  return to_return;
 }
 
 }  // namespace gen
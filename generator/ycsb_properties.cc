@@ -0,0 +1,246 @@
+#include "ycsb_properties.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "ycsbr/gen/types.h"
+#include "ycsbr/request.h"
+
+namespace {
+
+using namespace ycsbr;
+
+// YCSB uses this zipfian constant for all of its zipfian distributions.
+constexpr double kYCSBZipfianTheta = 0.99;
+
+class Properties {
+ public:
+  // Parses the Java `.properties` format (without line continuations).
+  explicit Properties(std::istream& in) {
+    std::string line;
+    while (std::getline(in, line)) {
+      line = Trim(line);
+      if (line.empty() || line[0] == '#' || line[0] == '!') continue;
+      const size_t key_end = line.find_first_of("=: \t");
+      if (key_end == std::string::npos) {
+        values_[line] = "";
+        continue;
+      }
+      std::string value = Trim(line.substr(key_end));
+      if (!value.empty() && (value[0] == '=' || value[0] == ':')) {
+        value = Trim(value.substr(1));
+      }
+      values_[line.substr(0, key_end)] = std::move(value);
+    }
+  }
+
+  std::string GetString(const std::string& key,
+                        const std::string& default_value) const {
+    const auto it = values_.find(key);
+    return it == values_.end() ? default_value : it->second;
+  }
+
+  uint64_t GetUInt64(const std::string& key, uint64_t default_value) const {
+    const auto it = values_.find(key);
+    if (it == values_.end()) return default_value;
+    size_t parsed = 0;
+    try {
+      const uint64_t value = std::stoull(it->second, &parsed);
+      if (parsed == it->second.size()) return value;
+    } catch (const std::logic_error&) {
+    }
+    throw InvalidValue(key, it->second);
+  }
+
+  double GetDouble(const std::string& key, double default_value) const {
+    const auto it = values_.find(key);
+    if (it == values_.end()) return default_value;
+    size_t parsed = 0;
+    try {
+      const double value = std::stod(it->second, &parsed);
+      if (parsed == it->second.size() && value >= 0.0) return value;
+    } catch (const std::logic_error&) {
+    }
+    throw InvalidValue(key, it->second);
+  }
+
+  static std::invalid_argument InvalidValue(const std::string& key,
+                                            const std::string& value) {
+    return std::invalid_argument("Invalid value for YCSB property '" + key +
+                                 "': " + value);
+  }
+
+ private:
+  static std::string Trim(const std::string& str) {
+    const size_t start = str.find_first_not_of(" \t\r");
+    if (start == std::string::npos) return "";
+    const size_t end = str.find_last_not_of(" \t\r");
+    return str.substr(start, end - start + 1);
+  }
+
+  std::unordered_map<std::string, std::string> values_;
+};
+
+// The distribution used to choose the keys of reads, updates, scans, and
+// read-modify-writes.
+YAML::Node AccessDistribution(const std::string& request_distribution) {
+  YAML::Node dist;
+  if (request_distribution == "uniform") {
+    dist["type"] = "uniform";
+  } else if (request_distribution == "zipfian" ||
+             request_distribution == "latest") {
+    dist["type"] = request_distribution;
+    dist["theta"] = kYCSBZipfianTheta;
+  } else {
+    throw Properties::InvalidValue("requestdistribution",
+                                   request_distribution);
+  }
+  return dist;
+}
+
+// The distribution used to generate the loaded keys (when `start_key` is 0)
+// and the inserted keys.
+YAML::Node KeyDistribution(const std::string& insert_order,
+                           const uint64_t start_key) {
+  YAML::Node dist;
+  if (insert_order == "hashed") {
+    dist["type"] = "uniform";
+    dist["range_min"] = 0;
+    // Hashed keys are drawn from the generator's whole key range.
+    dist["range_max"] = gen::kMaxKey;
+  } else if (insert_order == "ordered") {
+    dist["type"] = "linspace";
+    dist["start_key"] = start_key;
+    dist["step_size"] = 1;
+  } else {
+    throw Properties::InvalidValue("insertorder", insert_order);
+  }
+  return dist;
+}
+
+// Converts the operation proportions into whole percentages that sum to 100,
+// using the largest remainder method.
+template <size_t N>
+std::array<uint32_t, N> ToPercentages(
+    const std::array<double, N>& proportions) {
+  double total = 0.0;
+  for (const double proportion : proportions) {
+    total += proportion;
+  }
+  if (total <= 0.0) {
+    throw std::invalid_argument(
+        "The YCSB operation proportions must not all be zero.");
+  }
+  std::array<uint32_t, N> percentages;
+  std::array<std::pair<double, size_t>, N> remainders;
+  uint32_t assigned = 0;
+  for (size_t i = 0; i < N; ++i) {
+    const double exact = 100.0 * proportions[i] / total;
+    percentages[i] = static_cast<uint32_t>(std::floor(exact));
+    remainders[i] = {exact - percentages[i], i};
+    assigned += percentages[i];
+  }
+  std::sort(remainders.begin(), remainders.end(),
+            [](const auto& lhs, const auto& rhs) {
+              return lhs.first > rhs.first;
+            });
+  for (size_t i = 0; assigned < 100; ++i, ++assigned) {
+    ++percentages[remainders[i].second];
+  }
+  return percentages;
+}
+
+}  // namespace
+
+namespace ycsbr {
+namespace gen {
+
+YAML::Node TranslateYCSBProperties(std::istream& in) {
+  const Properties properties(in);
+
+  const uint64_t record_count = properties.GetUInt64("recordcount", 0);
+  const uint64_t operation_count = properties.GetUInt64("operationcount", 0);
+  if (record_count == 0) {
+    throw std::invalid_argument("The YCSB properties must set 'recordcount'.");
+  }
+  if (operation_count == 0) {
+    throw std::invalid_argument(
+        "The YCSB properties must set 'operationcount'.");
+  }
+
+  const uint64_t field_count = properties.GetUInt64("fieldcount", 10);
+  const uint64_t field_length = properties.GetUInt64("fieldlength", 100);
+  const uint64_t value_size = field_count * field_length;
+  const std::string insert_order =
+      properties.GetString("insertorder", "hashed");
+  const std::string request_distribution =
+      properties.GetString("requestdistribution", "uniform");
+
+  YAML::Node config;
+  config["record_size_bytes"] = sizeof(Request::Key) + value_size;
+  config["load"]["num_records"] = record_count;
+  config["load"]["distribution"] = KeyDistribution(insert_order, 0);
+
+  YAML::Node phase;
+  phase["num_requests"] = operation_count;
+
+  const std::array<const char*, 5> ops = {"read", "update", "insert", "scan",
+                                          "readmodifywrite"};
+  const std::array<uint32_t, 5> percentages = ToPercentages<5>(
+      {properties.GetDouble("readproportion", 0.95),
+       properties.GetDouble("updateproportion", 0.05),
+       properties.GetDouble("insertproportion", 0.0),
+       properties.GetDouble("scanproportion", 0.0),
+       properties.GetDouble("readmodifywriteproportion", 0.0)});
+  for (size_t i = 0; i < ops.size(); ++i) {
+    if (percentages[i] == 0) continue;
+    const std::string op = ops[i];
+    phase[op]["proportion_pct"] = percentages[i];
+    if (op == "insert") {
+      phase[op]["distribution"] =
+          KeyDistribution(insert_order, /*start_key=*/record_count);
+      continue;
+    }
+    phase[op]["distribution"] = AccessDistribution(request_distribution);
+    if (op == "scan") {
+      const std::string scan_length_distribution =
+          properties.GetString("scanlengthdistribution", "uniform");
+      if (scan_length_distribution != "uniform") {
+        throw Properties::InvalidValue("scanlengthdistribution",
+                                       scan_length_distribution);
+      }
+      phase[op]["max_length"] = properties.GetUInt64("maxscanlength", 1000);
+    }
+  }
+
+  // Each field's length is drawn separately in YCSB. Here the whole value's
+  // size is drawn from the same kind of distribution instead.
+  const std::string field_length_distribution =
+      properties.GetString("fieldlengthdistribution", "constant");
+  if (field_length_distribution == "uniform" ||
+      field_length_distribution == "zipfian") {
+    YAML::Node size;
+    size["type"] = field_length_distribution;
+    size["range_min"] = field_count;
+    size["range_max"] = value_size;
+    if (field_length_distribution == "zipfian") {
+      size["theta"] = kYCSBZipfianTheta;
+    }
+    phase["value_size"] = size;
+  } else if (field_length_distribution != "constant") {
+    throw Properties::InvalidValue("fieldlengthdistribution",
+                                   field_length_distribution);
+  }
+
+  config["run"].push_back(phase);
+  return config;
+}
+
+}  // namespace gen
+}  // namespace ycsbr
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <istream>
+
+#include "yaml-cpp/yaml.h"
+
+namespace ycsbr {
+namespace gen {
+
+// Translates a YCSB core workload property file (e.g., `ycsb/workloada`) into
+// the equivalent YCSBR workload configuration (see
+// `tests/workloads/custom.yml`) with one run phase.
+//
+// Supported properties (with YCSB's defaults when they are not set):
+// - `recordcount` and `operationcount` (both required)
+// - `readproportion` (0.95), `updateproportion` (0.05), `insertproportion`,
+//   `scanproportion`, and `readmodifywriteproportion` (0). The proportions
+//   are normalized and rounded to whole percentages.
+// - `requestdistribution` (uniform): uniform, zipfian, or latest
+// - `maxscanlength` (1000) and `scanlengthdistribution` (uniform only)
+// - `fieldcount` (10), `fieldlength` (100), and `fieldlengthdistribution`
+//   (constant): constant, uniform, or zipfian. A record's value holds all of
+//   its fields, so values have `fieldcount * fieldlength` bytes (at most).
+// - `insertorder` (hashed): hashed keys are drawn uniformly from the whole
+//   48-bit key range (see `Generator`); ordered keys are consecutive integers
+//   starting at 0.
+//
+// Other properties (e.g., `readallfields`) do not change the requests that
+// are made, so they are ignored. Throws `std::invalid_argument` if a property
+// has a value that YCSBR cannot express.
+YAML::Node TranslateYCSBProperties(std::istream& properties);
+
+}  // namespace gen
+}  // namespace ycsbr
@@ -49,7 +49,8 @@ struct BenchmarkOptions {
 //
 // NOTE: Only running the trace is timed. Loading the records is performed by
 // calling `BulkLoad()` on the specified `DatabaseInterface`. The bulk load
-// always runs on a single thread.
+// runs on a single thread; use `Session::ReplayBulkLoadTraceParallel()` for a
+// partitioned multi-threaded load.
 template <class DatabaseInterface>
 BenchmarkResult ReplayTrace(const Trace& trace,
                             const BulkLoadTrace* load = nullptr,
@@ -57,7 +58,8 @@ BenchmarkResult ReplayTrace(const Trace& trace,
                                 BenchmarkOptions<DatabaseInterface>());
 
 // Measures the time it takes to load the specified records using bulk load.
-// NOTE: The bulk load always runs on a single thread.
+// NOTE: The bulk load runs on a single thread (see
+// `Session::ReplayBulkLoadTraceParallel()`).
 template <class DatabaseInterface>
 BenchmarkResult ReplayTrace(
     const BulkLoadTrace& load,
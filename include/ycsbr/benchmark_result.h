@@ -1,12 +1,25 @@
 #pragma once
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "meter.h"
+#include "perf_counters.h"
+#include "time_series.h"
 
 namespace ycsbr {
 
+template <class DatabaseInterface>
+class Session;
+
+namespace impl {
+class MetricsTracker;
+}  // namespace impl
+
 class BenchmarkResult {
  public:
   BenchmarkResult(std::chrono::nanoseconds total_run_time);  //!std::chrono::nanoseconds 是 C++ 标准库中的一个时间单位，用于表示纳秒（nanoseconds）级别的时间间隔
@@ -14,7 +27,16 @@ class BenchmarkResult {
                   FrozenMeter reads, FrozenMeter writes, FrozenMeter scans,
                   FrozenMeter deletes, size_t failed_deletes,  ///////////////////////
                   size_t failed_reads, size_t failed_writes,
-                  size_t failed_scans);
+                  size_t failed_scans,
+                  FrozenMeter range_deletes = FrozenMeter(),
+                  FrozenMeter merges = FrozenMeter(),
+                  FrozenMeter compare_and_swaps = FrozenMeter(),
+                  size_t failed_range_deletes = 0, size_t failed_merges = 0,
+                  size_t failed_compare_and_swaps = 0,
+                  FrozenMeter transactions = FrozenMeter(),
+                  size_t failed_transactions = 0,
+                  size_t transaction_aborts = 0,
+                  size_t transaction_retries = 0);
 
   template <typename Units>
   Units RunTime() const;
@@ -28,23 +50,170 @@ class BenchmarkResult {
   const FrozenMeter& Writes() const { return writes_; }
   const FrozenMeter& Scans() const { return scans_; }
   const FrozenMeter& Deletes() const {return deletes_; }   /////////////////////
+  // `NumRecords()` is the total length requested by the successful range
+  // deletes, not the number of records they removed: `DeleteRange()` does not
+  // report how many records it found, so a range that runs past the last key
+  // (or over already deleted records) still counts its full length.
+  const FrozenMeter& RangeDeletes() const { return range_deletes_; }
+  const FrozenMeter& Merges() const { return merges_; }
+  const FrozenMeter& CompareAndSwaps() const { return compare_and_swaps_; }
+  // Committed transactions. Their latency is the time from the first
+  // `BeginTxn()` to the successful `Commit()` (including any retries), and
+  // their records are the requests they contain.
+  const FrozenMeter& Transactions() const { return transactions_; }
 
   size_t NumFailedReads() const { return failed_reads_; }
   size_t NumFailedWrites() const { return failed_writes_; }
   size_t NumFailedScans() const { return failed_scans_; }
   size_t NumFailedDeletes() const { return failed_deletes_; }    ////////////////////////
+  size_t NumFailedRangeDeletes() const { return failed_range_deletes_; }
+  size_t NumFailedMerges() const { return failed_merges_; }
+  // Includes the compare-and-swaps whose record changed after it was read.
+  size_t NumFailedCompareAndSwaps() const { return failed_compare_and_swaps_; }
+  // Transactions that were still aborting after the last retry.
+  size_t NumFailedTransactions() const { return failed_transactions_; }
+  // Every aborted attempt counts, including the retried ones.
+  size_t NumTransactionAborts() const { return transaction_aborts_; }
+  size_t NumTransactionRetries() const { return transaction_retries_; }
+  // The fraction of transaction attempts that aborted.
+  double TransactionAbortRate() const;
+
+  // The time between the workload's start signal and the moment the last
+  // worker thread observed it. Zero for results that were not produced by a
+  // multi-threaded run.
+  template <typename Units>
+  Units StartSkew() const;
+
+  // Requests processed by the worker threads that ran on each NUMA node,
+  // ordered by node ID. Empty for results not produced by a `Session` run.
+  struct NodeSummary {
+    size_t node_id;
+    size_t num_threads;
+    size_t num_requests;
+  };
+  const std::vector<NodeSummary>& PerNode() const { return per_node_; }
+  double NodeThroughputThousandRequestsPerSecond(
+      const NodeSummary& node) const;
+
+  // The measurements taken by an individual worker thread.
+  struct ThreadResult {
+    size_t worker_id = 0;
+    // The core the worker was running on when it started.
+    size_t core = 0;
+    // How long this worker spent running its share of the work.
+    std::chrono::nanoseconds run_time = std::chrono::nanoseconds(0);
+    FrozenMeter reads, writes, scans, deletes;
+    FrozenMeter range_deletes, merges, compare_and_swaps, transactions;
+    size_t num_failed = 0;
+    // This worker's throughput samples, if they were requested (see
+    // `RunOptions::throughput_sample_interval`).
+    std::vector<TimeSeriesSample> time_series;
+    // This worker's hardware event counts, if they were requested (see
+    // `RunOptions::perf_counters`).
+    PerfCounters perf;
+
+    double ThroughputThousandRequestsPerSecond() const;
+    double ThroughputThousandRecordsPerSecond() const;
+  };
+  // Per-worker results, ordered by worker ID. Empty for results that were not
+  // produced by a multi-threaded `Session` run.
+  const std::vector<ThreadResult>& PerThread() const { return per_thread_; }
+
+  // How evenly the work was spread across the worker threads, based on each
+  // thread's request throughput (see `PerThread()`).
+  struct Fairness {
+    // The highest per-thread throughput divided by the lowest. This is
+    // infinite if some thread did not complete any requests.
+    double max_min_ratio;
+    // Jain's fairness index, which ranges from 1/n (one of the n threads did
+    // all the work) to 1 (all threads had the same throughput).
+    double jains_index;
+  };
+  // Both metrics are 1 if there are no per-thread results.
+  Fairness ThreadFairness() const;
+
+  // The measurements taken during one phase of a multi-phase workload (e.g., a
+  // `gen::PhasedWorkload`).
+  struct PhaseResult {
+    size_t phase_id;
+    // The time between the first worker starting the phase and the last worker
+    // finishing it.
+    std::chrono::nanoseconds run_time;
+    FrozenMeter reads, writes, scans, deletes;
+    FrozenMeter range_deletes, merges, compare_and_swaps, transactions;
+    PerfCounters perf;
+
+    double ThroughputThousandRequestsPerSecond() const;
+    double PerfPerRequest(PerfCounters::Event event) const;
+  };
+  // Per-phase results, ordered by phase ID. Empty if the workload's producers
+  // do not report phases (see `workload_example.h`). The aggregate results
+  // above include the measurements of all phases.
+  const std::vector<PhaseResult>& PerPhase() const { return per_phase_; }
+
+  // The throughput samples of all workers, merged into one sample per
+  // sampling interval. Empty unless `RunOptions::throughput_sample_interval`
+  // was set.
+  const std::vector<TimeSeriesSample>& Timeline() const { return timeline_; }
+
+  // Hardware event counts summed over all workers. Empty unless
+  // `RunOptions::perf_counters` was set (and the machine supports the events).
+  const PerfCounters& Perf() const { return perf_; }
+  // The average number of events per request (successful or not).
+  double PerfPerRequest(PerfCounters::Event event) const;
+
+  // Hardware events measured around the sampled requests of one operation
+  // type (see `PerfCounterMode::kPerOperation`).
+  struct OperationPerf {
+    PerfCounters counters;
+    size_t num_sampled_requests = 0;
+
+    double PerRequest(PerfCounters::Event event) const {
+      return counters.PerRequest(event, num_sampled_requests);
+    }
+  };
+  // Read-modify-writes count as writes; negative reads count as reads.
+  struct PerfByOperation {
+    OperationPerf reads, writes, scans, deletes;
+    OperationPerf range_deletes, merges, compare_and_swaps, transactions;
+  };
+  const PerfByOperation& PerOperationPerf() const { return operation_perf_; }
 
   static void PrintCSVHeader(std::ostream& out);
   void PrintAsCSV(std::ostream& out, bool print_header = true) const;
 
+  // Prints one CSV row per worker thread.
+  static void PrintThreadsCSVHeader(std::ostream& out);
+  void PrintThreadsAsCSV(std::ostream& out, bool print_header = true) const;
+
+  // Prints one CSV row per phase.
+  static void PrintPhasesCSVHeader(std::ostream& out);
+  void PrintPhasesAsCSV(std::ostream& out, bool print_header = true) const;
+
  private:
   friend std::ostream& operator<<(std::ostream& out,
                                   const BenchmarkResult& res);   //友元函数
+  template <class DatabaseInterface>
+  friend class Session;
+  friend class impl::MetricsTracker;
   const std::chrono::nanoseconds run_time_;
   const FrozenMeter reads_, writes_, scans_;
   const FrozenMeter deletes_; const size_t failed_deletes_; ////////////////////
   const size_t failed_reads_, failed_writes_, failed_scans_;
+  const FrozenMeter range_deletes_, merges_, compare_and_swaps_;
+  const size_t failed_range_deletes_, failed_merges_,
+      failed_compare_and_swaps_;
+  const FrozenMeter transactions_;
+  const size_t failed_transactions_, transaction_aborts_,
+      transaction_retries_;
   const uint32_t read_xor_;
+  std::chrono::nanoseconds start_skew_;
+  std::vector<NodeSummary> per_node_;
+  std::vector<ThreadResult> per_thread_;
+  std::vector<PhaseResult> per_phase_;
+  std::vector<TimeSeriesSample> timeline_;
+  PerfCounters perf_;
+  PerfByOperation operation_perf_;
 };
 
 std::ostream& operator<<(std::ostream& out, const BenchmarkResult& res);
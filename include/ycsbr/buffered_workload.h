@@ -1,5 +1,10 @@
+#include <cstddef>
+#include <utility>
 #include <vector>
 
+#include "impl/page_allocator.h"
+#include "impl/workload_traits.h"
+#include "memory_options.h"
 #include "request.h"
 
 namespace ycsbr {
@@ -10,11 +15,16 @@ namespace ycsbr {
 //
 // The purpose of this warpper is to help avoid the runtime overhead of
 // generating the workload. The trade-off is that more memory will be used (to
-// store all the requests).
+// store all the requests). The requests are stored according to `memory`.
+//
+// Workloads with phases bounded by a duration cannot be buffered (their
+// requests depend on when the run's deadline passes); `GetProducers()` throws
+// `std::invalid_argument` for them.
 template <class Workload>
 class BufferedWorkload {
  public:
-  BufferedWorkload(const Workload& workload);
+  BufferedWorkload(const Workload& workload,
+                   const MemoryOptions& memory = MemoryOptions());
 
   // Get a reference to the wrapped workload.
   const Workload& workload() const;
@@ -24,21 +34,31 @@ class BufferedWorkload {
 
  private:
   const Workload& workload_;
+  MemoryOptions memory_;
 };
 
 template <class Workload>
 class BufferedWorkload<Workload>::Producer {
  public:
-  Producer(typename Workload::Producer producer);
+  Producer(typename Workload::Producer producer, const MemoryOptions& memory);
   void Prepare();
   bool HasNext() const;
   const Request& Next();
 
+  // The phase that the next request belongs to (always 0 if the wrapped
+  // workload does not report phases).
+  size_t CurrentPhase() const;
+
  private:
   typename Workload::Producer producer_;
 
-  std::vector<Request> requests_;
+  impl::PageVector<Request> requests_;
   size_t next_request_;
+
+  // The ID of each run of consecutive requests that belong to the same phase,
+  // along with the index one past the run's last request.
+  std::vector<std::pair<size_t, size_t>> phases_;
+  size_t current_phase_index_;
 };
 
 }  // namespace ycsbr
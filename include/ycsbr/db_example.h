@@ -5,6 +5,8 @@
 #include <utility>
 #include <vector>
 
+#include "pinned_value.h"
+#include "scan_visitor.h"
 #include "trace.h"
 
 namespace ycsbr {
@@ -15,6 +17,13 @@ namespace ycsbr {
 // **Do not subclass this class.** Just implement the same methods with the same
 // signatures in a concrete class. We use templates in ReplayTrace() to
 // avoid vtable overheads.
+//
+// String keys: to benchmark byte string keys, take a `std::string_view` key
+// (instead of a `Request::Key`) in every method that takes a key, including
+// the optional ones. YCSBR detects this from `Read()` and encodes each
+// request's key with `RunOptions::key_encoder` before calling the database.
+// The view is only valid during the call. Bulk loads still pass integer keys;
+// encode them with the same `KeyEncoder` (e.g., `KeyEncoder::EncodeBatch()`).
 class ExampleDatabaseInterface final {
  public:
   // The class must be default constructible.
@@ -43,6 +52,11 @@ class ExampleDatabaseInterface final {
   // Load the records into the database.
   virtual void BulkLoad(const BulkLoadTrace& load) = 0;
 
+  // OPTIONAL: Load one partition of a bulk load. Only needed for
+  // `Session::ReplayBulkLoadTraceParallel()`, which calls this method
+  // concurrently from every worker thread (each with a different partition).
+  virtual void BulkLoadPartition(const BulkLoadTrace::Partition& partition) = 0;
+
   // Update the value at the specified key. Return true if the update succeeded.
   virtual bool Update(Request::Key key, const char* value,
                       size_t value_size) = 0;
@@ -51,14 +65,74 @@ class ExampleDatabaseInterface final {
   virtual bool Insert(Request::Key key, const char* value,
                       size_t value_size) = 0;
 
+  // OPTIONAL: Delete the record with the specified key. Return true if the
+  // delete succeeded. Only needed for workloads that make deletes.
+  //
+  // Databases without native deletes can instead write `tombstone` as the
+  // record's value. YCSBR then treats a read of the tombstone as a failed read
+  // (and drops it from scan results), as long as the workload reports its
+  // tombstone (see `workload_example.h`). Databases with native deletes should
+  // ignore `tombstone` and return false when reading a deleted record.
+  virtual bool Delete(Request::Key key, const char* tombstone,
+                      size_t tombstone_size) = 0;
+
+  // OPTIONAL: Delete up to `amount` records in key order, starting from `key`
+  // (like a scan of the same length). Return true if the delete succeeded.
+  // YCSBR counts `amount` records for each successful range delete, even if
+  // fewer records existed. Only needed for workloads that make range deletes.
+  virtual bool DeleteRange(Request::Key key, size_t amount) = 0;
+
+  // OPTIONAL: Apply the merge operand `value` to the record at the specified
+  // key (e.g., an append or a counter increment), without reading the record
+  // first. Return true if the merge succeeded. Only needed for workloads that
+  // make merges.
+  virtual bool Merge(Request::Key key, const char* value,
+                     size_t value_size) = 0;
+
+  // OPTIONAL: Atomically replace the value at the specified key with `value`,
+  // but only if the record's value is still `expected`. Return false if the
+  // value changed (or if the record does not exist). YCSBR reads the record
+  // just before the call to get `expected`. Only needed for workloads that make
+  // compare-and-swaps.
+  virtual bool CompareAndSwap(Request::Key key, const char* expected,
+                              size_t expected_size, const char* value,
+                              size_t value_size) = 0;
+
+  // OPTIONAL: Transactions. Only needed for workloads that make transactions
+  // (see `Request::Operation::kTransaction`). YCSBR calls `BeginTxn()`, then
+  // makes the transaction's requests on the same thread using the methods
+  // above, and then calls `Commit()`. Requests made between `BeginTxn()` and
+  // `Commit()` belong to the transaction. Return false from `Commit()` if the
+  // transaction aborted (e.g., because of a conflict). An `Update()` or
+  // `Insert()` that returns false inside a transaction also aborts it; YCSBR
+  // then calls `Abort()` instead of `Commit()`. Aborted transactions are
+  // retried (see `RunOptions::max_transaction_retries`).
+  virtual void BeginTxn() = 0;
+  virtual bool Commit() = 0;
+  virtual void Abort() = 0;
+
   // Read the value at the specified key. Return true if the read succeeded.
   virtual bool Read(Request::Key key, std::string* value_out) = 0;
 
+  // OPTIONAL: Read the value at the specified key without copying it. Return
+  // true if the read succeeded. If implemented, YCSBR uses this method instead
+  // of `Read()`: pin the value in `value_out` (see `pinned_value.h`), and it
+  // will be released right after YCSBR reads it.
+  virtual bool PinnedRead(Request::Key key, PinnedValue* value_out) = 0;
+
   // Scan the key range starting from `key` for `amount` records. Return true if
   // the scan succeeded.
   virtual bool Scan(
       Request::Key key, size_t amount,
       std::vector<std::pair<Request::Key, std::string>>* scan_out) = 0;
+
+  // OPTIONAL: Scan the key range starting from `key`, passing each record to
+  // `visitor` in key order until it returns false (or the range ends). Return
+  // true if the scan succeeded. If implemented, YCSBR uses this method instead
+  // of `Scan()`, which avoids copying each record into a `std::string`. The
+  // value only needs to stay valid during the call to `visitor`.
+  virtual bool VisitScan(Request::Key key, size_t amount,
+                         ScanVisitor& visitor) = 0;
 };
 
 }  // namespace ycsbr
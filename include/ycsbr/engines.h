@@ -0,0 +1,12 @@
+#pragma once
+
+// --- YCSBR: Your Customizable Synthetic Benchmark Runner ---
+// Include this header to get access to the reference in-memory engines. They
+// implement the `DatabaseInterface` contract (see `db_example.h`) and are
+// useful for calibrating the benchmark harness: a fixed engine separates
+// changes in the harness's overhead from changes in a database's performance.
+// In your CMake project, link to the `ycsbr-engines` library target.
+
+#include "engines/btree_engine.h"
+#include "engines/hash_map_engine.h"
+#include "engines/skiplist_engine.h"
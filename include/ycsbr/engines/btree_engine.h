@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ycsbr/request.h"
+#include "ycsbr/scan_visitor.h"
+#include "ycsbr/trace.h"
+
+namespace ycsbr {
+namespace engines {
+
+class Record;
+
+// An in-memory B+tree that uses optimistic lock coupling (Leis et al., "The
+// ART of Practical Synchronization", DaMoN 2016). Readers traverse the tree
+// without taking locks and validate each node's version instead; writers only
+// lock the nodes they modify. Full nodes are split eagerly on the way down, so
+// a split never propagates upwards.
+//
+// Nodes and records are only freed when the tree is destroyed, and deleted
+// records stay in the tree (a later insert revives them). This keeps the
+// optimistic reads safe without an epoch-based reclamation scheme.
+class BTreeEngine {
+ public:
+  BTreeEngine();
+  ~BTreeEngine();
+
+  BTreeEngine(const BTreeEngine&) = delete;
+  BTreeEngine& operator=(const BTreeEngine&) = delete;
+
+  void InitializeWorker(const std::thread::id& /*worker_id*/) {}
+  void ShutdownWorker(const std::thread::id& /*worker_id*/) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+
+  void BulkLoad(const BulkLoadTrace& load);
+  void BulkLoadPartition(const BulkLoadTrace::Partition& partition);
+
+  // Returns false if the key does not exist.
+  bool Update(Request::Key key, const char* value, size_t value_size);
+  // Overwrites the value if the key already exists.
+  bool Insert(Request::Key key, const char* value, size_t value_size);
+  // Returns false if the key does not exist.
+  bool Delete(Request::Key key, const char* tombstone, size_t tombstone_size);
+  bool Read(Request::Key key, std::string* value_out);
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out);
+  bool VisitScan(Request::Key key, size_t amount, ScanVisitor& visitor);
+
+ private:
+  struct Node;
+  struct InnerNode;
+  struct LeafNode;
+
+  // Returns the leaf that should hold `key`, along with the leaf's version
+  // (read while the path to the leaf was unchanged).
+  LeafNode* FindLeaf(Request::Key key, uint64_t* version) const;
+  // Returns the record for `key`, or nullptr if the key was never inserted.
+  Record* Find(Request::Key key) const;
+  // Returns the record for `key`, adding an (empty) record if needed.
+  Record* FindOrAdd(Request::Key key);
+  // Calls `callback(key, record)` on the records with keys at least `start`,
+  // in key order, until it returns false.
+  template <class Callback>
+  void ForEachFrom(Request::Key start, Callback&& callback) const;
+
+  // Splits the full `node`, given its parent and the versions read while
+  // traversing to it. Does nothing if either node changed since then.
+  void SplitNode(Node* node, uint64_t version, InnerNode* parent,
+                 uint64_t parent_version);
+  void MakeRoot(Request::Key separator, Node* left, Node* right);
+  static void FreeSubtree(Node* node);
+
+  std::atomic<Node*> root_;
+};
+
+}  // namespace engines
+}  // namespace ycsbr
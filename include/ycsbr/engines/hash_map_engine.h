@@ -0,0 +1,62 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ycsbr/request.h"
+#include "ycsbr/scan_visitor.h"
+#include "ycsbr/trace.h"
+
+namespace ycsbr {
+namespace engines {
+
+// An in-memory hash map split into independently locked shards (each shard is
+// a `std::unordered_map` behind a reader-writer lock). The map only supports
+// point operations: scans always fail.
+//
+// Like the other reference engines, this class implements the
+// `DatabaseInterface` contract (see `db_example.h`), so it can be passed to a
+// `Session` directly.
+class HashMapEngine {
+ public:
+  static constexpr size_t kNumShards = 256;
+
+  HashMapEngine();
+  ~HashMapEngine();
+
+  HashMapEngine(const HashMapEngine&) = delete;
+  HashMapEngine& operator=(const HashMapEngine&) = delete;
+
+  void InitializeWorker(const std::thread::id& /*worker_id*/) {}
+  void ShutdownWorker(const std::thread::id& /*worker_id*/) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+
+  void BulkLoad(const BulkLoadTrace& load);
+  void BulkLoadPartition(const BulkLoadTrace::Partition& partition);
+
+  // Returns false if the key does not exist.
+  bool Update(Request::Key key, const char* value, size_t value_size);
+  // Overwrites the value if the key already exists.
+  bool Insert(Request::Key key, const char* value, size_t value_size);
+  // Returns false if the key does not exist.
+  bool Delete(Request::Key key, const char* tombstone, size_t tombstone_size);
+  bool Read(Request::Key key, std::string* value_out);
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out);
+
+  // The number of records in the map.
+  size_t NumRecords() const;
+
+ private:
+  struct Shard;
+  Shard& ShardFor(Request::Key key) const;
+
+  std::unique_ptr<Shard[]> shards_;
+};
+
+}  // namespace engines
+}  // namespace ycsbr
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ycsbr/request.h"
+#include "ycsbr/scan_visitor.h"
+#include "ycsbr/trace.h"
+
+namespace ycsbr {
+namespace engines {
+
+class Record;
+
+// An in-memory lock-free skiplist. Nodes are linked in with compare-and-swap
+// instructions (level 0 first, so a node is visible once it is in the bottom
+// list), and lookups and scans never lock.
+//
+// Nodes are never unlinked: a delete marks the node's record as deleted, and
+// a later insert revives it. A node's height is derived from a hash of its
+// key, so the list's shape only depends on the set of keys it holds (runs are
+// repeatable).
+class SkipListEngine {
+ public:
+  static constexpr int kMaxHeight = 16;
+
+  SkipListEngine();
+  ~SkipListEngine();
+
+  SkipListEngine(const SkipListEngine&) = delete;
+  SkipListEngine& operator=(const SkipListEngine&) = delete;
+
+  void InitializeWorker(const std::thread::id& /*worker_id*/) {}
+  void ShutdownWorker(const std::thread::id& /*worker_id*/) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+
+  void BulkLoad(const BulkLoadTrace& load);
+  void BulkLoadPartition(const BulkLoadTrace::Partition& partition);
+
+  // Returns false if the key does not exist.
+  bool Update(Request::Key key, const char* value, size_t value_size);
+  // Overwrites the value if the key already exists.
+  bool Insert(Request::Key key, const char* value, size_t value_size);
+  // Returns false if the key does not exist.
+  bool Delete(Request::Key key, const char* tombstone, size_t tombstone_size);
+  bool Read(Request::Key key, std::string* value_out);
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out);
+  bool VisitScan(Request::Key key, size_t amount, ScanVisitor& visitor);
+
+ private:
+  struct Node;
+
+  static Node* NewNode(Request::Key key, int height);
+  static void FreeNode(Node* node);
+  static int HeightFor(Request::Key key);
+
+  // Returns the first node with a key at least `key` (or nullptr).
+  Node* FindGreaterOrEqual(Request::Key key) const;
+  // Fills in, for every level, the last node with a key less than `key` and
+  // its successor.
+  void FindSplice(Request::Key key, Node** prev, Node** next) const;
+  // Returns the record for `key`, adding an (empty) record if needed.
+  Record* FindOrAdd(Request::Key key);
+
+  Node* head_;
+};
+
+}  // namespace engines
+}  // namespace ycsbr
@@ -17,6 +17,8 @@ class Chooser {
   virtual size_t Next(PRNG& prng) = 0;
   virtual void SetItemCount(size_t item_count) = 0;
   virtual void IncreaseItemCountBy(size_t delta) = 0;   
+  // Used when records are deleted.
+  virtual void DecreaseItemCountBy(size_t delta) = 0;
 };
 
 }  // namespace gen
@@ -8,6 +8,8 @@
 #include "ycsbr/gen/keygen.h"
 #include "ycsbr/gen/phase.h"
 #include "ycsbr/gen/types.h"
+#include "ycsbr/key_encoder.h"
+#include "ycsbr/memory_options.h"
 
 namespace ycsbr {
 namespace gen {
@@ -22,10 +24,25 @@ class WorkloadConfig {
   static std::shared_ptr<WorkloadConfig> LoadFromString(
       const std::string& raw_config, const size_t set_record_size_bytes = 0);
 
+  // Creates a config that is equivalent to a YCSB core workload property file
+  // (e.g., `ycsb/workloada`). The record size is set by the file's
+  // `fieldcount` and `fieldlength` properties. See
+  // `generator/ycsb_properties.h` for the supported properties.
+  static std::shared_ptr<WorkloadConfig> LoadFromYCSBProperties(
+      const std::filesystem::path& properties_file);
+  static std::shared_ptr<WorkloadConfig> LoadFromYCSBPropertiesString(
+      const std::string& raw_properties);
+
   virtual bool UsingCustomDataset() const = 0;
   virtual size_t GetNumLoadRecords() const = 0;
   virtual size_t GetRecordSizeBytes() const = 0;
+  // Returns 1 if the config does not ask for compressible values.
+  virtual double GetValueCompressionRatio() const = 0;
   virtual std::unique_ptr<Generator> GetLoadGenerator() const = 0;
+  // The default `KeyEncoder` if the config has no key encoding section.
+  virtual KeyEncoder GetKeyEncoder() const = 0;
+  // How to allocate the workload's key lists.
+  virtual MemoryOptions GetMemoryOptions() const = 0;
 
   virtual size_t GetNumPhases() const = 0;
   virtual Phase GetPhase(PhaseID phase_id, ProducerID producer_id,
@@ -3,11 +3,16 @@
 #include <vector>
 
 #include "ycsbr/gen/types.h"
+#include "ycsbr/impl/page_allocator.h"
 #include "ycsbr/request.h"
 
 namespace ycsbr {
 namespace gen {
 
+// A list of keys. Large lists are allocated according to the workload's
+// `MemoryOptions`.
+using KeyList = impl::PageVector<Request::Key>;
+
 // Generates keys.
 // Used to generate keys for inserts.
 class Generator {
@@ -17,7 +22,7 @@ class Generator {
   // The generated keys must be in the range [0, 2^48 - 1] (i.e., only the least
   // significant 48 bits may be used to represent a key). The number of
   // generated keys is stored by the `Generator` instance.
-  virtual void Generate(PRNG& prng, std::vector<Request::Key>* dest,
+  virtual void Generate(PRNG& prng, KeyList* dest,
                         size_t start_index) const = 0;
 };
 
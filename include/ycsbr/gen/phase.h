@@ -1,9 +1,16 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <limits>
 #include <memory>
+#include <optional>
 
 #include "ycsbr/gen/chooser.h"
 #include "ycsbr/gen/types.h"
+#include "ycsbr/gen/valuegen.h"
 #include "ycsbr/request.h"
 
 namespace ycsbr {
@@ -23,10 +30,20 @@ struct Phase {
         negativeread_thres(0),
         scan_thres(0),
         update_thres(0),
+        deleterange_thres(0),
+        merge_thres(0),
+        cas_thres(0),
+        txn_thres(0),
         delete_thres(0),         ///////////////////
         num_deletes(0),   //////////////////
         num_deletes_left(0),  ///////////////////
-        max_scan_length(0) {}
+        max_scan_length(0),
+        max_delete_range_length(0),
+        txn_num_reads(0),
+        txn_num_writes(0),
+        duration(0),
+        requests_until_clock_check(0),
+        shares_request_budget(false) {}
 
   bool HasNext() const { return num_requests_left > 0; }
 
@@ -46,6 +63,18 @@ struct Phase {
     if (update_chooser != nullptr) {
       update_chooser->SetItemCount(item_count);
     }
+    if (deleterange_chooser != nullptr) {
+      deleterange_chooser->SetItemCount(item_count);
+    }
+    if (merge_chooser != nullptr) {
+      merge_chooser->SetItemCount(item_count);
+    }
+    if (cas_chooser != nullptr) {
+      cas_chooser->SetItemCount(item_count);
+    }
+    if (txn_chooser != nullptr) {
+      txn_chooser->SetItemCount(item_count);
+    }
     /////////////////////////////////
     if (delete_chooser != nullptr) {
       delete_chooser->SetItemCount(item_count);
@@ -69,6 +98,18 @@ struct Phase {
     if (update_chooser != nullptr) {
       update_chooser->IncreaseItemCountBy(delta);
     }
+    if (deleterange_chooser != nullptr) {
+      deleterange_chooser->IncreaseItemCountBy(delta);
+    }
+    if (merge_chooser != nullptr) {
+      merge_chooser->IncreaseItemCountBy(delta);
+    }
+    if (cas_chooser != nullptr) {
+      cas_chooser->IncreaseItemCountBy(delta);
+    }
+    if (txn_chooser != nullptr) {
+      txn_chooser->IncreaseItemCountBy(delta);
+    }
     /////////////////////////////////
     if (delete_chooser != nullptr) {
       delete_chooser->IncreaseItemCountBy(delta);
@@ -76,6 +117,40 @@ struct Phase {
     /////////////////////////////////
   }
 
+  // Called after a record is deleted.
+  void DecreaseItemCountBy(const size_t delta) {
+    if (read_chooser != nullptr) {
+      read_chooser->DecreaseItemCountBy(delta);
+    }
+    if (rmw_chooser != nullptr) {
+      rmw_chooser->DecreaseItemCountBy(delta);
+    }
+    if (negativeread_chooser != nullptr) {
+      negativeread_chooser->DecreaseItemCountBy(delta);
+    }
+    if (scan_chooser != nullptr) {
+      scan_chooser->DecreaseItemCountBy(delta);
+    }
+    if (update_chooser != nullptr) {
+      update_chooser->DecreaseItemCountBy(delta);
+    }
+    if (deleterange_chooser != nullptr) {
+      deleterange_chooser->DecreaseItemCountBy(delta);
+    }
+    if (merge_chooser != nullptr) {
+      merge_chooser->DecreaseItemCountBy(delta);
+    }
+    if (cas_chooser != nullptr) {
+      cas_chooser->DecreaseItemCountBy(delta);
+    }
+    if (txn_chooser != nullptr) {
+      txn_chooser->DecreaseItemCountBy(delta);
+    }
+    if (delete_chooser != nullptr) {
+      delete_chooser->DecreaseItemCountBy(delta);
+    }
+  }
+
   PhaseID phase_id;
 
   size_t num_inserts, num_inserts_left;
@@ -83,8 +158,13 @@ struct Phase {
   size_t num_deletes, num_deletes_left;   ///////////////////////////
 
   uint32_t read_thres, rmw_thres, negativeread_thres, scan_thres, update_thres;
+  uint32_t deleterange_thres, merge_thres, cas_thres, txn_thres;
   uint32_t delete_thres;              //////////////////////////////
   size_t max_scan_length;
+  size_t max_delete_range_length;
+  // Each transaction reads `txn_num_reads` keys and then updates
+  // `txn_num_writes` keys, all chosen by `txn_chooser`.
+  uint32_t txn_num_reads, txn_num_writes;
   std::unique_ptr<Chooser> read_chooser;
   std::unique_ptr<Chooser> rmw_chooser;
   std::unique_ptr<Chooser> negativeread_chooser;
@@ -92,6 +172,100 @@ struct Phase {
   std::unique_ptr<Chooser> scan_length_chooser;
   std::unique_ptr<Chooser> update_chooser;
   std::unique_ptr<Chooser> delete_chooser;      ///////////////////////////
+  std::unique_ptr<Chooser> deleterange_chooser;
+  std::unique_ptr<Chooser> deleterange_length_chooser;
+  std::unique_ptr<Chooser> merge_chooser;
+  std::unique_ptr<Chooser> cas_chooser;
+  std::unique_ptr<Chooser> txn_chooser;
+  // Chooses the sizes of the values written in this phase. If null, values
+  // have the workload's default size (see `record_size_bytes`).
+  std::unique_ptr<ValueSizeChooser> value_size_chooser;
+
+  // Duration-based phases run until a wall-clock deadline (`num_requests` is
+  // then only an upper bound). This is zero for phases that are bounded only by
+  // `num_requests`.
+  std::chrono::nanoseconds duration;
+  // Set when this producer starts the phase. All producers share the same
+  // deadline (see `SharedPhaseState`).
+  std::optional<std::chrono::steady_clock::time_point> deadline;
+  // The clock is only read once every few requests to keep the check cheap.
+  size_t requests_until_clock_check;
+
+  // If true, this producer claims the phase's requests in chunks from a budget
+  // shared with the other producers (see `SharedPhaseState`). In that case
+  // `num_requests_left` only counts the requests left in the current chunk.
+  bool shares_request_budget;
+
+  // Used as `num_requests` for phases that are bounded only by their
+  // duration.
+  static constexpr size_t kUnboundedRequests =
+      std::numeric_limits<size_t>::max();
+};
+
+// Phase state that is shared by all of a workload's producers.
+// This is meant for internal use only.
+class SharedPhaseState {
+ public:
+  SharedPhaseState(const size_t num_phases, const size_t chunk_size)
+      : num_phases_(num_phases),
+        chunk_size_(chunk_size),
+        slots_(std::make_unique<Slot[]>(num_phases)) {}
+
+  // The number of requests a producer claims at a time from a phase's shared
+  // request budget (see `WorkDistribution::kSharedChunks`).
+  size_t chunk_size() const { return chunk_size_; }
+
+  // Returns the deadline of a duration-based phase. The first producer to start
+  // the phase sets the deadline to `now + duration`; all other producers adopt
+  // that deadline, even if they start the phase later.
+  std::chrono::steady_clock::time_point DeadlineFor(
+      const PhaseID phase_id, const std::chrono::nanoseconds duration) {
+    using Clock = std::chrono::steady_clock;
+    const int64_t candidate =
+        (Clock::now() + duration).time_since_epoch().count();
+    int64_t expected = kNoDeadline;
+    if (!slots_[phase_id].deadline.compare_exchange_strong(
+            expected, candidate, std::memory_order_acq_rel)) {
+      return Clock::time_point(Clock::duration(expected));
+    }
+    return Clock::time_point(Clock::duration(candidate));
+  }
+
+  // Makes producers claim the phase's `num_requests` requests from a shared
+  // budget instead of splitting them statically. Must be called before any
+  // producer is prepared.
+  void SetRequestBudget(const PhaseID phase_id, const size_t num_requests) {
+    slots_[phase_id].budget = num_requests;
+  }
+  bool HasRequestBudget(const PhaseID phase_id) const {
+    return slots_[phase_id].budget != kNoBudget;
+  }
+
+  // Claims up to `chunk_size()` requests from the phase's budget. Returns the
+  // number of requests claimed, which is 0 once the budget is used up.
+  size_t ClaimRequests(const PhaseID phase_id) {
+    Slot& slot = slots_[phase_id];
+    const size_t claimed =
+        slot.num_claimed.fetch_add(chunk_size_, std::memory_order_relaxed);
+    if (claimed >= slot.budget) return 0;
+    return std::min(chunk_size_, slot.budget - claimed);
+  }
+
+ private:
+  static constexpr int64_t kNoDeadline = 0;
+  static constexpr size_t kNoBudget = std::numeric_limits<size_t>::max();
+
+  // Each phase's state is on its own cache line since the producers update it
+  // concurrently.
+  struct alignas(64) Slot {
+    std::atomic<int64_t> deadline = kNoDeadline;
+    std::atomic<size_t> num_claimed = 0;
+    size_t budget = kNoBudget;
+  };
+
+  size_t num_phases_;
+  size_t chunk_size_;
+  std::unique_ptr<Slot[]> slots_;
 };
 
 }  // namespace gen
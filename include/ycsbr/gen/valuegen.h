@@ -1,52 +1,134 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <cstring>
 #include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
+#include "ycsbr/gen/chooser.h"
 #include "ycsbr/gen/types.h"
 #include "ycsbr/impl/util.h"
 
 namespace ycsbr {
 namespace gen {
 
+// Chooses the sizes of the values written during a workload phase.
+class ValueSizeChooser {
+ public:
+  // Every value has `size` bytes.
+  explicit ValueSizeChooser(size_t size)
+      : min_size_(size), max_size_(size), offset_chooser_(), sizes_() {}
+
+  // Value sizes are `min_size + offset_chooser->Next()`, where the chooser
+  // returns offsets in the range [0, max_size - min_size].
+  ValueSizeChooser(size_t min_size, size_t max_size,
+                   std::unique_ptr<Chooser> offset_chooser)
+      : min_size_(min_size),
+        max_size_(max_size),
+        offset_chooser_(std::move(offset_chooser)),
+        sizes_() {}
+
+  // Value sizes are drawn from `sizes`, weighted by `weights` (an empirical
+  // histogram).
+  ValueSizeChooser(std::vector<size_t> sizes, const std::vector<double>& weights)
+      : min_size_(0),
+        max_size_(0),
+        offset_chooser_(),
+        sizes_(std::move(sizes)),
+        histogram_(weights.begin(), weights.end()) {
+    if (sizes_.empty() || sizes_.size() != weights.size()) {
+      throw std::invalid_argument(
+          "A value size histogram needs one weight per size.");
+    }
+    min_size_ = *std::min_element(sizes_.begin(), sizes_.end());
+    max_size_ = *std::max_element(sizes_.begin(), sizes_.end());
+  }
+
+  size_t Next(PRNG& prng) {
+    if (!sizes_.empty()) return sizes_[histogram_(prng)];
+    if (offset_chooser_ == nullptr) return min_size_;
+    return min_size_ + offset_chooser_->Next(prng);
+  }
+
+  size_t MinSize() const { return min_size_; }
+  size_t MaxSize() const { return max_size_; }
+
+ private:
+  size_t min_size_, max_size_;
+  std::unique_ptr<Chooser> offset_chooser_;
+  std::vector<size_t> sizes_;
+  std::discrete_distribution<size_t> histogram_;
+};
+
+// Produces the values written by a workload. The values are windows into a
+// large pre-generated pool, so producing a value never allocates or copies.
+//
+// The pool compresses by about `compression_ratio` (1.0 means the values are
+// incompressible random bytes; see `impl::FillCompressibleBytes()`).
 class ValueGenerator {
  public:
-  ValueGenerator(const size_t value_size, const size_t num_values, PRNG& prng)
-      : raw_values_(nullptr),
+  static constexpr size_t kMinPoolSizeBytes = 1 << 20;
+
+  ValueGenerator(const size_t value_size, const double compression_ratio,
+                 PRNG& prng)
+      : pool_(nullptr),
+        pool_size_(0),
         value_size_(value_size),
-        total_size_(value_size * num_values),
-        next_value_index_(0) {
-    assert(num_values >= 1);
+        next_offset_(0) {
     assert(value_size_ >= sizeof(uint32_t));
-    raw_values_ = impl::GetRandomBytes(total_size_, prng);    //1024个不同的value
-    lastindex = total_size_ - value_size_;   ///////////////////////
-  }
-
-  const char* NextValue() {    //1024个value循环出现
-    const char* to_return = &(raw_values_[next_value_index_]);
-    next_value_index_ += value_size_;
-    if (next_value_index_ >= total_size_-value_size_) {    //*将最后一个value用作墓碑值   /////////////////////////////
-      next_value_index_ = 0;
+    if (compression_ratio < 1.0) {
+      throw std::invalid_argument(
+          "The value compression ratio must be at least 1.");
     }
-    return to_return;
+    pool_size_ = std::max(kMinPoolSizeBytes, 2 * value_size_);
+    pool_ = std::make_unique<char[]>(pool_size_);
+    impl::FillCompressibleBytes(pool_.get(), pool_size_, compression_ratio,
+                                prng);
   }
 
-  ////////////////////////////////
-  const char* LastValue() {    //获取墓碑值
-    const char* to_return = &(raw_values_[lastindex]);
+  // Returns a value of `size` bytes. The bytes remain valid for as long as
+  // this generator exists (or until `Relocate()` is called).
+  const char* NextValue(const size_t size) {
+    assert(size <= pool_size_);
+    if (next_offset_ + size > pool_size_) {
+      next_offset_ = 0;
+    }
+    const char* to_return = &pool_[next_offset_];
+    // Consecutive values start at different offsets, so they differ.
+    next_offset_ += size + 1;
     return to_return;
   }
-  ////////////////////////////////
+  const char* NextValue() { return NextValue(value_size_); }
 
+  // The default value size.
   size_t value_size() const { return value_size_; }
 
+  // Copies the values into a freshly allocated buffer owned by this generator.
+  // The new buffer is first touched by the calling thread, so on NUMA machines
+  // it is allocated from that thread's local node. Any pointers previously
+  // returned by `NextValue()` are invalidated. The pool is grown (by repeating
+  // its contents) if needed so that it can hold `max_value_size` byte values.
+  void Relocate(const size_t max_value_size = 0) {
+    const size_t new_size = std::max(pool_size_, 2 * max_value_size);
+    std::unique_ptr<char[]> local(new char[new_size]);
+    for (size_t offset = 0; offset < new_size; offset += pool_size_) {
+      memcpy(&local[offset], pool_.get(),
+             std::min(pool_size_, new_size - offset));
+    }
+    pool_ = std::move(local);
+    pool_size_ = new_size;
+    next_offset_ = 0;
+  }
+
  private:
-  std::unique_ptr<char[]> raw_values_;
+  std::unique_ptr<char[]> pool_;
+  size_t pool_size_;
   size_t value_size_;
-  size_t total_size_;
-  size_t next_value_index_;
-  size_t lastindex;   ///////////////////
+  size_t next_offset_;
 };
 
 }  // namespace gen
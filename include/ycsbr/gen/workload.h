@@ -4,6 +4,8 @@
 #include <filesystem>
 #include <memory>
 #include <random>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 #include <mutex>
@@ -12,11 +14,13 @@
 #include <unordered_set> ///////////////////////
 
 #include "ycsbr/gen/config.h"
+#include "ycsbr/gen/keygen.h"
 #include "ycsbr/gen/phase.h"
 #include "ycsbr/gen/types.h"
 #include "ycsbr/gen/valuegen.h"
 #include "ycsbr/request.h"
 #include "ycsbr/trace_workload.h"
+#include "ycsbr/workload_snapshot.h"
 
 namespace ycsbr {
 namespace gen {
@@ -42,6 +46,14 @@ class PhasedWorkload {
       const std::string& raw_config, uint32_t prng_seed = 42,
       const size_t set_record_size_bytes = 0);
 
+  // Creates a `PhasedWorkload` that makes the same kinds of requests as a YCSB
+  // core workload property file (e.g., `ycsb/workloada`), without running YCSB
+  // and extracting its trace (see `WorkloadConfig::LoadFromYCSBProperties()`).
+  static std::unique_ptr<PhasedWorkload> LoadFromYCSBProperties(
+      const std::filesystem::path& properties_file, uint32_t prng_seed = 42);
+  static std::unique_ptr<PhasedWorkload> LoadFromYCSBPropertiesString(
+      const std::string& raw_properties, uint32_t prng_seed = 42);
+
   // Sets the "load dataset" that should be used. This method should be used
   // when you want to use a custom dataset. Note that the workload config file's
   // "load" section must specify that the distribution is "custom".
@@ -53,9 +65,28 @@ class PhasedWorkload {
   void AddCustomInsertList(const std::string& name,   //!指定一个自定义键列表用于插入。 keys将按照给定的顺序插入。 指定的“name”应与工作负载配置文件中使用的name匹配。
                            std::vector<Request::Key> to_insert);
 
+  // Sets how each phase's requests are divided among the producers (the
+  // default is `WorkDistribution::kStatic`). With
+  // `WorkDistribution::kSharedChunks`, producers claim `chunk_size` requests at
+  // a time. Phases that make inserts or deletes, and phases bounded only by
+  // their duration, always use the static split since their keys are generated
+  // per producer up front.
+  void SetWorkDistribution(WorkDistribution distribution,
+                           size_t chunk_size = TraceWorkload::kDefaultChunkSize);
+
   // Retrieve the size of the records in the workload, in bytes.
   size_t GetRecordSizeBytes() const;    //!检索工作负载中record的大小（以字节为单位）
 
+  // Returns true if any phase is bounded by a duration (`duration_s`). The
+  // requests of such a phase depend on when the run reaches its deadline, so
+  // they cannot be generated ahead of time (see `BufferedWorkload` and
+  // `WorkloadSnapshot`).
+  bool HasDurationPhases() const;
+
+  // The key encoding that the workload config specifies for databases that
+  // take string keys. Pass it to the run through `RunOptions::key_encoder`.
+  KeyEncoder GetKeyEncoder() const;
+
   // Get a load trace that can be used to load a database with the records used
   // in this workload.    //++获取可用于load包含此工作负载中使用的记录的数据库的加载跟踪
   //
@@ -67,6 +98,14 @@ class PhasedWorkload {
   // first before this method.      //++注意：如果使用自定义数据集，则必须在此方法之前先调用“SetCustomLoadDataset()”。
   BulkLoadTrace GetLoadTrace(bool sort_requests = false) const;
 
+  // Records the request streams of `num_producers` producers into a snapshot
+  // file (see `WorkloadSnapshot`). Replay the snapshot with the same number of
+  // threads. Like running the workload, this removes the keys that the
+  // workload deletes from later load traces, so call `GetLoadTrace()` first
+  // (or load the database from a fresh `PhasedWorkload`).
+  void ExportSnapshot(const std::filesystem::path& file,
+                      size_t num_producers) const;
+
   class Producer;
   // Used by the workload runner to prepare the workload for execution. You
   // generally do not need to call this method.//++由workload runner程序用于为执行准备工作负载。您通常不需要调用此方法。
@@ -78,11 +117,16 @@ class PhasedWorkload {
  private:
   PRNG prng_;
   uint32_t prng_seed_;
+  WorkDistribution work_distribution_;
+  size_t chunk_size_;
   std::shared_ptr<WorkloadConfig> config_;
-  std::shared_ptr<std::vector<Request::Key>> load_keys_;
+  std::shared_ptr<KeyList> load_keys_;
   std::shared_ptr<std::set<Request::Key>> load_keys_set;   //////////////////////////
   std::shared_ptr<std::unordered_map<std::string, std::vector<Request::Key>>>
       custom_inserts_;
+  // The value written by every delete in this workload. It is derived from
+  // the workload's seed, independently of the producers' values.
+  std::shared_ptr<const std::string> tombstone_;
 };
 
 // Used by the workload runner to actually execute the workload. This class
@@ -95,43 +139,28 @@ class PhasedWorkload::Producer {
     return current_phase_ < phases_.size() && phases_[current_phase_].HasNext();
   }
   Request Next();
-  
-  ///////////////////////////
-  std::shared_ptr< std::vector<Request::Key>> GetLoadKeys(){   
-    return load_keys_;
-  }
-
-  std::shared_ptr<size_t> GetNumLoadKeys(){
-    return num_load_keys_;
-  }
 
-  void SetNumLoadKeys(size_t size){
-    *num_load_keys_=size;
-  }
+  // The phase that the next request belongs to.
+  PhaseID CurrentPhase() const { return current_phase_; }
 
-  std::shared_ptr<std::set<Request::Key>> GetLoadKeysSet(){
-    return load_keys_set;
-  }
+  // Called after all producers have been prepared. Rebuilds the shared list of
+  // load keys without the keys that the producers will delete.
+  void FinishPrepare();
 
-  std::vector<Phase>& GetPhases(){
-    return phases_;
+  // The value sent with delete requests, or an empty view if no phase of the
+  // workload makes deletes. Every producer returns the same tombstone, even
+  // if it makes no deletes itself, since its reads and scans can still return
+  // records deleted by the other producers.
+  std::string_view TombstoneValue() const {
+    if (tombstone_ == nullptr) return std::string_view();
+    return *tombstone_;
   }
 
-  size_t GetNumDeleteKeys(){
-    return delete_keys_.size();
-  }
-
-  const char* GetLastValue(){
-    valuegen_.LastValue();
-  }
-  
-  ///////////////////////////
-
  private:
   friend class PhasedWorkload;   //友元类
   Producer(std::shared_ptr<const WorkloadConfig> config,  //工作负载配置
           // std::shared_ptr<const std::vector<Request::Key>> load_keys,  //被加载的key
-           std::shared_ptr< std::vector<Request::Key>> load_keys,  //被加载的key     ///////////////////////////
+           std::shared_ptr<KeyList> load_keys,  //被加载的key     ///////////////////////////
            std::shared_ptr<size_t> num_load_keys_,    ///////////////////////////////
            std::mutex & mute,   //////////////////////////
            std::shared_ptr<std::unordered_set<Request::Key>> keys,   //////////////////////////
@@ -139,10 +168,36 @@ class PhasedWorkload::Producer {
            std::shared_ptr<
                const std::unordered_map<std::string, std::vector<Request::Key>>>
                custom_inserts,   //自定义插入键
+           std::shared_ptr<SharedPhaseState> phase_state,
+           std::shared_ptr<const std::string> tombstone,
            ProducerID id, size_t num_producers, uint32_t prng_seed);  //producer ID,生产者数量，prng_seed
 
   Request::Key ChooseKey(const std::unique_ptr<Chooser>& chooser);    
 
+  // The size of the next value written in `phase`.
+  size_t NextValueSize(Phase& phase) {
+    if (phase.value_size_chooser == nullptr) return valuegen_.value_size();
+    return phase.value_size_chooser->Next(prng_);
+  }
+
+  // Returns the next request of the transaction being generated (see
+  // `txn_reads_left_`).
+  Request NextTransactionRequest(Phase& phase);
+
+  // Counts a completed request against `phase` and moves on to the next phase
+  // if needed.
+  void FinishRequest(Phase& phase);
+
+  // Checks whether the current (duration-based) phase's deadline has passed.
+  // Returns true if the phase should end.
+  bool DeadlinePassed(Phase& phase);
+
+  // Claims requests for the current phase if it uses a shared request budget,
+  // and skips over phases that have no requests left for this producer.
+  void EnterPhase();
+  // Moves on to the next phase. Call `EnterPhase()` afterwards.
+  void AdvancePhase();
+
   ProducerID id_;
   size_t num_producers_;
   std::shared_ptr<const WorkloadConfig> config_;
@@ -150,10 +205,11 @@ class PhasedWorkload::Producer {
 
   std::vector<Phase> phases_;
   PhaseID current_phase_;
+  std::shared_ptr<SharedPhaseState> phase_state_;
 
   // The keys that were loaded.    //++被加载的key
   //std::shared_ptr<const std::vector<Request::Key>> load_keys_;
-  std::shared_ptr< std::vector<Request::Key>> load_keys_;    /////////////////////
+  std::shared_ptr<KeyList> load_keys_;    /////////////////////
   //size_t num_load_keys_;
   std::shared_ptr<size_t> num_load_keys_;   /////////////////////////
   // Custom keys to insert.   //++自定义插入key
@@ -162,8 +218,8 @@ class PhasedWorkload::Producer {
       custom_inserts_;
 
   // Stores all the keys this producer will eventually insert.//++存储producer的每个阶段最终将插入的所有key
-  std::vector<Request::Key> insert_keys_;
-  std::vector<Request::Key> delete_keys_;    ///////////////////////
+  KeyList insert_keys_;
+  KeyList delete_keys_;    ///////////////////////
   size_t next_insert_key_index_;
   size_t next_delete_key_index_;   ////////////////////////////
   
@@ -173,8 +229,16 @@ class PhasedWorkload::Producer {
   std::mutex & mtx;   ///////////////////////////
 
   ValueGenerator valuegen_;
+  // Shared by all producers; null if the workload does not make deletes.
+  std::shared_ptr<const std::string> tombstone_;
 
   std::uniform_int_distribution<uint32_t> op_dist_;
+
+  // The requests left in the transaction being generated. A transaction
+  // request is followed by its reads and then its updates; together they
+  // count as one of the phase's requests.
+  uint32_t txn_reads_left_;
+  uint32_t txn_writes_left_;
 };
 
 }  // namespace gen
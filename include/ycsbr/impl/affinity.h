@@ -1,6 +1,7 @@
 #pragma once
 
 #include <pthread.h>
+#include <sched.h>
 
 namespace ycsbr {
 namespace impl {
@@ -16,5 +17,12 @@ inline bool PinToCore(size_t core) {
   return pthread_setaffinity_np(thread, sizeof(cpuset), &cpuset) == 0;
 }
 
+// Returns the core that the calling thread is currently running on (0 if it
+// cannot be determined).
+inline size_t CurrentCore() {
+  const int core = sched_getcpu();
+  return core < 0 ? 0 : static_cast<size_t>(core);
+}
+
 }  // namespace impl
 }  // namespace ycsbr
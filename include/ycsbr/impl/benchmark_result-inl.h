@@ -12,7 +12,17 @@ inline BenchmarkResult::BenchmarkResult(std::chrono::nanoseconds total_run_time,
                                         FrozenMeter deletes, size_t failed_deletes,   //////////////////////
                                         size_t failed_reads,
                                         size_t failed_writes,
-                                        size_t failed_scans)
+                                        size_t failed_scans,
+                                        FrozenMeter range_deletes,
+                                        FrozenMeter merges,
+                                        FrozenMeter compare_and_swaps,
+                                        size_t failed_range_deletes,
+                                        size_t failed_merges,
+                                        size_t failed_compare_and_swaps,
+                                        FrozenMeter transactions,
+                                        size_t failed_transactions,
+                                        size_t transaction_aborts,
+                                        size_t transaction_retries)
     : run_time_(total_run_time),
       reads_(reads),
       writes_(writes),
@@ -24,19 +34,42 @@ inline BenchmarkResult::BenchmarkResult(std::chrono::nanoseconds total_run_time,
       failed_reads_(failed_reads),
       failed_writes_(failed_writes),
       failed_scans_(failed_scans),
-      read_xor_(read_xor) {}
+      range_deletes_(std::move(range_deletes)),
+      merges_(std::move(merges)),
+      compare_and_swaps_(std::move(compare_and_swaps)),
+      failed_range_deletes_(failed_range_deletes),
+      failed_merges_(failed_merges),
+      failed_compare_and_swaps_(failed_compare_and_swaps),
+      transactions_(std::move(transactions)),
+      failed_transactions_(failed_transactions),
+      transaction_aborts_(transaction_aborts),
+      transaction_retries_(transaction_retries),
+      read_xor_(read_xor),
+      start_skew_(0) {}
 
 template <typename Units>
 inline Units BenchmarkResult::RunTime() const {
   return std::chrono::duration_cast<Units>(run_time_);
 }
 
+template <typename Units>
+inline Units BenchmarkResult::StartSkew() const {
+  return std::chrono::duration_cast<Units>(start_skew_);
+}
+
 inline double BenchmarkResult::ThroughputThousandRequestsPerSecond() const {
   const uint64_t total_reqs = reads_.NumRequests() + writes_.NumRequests() +
                               scans_.NumRequests() + 
                               deletes_.NumRequests() + failed_deletes_ +   //////////////////////
                               failed_reads_ +
-                              failed_writes_ + failed_scans_;
+                              failed_writes_ + failed_scans_ +
+                              range_deletes_.NumRequests() +
+                              merges_.NumRequests() +
+                              compare_and_swaps_.NumRequests() +
+                              failed_range_deletes_ + failed_merges_ +
+                              failed_compare_and_swaps_ +
+                              transactions_.NumRequests() +
+                              failed_transactions_;
   // (requests / millisecond) is equivalent to (krequests / second)
   return total_reqs /
          std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(    //!std::chrono::duration_cast 是一个用于执行时间单位转换的函数模板。在这里，它被用来将 run_time_（可能是以不同时间单位表示的时间间隔）转换为毫秒（std::milli）为单位的时间间隔
@@ -47,7 +80,9 @@ inline double BenchmarkResult::ThroughputThousandRequestsPerSecond() const {
 inline double BenchmarkResult::ThroughputThousandRecordsPerSecond() const {
   const uint64_t total_records =
       deletes_.NumRecords() +    ////////////////////
-      reads_.NumRecords() + writes_.NumRecords() + scans_.NumRecords();
+      reads_.NumRecords() + writes_.NumRecords() + scans_.NumRecords() +
+      range_deletes_.NumRecords() + merges_.NumRecords() +
+      compare_and_swaps_.NumRecords() + transactions_.NumRecords();
   // (records / millisecond) is equivalent to (krecords / second)
   return total_records /
          std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
@@ -55,6 +90,100 @@ inline double BenchmarkResult::ThroughputThousandRecordsPerSecond() const {
              .count();
 }
 
+inline double BenchmarkResult::NodeThroughputThousandRequestsPerSecond(
+    const NodeSummary& node) const {
+  return node.num_requests /
+         std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+             run_time_)
+             .count();
+}
+
+inline double
+BenchmarkResult::ThreadResult::ThroughputThousandRequestsPerSecond() const {
+  const uint64_t total_reqs =
+      deletes.NumRequests() + reads.NumRequests() + writes.NumRequests() +
+      scans.NumRequests() + range_deletes.NumRequests() +
+      merges.NumRequests() + compare_and_swaps.NumRequests() +
+      transactions.NumRequests() + num_failed;
+  return total_reqs /
+         std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+             run_time)
+             .count();
+}
+
+inline double BenchmarkResult::ThreadResult::ThroughputThousandRecordsPerSecond()
+    const {
+  const uint64_t total_records =
+      deletes.NumRecords() + reads.NumRecords() + writes.NumRecords() +
+      scans.NumRecords() + range_deletes.NumRecords() + merges.NumRecords() +
+      compare_and_swaps.NumRecords() + transactions.NumRecords();
+  return total_records /
+         std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+             run_time)
+             .count();
+}
+
+inline double BenchmarkResult::PhaseResult::PerfPerRequest(
+    const PerfCounters::Event event) const {
+  return perf.PerRequest(
+      event, deletes.NumRequests() + reads.NumRequests() +
+                 writes.NumRequests() + scans.NumRequests() +
+                 range_deletes.NumRequests() + merges.NumRequests() +
+                 compare_and_swaps.NumRequests() + transactions.NumRequests());
+}
+
+inline double BenchmarkResult::PerfPerRequest(
+    const PerfCounters::Event event) const {
+  return perf_.PerRequest(
+      event, reads_.NumRequests() + writes_.NumRequests() +
+                 scans_.NumRequests() + deletes_.NumRequests() +
+                 failed_reads_ + failed_writes_ + failed_scans_ +
+                 failed_deletes_ + range_deletes_.NumRequests() +
+                 merges_.NumRequests() + compare_and_swaps_.NumRequests() +
+                 failed_range_deletes_ + failed_merges_ +
+                 failed_compare_and_swaps_ + transactions_.NumRequests() +
+                 failed_transactions_);
+}
+
+inline double BenchmarkResult::PhaseResult::ThroughputThousandRequestsPerSecond()
+    const {
+  const uint64_t total_reqs =
+      deletes.NumRequests() + reads.NumRequests() + writes.NumRequests() +
+      scans.NumRequests() + range_deletes.NumRequests() +
+      merges.NumRequests() + compare_and_swaps.NumRequests() +
+      transactions.NumRequests();
+  return total_reqs /
+         std::chrono::duration_cast<std::chrono::duration<double, std::milli>>(
+             run_time)
+             .count();
+}
+
+inline BenchmarkResult::Fairness BenchmarkResult::ThreadFairness() const {
+  if (per_thread_.empty()) return Fairness{1.0, 1.0};
+  double min = std::numeric_limits<double>::infinity();
+  double max = 0.0, sum = 0.0, sum_of_squares = 0.0;
+  for (const auto& thread : per_thread_) {
+    const double throughput = thread.ThroughputThousandRequestsPerSecond();
+    min = std::min(min, throughput);
+    max = std::max(max, throughput);
+    sum += throughput;
+    sum_of_squares += throughput * throughput;
+  }
+  Fairness fairness;
+  fairness.max_min_ratio =
+      min > 0.0 ? max / min : std::numeric_limits<double>::infinity();
+  fairness.jains_index = sum_of_squares > 0.0
+                             ? (sum * sum) / (per_thread_.size() * sum_of_squares)
+                             : 1.0;
+  return fairness;
+}
+
+inline double BenchmarkResult::TransactionAbortRate() const {
+  const size_t num_attempts = transactions_.NumRequests() + transaction_aborts_;
+  if (num_attempts == 0) return 0.0;
+  return static_cast<double>(transaction_aborts_) / num_attempts;
+}
+
 inline double BenchmarkResult::ThroughputReadMiBPerSecond() const {
   size_t total_read = reads_.TotalBytes() + scans_.TotalBytes();
   double read_mib = total_read / 1024.0 / 1024.0;
@@ -62,7 +191,9 @@ inline double BenchmarkResult::ThroughputReadMiBPerSecond() const {
 }
 
 inline double BenchmarkResult::ThroughputWriteMiBPerSecond() const {
-  double write_mib = writes_.TotalBytes() / 1024.0 / 1024.0;
+  double write_mib = (writes_.TotalBytes() + merges_.TotalBytes() +
+                      compare_and_swaps_.TotalBytes()) /
+                     1024.0 / 1024.0;
   return write_mib / RunTime<std::chrono::duration<double>>().count();
 }
 
@@ -87,6 +218,47 @@ inline std::ostream& operator<<(std::ostream& out, const BenchmarkResult& res) {
   out << "Total delete failed:     " << res.NumFailedDeletes()
       << std::endl;
   /////////////////////////
+  // Only printed if the workload used them, to keep the common output short.
+  if (res.RangeDeletes().NumRequests() + res.NumFailedRangeDeletes() > 0) {
+    out << "Total range delete requests: " << res.RangeDeletes().NumRequests()
+        << std::endl;
+    out << "Total range delete failed:   " << res.NumFailedRangeDeletes()
+        << std::endl;
+  }
+  if (res.Merges().NumRequests() + res.NumFailedMerges() > 0) {
+    out << "Total merge requests:      " << res.Merges().NumRequests()
+        << std::endl;
+    out << "Total merge failed:        " << res.NumFailedMerges() << std::endl;
+  }
+  if (res.CompareAndSwaps().NumRequests() + res.NumFailedCompareAndSwaps() >
+      0) {
+    out << "Total CAS requests:        " << res.CompareAndSwaps().NumRequests()
+        << std::endl;
+    out << "Total CAS failed:          " << res.NumFailedCompareAndSwaps()
+        << std::endl;
+  }
+  if (res.Transactions().NumRequests() + res.NumFailedTransactions() > 0) {
+    out << "Total committed txns:      " << res.Transactions().NumRequests()
+        << std::endl;
+    out << "Total txns failed:         " << res.NumFailedTransactions()
+        << std::endl;
+    out << "Total txn aborts:          " << res.NumTransactionAborts()
+        << std::endl;
+    out << "Total txn retries:         " << res.NumTransactionRetries()
+        << std::endl;
+    out << "Txn abort rate:            " << res.TransactionAbortRate()
+        << std::endl;
+    out << "Txn commit p50 (us):       "
+        << res.Transactions()
+               .LatencyPercentile<std::chrono::microseconds>(0.5)
+               .count()
+        << std::endl;
+    out << "Txn commit p99 (us):       "
+        << res.Transactions()
+               .LatencyPercentile<std::chrono::microseconds>(0.99)
+               .count()
+        << std::endl;
+  }
   out << "Total scanned records:     " << res.Scans().NumRecords() << std::endl;
   out << "Throughput (krequests/s):  "
       << res.ThroughputThousandRequestsPerSecond() << std::endl;
@@ -96,6 +268,63 @@ inline std::ostream& operator<<(std::ostream& out, const BenchmarkResult& res) {
       << std::endl;
   out << "Write Throughput (MiB/s):  " << res.ThroughputWriteMiBPerSecond()
       << std::endl;
+  out << "Start skew (us):           "
+      << res.StartSkew<std::chrono::microseconds>().count() << std::endl;
+  if (res.PerNode().size() > 1) {
+    for (const auto& node : res.PerNode()) {
+      out << "Node " << node.node_id << " (" << node.num_threads
+          << " threads) (krequests/s): "
+          << res.NodeThroughputThousandRequestsPerSecond(node) << std::endl;
+    }
+  }
+  if (res.PerThread().size() > 1) {
+    const BenchmarkResult::Fairness fairness = res.ThreadFairness();
+    out << "Thread fairness (max/min): " << fairness.max_min_ratio
+        << std::endl;
+    out << "Thread fairness (Jain's):  " << fairness.jains_index << std::endl;
+  }
+  if (res.Perf().AnyMeasured()) {
+    out << "Instructions per cycle:    " << res.Perf().InstructionsPerCycle()
+        << std::endl;
+    for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+      const auto event = static_cast<PerfCounters::Event>(i);
+      if (!res.Perf().Measured(event)) continue;
+      out << "Perf " << PerfCounters::EventName(event)
+          << " per request: " << res.PerfPerRequest(event) << std::endl;
+    }
+    const std::pair<const char*, const BenchmarkResult::OperationPerf*>
+        operations[] = {{"read", &res.PerOperationPerf().reads},
+                        {"write", &res.PerOperationPerf().writes},
+                        {"scan", &res.PerOperationPerf().scans},
+                        {"delete", &res.PerOperationPerf().deletes},
+                        {"range delete",
+                         &res.PerOperationPerf().range_deletes},
+                        {"merge", &res.PerOperationPerf().merges},
+                        {"compare-and-swap",
+                         &res.PerOperationPerf().compare_and_swaps},
+                        {"transaction", &res.PerOperationPerf().transactions}};
+    for (const auto& operation : operations) {
+      if (operation.second->num_sampled_requests == 0) continue;
+      out << "Perf " << operation.first << " (sampled) IPC: "
+          << operation.second->counters.InstructionsPerCycle()
+          << ", LLC misses/request: "
+          << operation.second->PerRequest(PerfCounters::kLLCMisses)
+          << ", branch misses/request: "
+          << operation.second->PerRequest(PerfCounters::kBranchMisses)
+          << std::endl;
+    }
+  }
+  if (res.PerPhase().size() > 1) {
+    for (const auto& phase : res.PerPhase()) {
+      out << "Phase " << phase.phase_id << " run time (us):    "
+          << std::chrono::duration_cast<std::chrono::microseconds>(
+                 phase.run_time)
+                 .count()
+          << std::endl;
+      out << "Phase " << phase.phase_id << " (krequests/s):    "
+          << phase.ThroughputThousandRequestsPerSecond() << std::endl;
+    }
+  }
   out << "Read XOR (ignore):         " << res.read_xor_;
   return out;
 }
@@ -110,7 +339,12 @@ inline void BenchmarkResult::PrintCSVHeader(std::ostream& out) {
          "Total delete failed,"   ///////////////////////////
          "num_scanned_keys,reads_ns_p99,"
          "reads_ns_p50,writes_ns_p99,writes_ns_p50,krequests_per_s,"
-         "krecords_per_s,read_mib_per_s,write_mib_per_s"
+         "krecords_per_s,read_mib_per_s,write_mib_per_s,start_skew_ns,"
+         "num_range_deletes,num_merges,num_compare_and_swaps,"
+         "num_failed_range_deletes,num_failed_merges,"
+         "num_failed_compare_and_swaps,num_transactions,"
+         "num_failed_transactions,num_transaction_aborts,"
+         "num_transaction_retries,transactions_ns_p99,transactions_ns_p50"
       << std::endl;
 }
 
@@ -137,7 +371,90 @@ inline void BenchmarkResult::PrintAsCSV(std::ostream& out,
   out << ThroughputThousandRequestsPerSecond() << ",";
   out << ThroughputThousandRecordsPerSecond() << ",";
   out << ThroughputReadMiBPerSecond() << ",";
-  out << ThroughputWriteMiBPerSecond() << std::endl;
+  out << ThroughputWriteMiBPerSecond() << ",";
+  out << StartSkew<nanoseconds>().count() << ",";
+  out << RangeDeletes().NumRequests() << ",";
+  out << Merges().NumRequests() << ",";
+  out << CompareAndSwaps().NumRequests() << ",";
+  out << NumFailedRangeDeletes() << ",";
+  out << NumFailedMerges() << ",";
+  out << NumFailedCompareAndSwaps() << ",";
+  out << Transactions().NumRequests() << ",";
+  out << NumFailedTransactions() << ",";
+  out << NumTransactionAborts() << ",";
+  out << NumTransactionRetries() << ",";
+  out << Transactions().LatencyPercentile<nanoseconds>(0.99).count() << ",";
+  out << Transactions().LatencyPercentile<nanoseconds>(0.5).count()
+      << std::endl;
+}
+
+inline void BenchmarkResult::PrintThreadsCSVHeader(std::ostream& out) {
+  out << "worker_id,core,total_time,num_reads,num_writes,num_scans,"
+         "num_deletes,num_failed,reads_ns_p99,reads_ns_p50,writes_ns_p99,"
+         "writes_ns_p50,krequests_per_s"
+      << std::endl;
+}
+
+inline void BenchmarkResult::PrintThreadsAsCSV(std::ostream& out,
+                                               bool print_header) const {
+  using nanoseconds = std::chrono::nanoseconds;
+  if (print_header) {
+    PrintThreadsCSVHeader(out);
+  }
+  for (const auto& thread : per_thread_) {
+    out << thread.worker_id << ",";
+    out << thread.core << ",";
+    out << std::chrono::duration_cast<std::chrono::microseconds>(
+               thread.run_time)
+               .count()
+        << ",";
+    out << thread.reads.NumRequests() << ",";
+    out << thread.writes.NumRequests() << ",";
+    out << thread.scans.NumRequests() << ",";
+    out << thread.deletes.NumRequests() << ",";
+    out << thread.num_failed << ",";
+    out << thread.reads.LatencyPercentile<nanoseconds>(0.99).count() << ",";
+    out << thread.reads.LatencyPercentile<nanoseconds>(0.5).count() << ",";
+    out << thread.writes.LatencyPercentile<nanoseconds>(0.99).count() << ",";
+    out << thread.writes.LatencyPercentile<nanoseconds>(0.5).count() << ",";
+    out << thread.ThroughputThousandRequestsPerSecond() << std::endl;
+  }
+}
+
+inline void BenchmarkResult::PrintPhasesCSVHeader(std::ostream& out) {
+  out << "phase_id,total_time,num_reads,num_writes,num_scans,num_deletes,"
+         "reads_ns_p99,reads_ns_p50,writes_ns_p99,writes_ns_p50,"
+         "krequests_per_s,ipc,llc_misses_per_req,dtlb_misses_per_req,"
+         "branch_misses_per_req"
+      << std::endl;
+}
+
+inline void BenchmarkResult::PrintPhasesAsCSV(std::ostream& out,
+                                              bool print_header) const {
+  using nanoseconds = std::chrono::nanoseconds;
+  if (print_header) {
+    PrintPhasesCSVHeader(out);
+  }
+  for (const auto& phase : per_phase_) {
+    out << phase.phase_id << ",";
+    out << std::chrono::duration_cast<std::chrono::microseconds>(
+               phase.run_time)
+               .count()
+        << ",";
+    out << phase.reads.NumRequests() << ",";
+    out << phase.writes.NumRequests() << ",";
+    out << phase.scans.NumRequests() << ",";
+    out << phase.deletes.NumRequests() << ",";
+    out << phase.reads.LatencyPercentile<nanoseconds>(0.99).count() << ",";
+    out << phase.reads.LatencyPercentile<nanoseconds>(0.5).count() << ",";
+    out << phase.writes.LatencyPercentile<nanoseconds>(0.99).count() << ",";
+    out << phase.writes.LatencyPercentile<nanoseconds>(0.5).count() << ",";
+    out << phase.ThroughputThousandRequestsPerSecond() << ",";
+    out << phase.perf.InstructionsPerCycle() << ",";
+    out << phase.PerfPerRequest(PerfCounters::kLLCMisses) << ",";
+    out << phase.PerfPerRequest(PerfCounters::kDTLBMisses) << ",";
+    out << phase.PerfPerRequest(PerfCounters::kBranchMisses) << std::endl;
+  }
 }
 
 }  // namespace ycsbr
@@ -1,11 +1,14 @@
 // Implementation of declarations in buffered_workload.h. Do not include this
 // header!
 
+#include <stdexcept>
+
 namespace ycsbr {
 
 template <class Workload>
-inline BufferedWorkload<Workload>::BufferedWorkload(const Workload& workload)
-    : workload_(workload) {}
+inline BufferedWorkload<Workload>::BufferedWorkload(const Workload& workload,
+                                                   const MemoryOptions& memory)
+    : workload_(workload), memory_(memory) {}
 
 template <class Workload>
 inline const Workload& BufferedWorkload<Workload>::workload() const {
@@ -15,6 +18,16 @@ inline const Workload& BufferedWorkload<Workload>::workload() const {
 template <class Workload>
 inline std::vector<typename BufferedWorkload<Workload>::Producer>
 BufferedWorkload<Workload>::GetProducers(const size_t num_producers) const {
+  // Buffering runs the producers before the workload starts, so a phase bounded
+  // by a duration would run for its full duration without being timed (and
+  // then replay without a time limit).
+  if constexpr (impl::HasDurationPhases<Workload>::value) {
+    if (workload_.HasDurationPhases()) {
+      throw std::invalid_argument(
+          "BufferedWorkload does not support phases bounded by a duration.");
+    }
+  }
+
   // Get the actual producers.
   std::vector<typename Workload::Producer> producers =
       workload_.GetProducers(num_producers);
@@ -23,7 +36,7 @@ BufferedWorkload<Workload>::GetProducers(const size_t num_producers) const {
   std::vector<typename BufferedWorkload<Workload>::Producer> wrapper_producers;
   wrapper_producers.reserve(producers.size());
   for (auto& producer : producers) {
-    wrapper_producers.emplace_back(std::move(producer));
+    wrapper_producers.emplace_back(std::move(producer), memory_);
   }
 
   return wrapper_producers;
@@ -31,21 +44,33 @@ BufferedWorkload<Workload>::GetProducers(const size_t num_producers) const {
 
 template <class Workload>
 inline BufferedWorkload<Workload>::Producer::Producer(
-    typename Workload::Producer producer)
-    : producer_(std::move(producer)), next_request_(0) {}
+    typename Workload::Producer producer, const MemoryOptions& memory)
+    : producer_(std::move(producer)),
+      requests_(impl::PageAllocator<Request>(memory)),
+      next_request_(0),
+      current_phase_index_(0) {}
 
 template <class Workload>
 inline void BufferedWorkload<Workload>::Producer::Prepare() {
   producer_.Prepare();
 
-  // Record all generated requests.
+  // Record all generated requests (and where each phase's requests end, if
+  // the wrapped producer reports phases).
   while (producer_.HasNext()) {
+    if constexpr (impl::HasCurrentPhase<typename Workload::Producer>::value) {
+      const size_t phase_id = producer_.CurrentPhase();
+      if (phases_.empty() || phases_.back().first != phase_id) {
+        phases_.emplace_back(phase_id, requests_.size());
+      }
+    }
     requests_.push_back(producer_.Next());
+    if (!phases_.empty()) phases_.back().second = requests_.size();
   }
 
   // Always reset the next request counter, even though producers are not
   // supposed to be prepared and used more than once.
   next_request_ = 0;
+  current_phase_index_ = 0;
 }
 
 template <class Workload>
@@ -55,7 +80,17 @@ inline bool BufferedWorkload<Workload>::Producer::HasNext() const {
 
 template <class Workload>
 inline const Request& BufferedWorkload<Workload>::Producer::Next() {
-  return requests_[next_request_++];
+  const Request& request = requests_[next_request_++];
+  if (current_phase_index_ + 1 < phases_.size() &&
+      next_request_ == phases_[current_phase_index_].second) {
+    ++current_phase_index_;
+  }
+  return request;
+}
+
+template <class Workload>
+inline size_t BufferedWorkload<Workload>::Producer::CurrentPhase() const {
+  return phases_.empty() ? 0 : phases_[current_phase_index_].first;
 }
 
 }  // namespace ycsbr
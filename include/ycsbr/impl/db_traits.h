@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "../pinned_value.h"
+#include "../scan_visitor.h"
+#include "../trace.h"
+
+namespace ycsbr {
+namespace impl {
+
+// Compile-time detection of the optional methods a `DatabaseInterface` may
+// implement. See `db_example.h` for their expected signatures.
+
+// Databases that implement `Read()` with a `std::string_view` key take string
+// keys (see `KeyEncoder`) in all of their request methods.
+template <class DatabaseInterface, typename = void>
+struct HasStringKeys : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasStringKeys<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().Read(
+        std::declval<std::string_view>(), std::declval<std::string*>()))>>
+    : std::true_type {};
+
+// The type of the keys that the database's request methods take.
+template <class DatabaseInterface>
+using DatabaseKey =
+    std::conditional_t<HasStringKeys<DatabaseInterface>::value,
+                       std::string_view, Request::Key>;
+
+template <class DatabaseInterface, typename = void>
+struct HasBulkLoadPartition : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasBulkLoadPartition<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().BulkLoadPartition(
+        std::declval<const BulkLoadTrace::Partition&>()))>> : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasDelete : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasDelete<DatabaseInterface,
+                 std::void_t<decltype(std::declval<DatabaseInterface&>().Delete(
+                     std::declval<DatabaseKey<DatabaseInterface>>(), std::declval<const char*>(),
+                     std::declval<size_t>()))>> : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasDeleteRange : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasDeleteRange<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().DeleteRange(
+        std::declval<DatabaseKey<DatabaseInterface>>(),
+        std::declval<size_t>()))>> : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasMerge : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasMerge<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().Merge(
+        std::declval<DatabaseKey<DatabaseInterface>>(),
+        std::declval<const char*>(), std::declval<size_t>()))>>
+    : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasCompareAndSwap : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasCompareAndSwap<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().CompareAndSwap(
+        std::declval<DatabaseKey<DatabaseInterface>>(),
+        std::declval<const char*>(), std::declval<size_t>(),
+        std::declval<const char*>(), std::declval<size_t>()))>>
+    : std::true_type {};
+
+// Transactions need all three of `BeginTxn()`, `Commit()`, and `Abort()`.
+template <class DatabaseInterface, typename = void>
+struct HasTransactions : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasTransactions<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().BeginTxn()),
+                decltype(std::declval<DatabaseInterface&>().Commit()),
+                decltype(std::declval<DatabaseInterface&>().Abort())>>
+    : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasVisitScan : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasVisitScan<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().VisitScan(
+        std::declval<DatabaseKey<DatabaseInterface>>(), std::declval<size_t>(),
+        std::declval<ScanVisitor&>()))>> : std::true_type {};
+
+template <class DatabaseInterface, typename = void>
+struct HasPinnedRead : std::false_type {};
+
+template <class DatabaseInterface>
+struct HasPinnedRead<
+    DatabaseInterface,
+    std::void_t<decltype(std::declval<DatabaseInterface&>().PinnedRead(
+        std::declval<DatabaseKey<DatabaseInterface>>(), std::declval<PinnedValue*>()))>>
+    : std::true_type {};
+
+}  // namespace impl
+}  // namespace ycsbr
@@ -1,17 +1,29 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
-#include <fstream>
+#include <cstring>
+#include <memory>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../key_encoder.h"
+#include "../pinned_value.h"
 #include "../request.h"
 #include "../run_options.h"
+#include "affinity.h"
+#include "db_traits.h"
 #include "flag.h"
+#include "live_metrics.h"
+#include "perf_event_group.h"
+#include "tombstone.h"
 #include "tracking.h"
+#include "workload_traits.h"
 
 namespace ycsbr {
 namespace impl {
@@ -19,8 +31,11 @@ namespace impl {
 template <class DatabaseInterface, typename WorkloadProducer>
 class Executor {
  public:
+  // If `live_metrics` is not null, the executor also publishes its progress
+  // there while the workload runs.
   Executor(DatabaseInterface* db, WorkloadProducer producer, size_t id,
-           const Flag* can_start, const RunOptions& options);    //!构造函数
+           const Flag* can_start, const RunOptions& options,
+           LiveMetrics* live_metrics = nullptr);    //!构造函数
 
   Executor(const Executor&) = delete;  //拷贝构造函数被删除
   Executor& operator=(const Executor&) = delete;    //赋值运算符被删除
@@ -32,16 +47,53 @@ class Executor {
   void WaitForCompletion() const;
   MetricsTracker&& GetResults() &&;
 
+  // The time at which this executor observed the start signal. Only valid
+  // after the workload has started.
+  std::chrono::steady_clock::time_point StartTime() const {
+    return start_time_;
+  }
+
+  // The time at which this executor finished its last request. Only valid
+  // after the workload has completed.
+  std::chrono::steady_clock::time_point EndTime() const { return end_time_; }
+
+  // The core this executor was running on when the workload started.
+  size_t Core() const { return core_; }
+
+  // Runs the producer's optional `FinishPrepare()` step. Only call this after
+  // `WaitForReady()` returns.
+  void FinishPrepare();
+
   // Meant for use by YCSBR's internal microbenchmarks.
   void BM_WorkloadLoop();
 
-  WorkloadProducer& GetProducer(){   ///////////////////////////
-    return producer_;
-  }
-
  private:
+  // Databases that take string keys receive the requests' keys encoded with
+  // `RunOptions::key_encoder`.
+  static constexpr bool kStringKeys = HasStringKeys<DatabaseInterface>::value;
+  using KeyArg = DatabaseKey<DatabaseInterface>;
+  using ScanKey = std::conditional_t<kStringKeys, std::string, Request::Key>;
+
   void WorkloadLoop();
-  void SetupOutputFileIfNeeded();
+
+  // Returns the key to pass to the database. Encoded keys are written to
+  // `key_buffer_`, so they are only valid until the next call.
+  KeyArg EncodeKey(Request::Key key);
+
+  // Reads the record at `key` and touches its value (see `read_xor`). Uses the
+  // database's `PinnedRead()` if it has one; otherwise the value is copied
+  // into `value_out`. Returns false if the record was not found or holds the
+  // workload's tombstone.
+  bool ReadRecord(KeyArg key, bool check_tombstones,
+                  std::string* value_out, uint32_t* read_xor,
+                  size_t* value_size);
+
+  // Makes one attempt at running the transaction made of `requests`. Returns
+  // true if it committed. `bytes` is set to the number of bytes the attempt
+  // read and wrote.
+  bool RunTransaction(const std::vector<Request>& requests,
+                      bool check_tombstones, std::string* value_out,
+                      uint32_t* read_xor, size_t* bytes);
 
   Flag ready_;   
   const Flag* can_start_;
@@ -50,14 +102,15 @@ class Executor {
   DatabaseInterface* db_;
   WorkloadProducer producer_;
   MetricsTracker tracker_;
+  TombstoneMatcher tombstone_;
+  std::unique_ptr<char[]> key_buffer_;
   size_t id_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::chrono::steady_clock::time_point end_time_;
+  size_t core_;
 
   const RunOptions options_;
   size_t latency_sampling_counter_;   //延迟样本计数
-  size_t throughput_sampling_counter_;    //吞吐量样本计数
-
-  // Used to print out throughput samples, if requested. //++如果需要的话，用来打印输出吞吐量样本
-  std::ofstream throughput_output_file_;
 };
 
 // Implementation details follow.
@@ -65,18 +118,32 @@ class Executor {
 template <class DatabaseInterface, typename WorkloadProducer>
 inline Executor<DatabaseInterface, WorkloadProducer>::Executor(   //!构造函数的实现
     DatabaseInterface* db, WorkloadProducer producer, const size_t id,
-    const Flag* can_start, const RunOptions& options)
+    const Flag* can_start, const RunOptions& options,
+    LiveMetrics* live_metrics)
     : ready_(),
       can_start_(can_start),
       done_(),
       db_(db),
       producer_(std::move(producer)),
       tracker_(),
+      tombstone_(),
+      key_buffer_(),
       id_(id),
+      start_time_(),
+      end_time_(),
+      core_(0),
       options_(options),
-      latency_sampling_counter_(0),
-      throughput_sampling_counter_(0),
-      throughput_output_file_() {}
+      latency_sampling_counter_(0) {
+  if (options_.throughput_sample_interval.count() > 0) {
+    // Allocates the sample ring before the workload starts.
+    tracker_.EnableTimeSeries(options_.throughput_sample_interval,
+                              options_.max_throughput_samples);
+  }
+  tracker_.SetLiveMetrics(live_metrics);
+  if constexpr (kStringKeys) {
+    key_buffer_.reset(new char[options_.key_encoder.MaxKeySize()]);
+  }
+}
 
 template <class DatabaseInterface, typename WorkloadProducer>
 inline void Executor<DatabaseInterface, WorkloadProducer>::WaitForReady()   //!等待，直到准备完成
@@ -90,6 +157,13 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WaitForCompletion()
   done_.Wait();    
 }
 
+template <class DatabaseInterface, typename WorkloadProducer>
+inline void Executor<DatabaseInterface, WorkloadProducer>::FinishPrepare() {
+  if constexpr (HasFinishPrepare<WorkloadProducer>::value) {
+    producer_.FinishPrepare();
+  }
+}
+
 template <class DatabaseInterface, typename WorkloadProducer>
 inline MetricsTracker&&
 Executor<DatabaseInterface, WorkloadProducer>::GetResults() && {    //!从MetricsTracker实例中获取结果
@@ -97,6 +171,10 @@ Executor<DatabaseInterface, WorkloadProducer>::GetResults() && {    //!从Metric
   return std::move(tracker_);     //再移动结果
 }
 
+// The number of bytes a key takes up in a request.
+inline size_t KeySize(Request::Key key) { return sizeof(key); }
+inline size_t KeySize(std::string_view key) { return key.size(); }
+
 template <typename Callable>
 inline std::optional<std::chrono::nanoseconds> MeasurementHelper(     //!测量callable()函数运行时间的辅助函数
     Callable&& callable, bool measure_latency) {
@@ -115,78 +193,93 @@ template <class DatabaseInterface, typename WorkloadProducer>
 inline void Executor<DatabaseInterface, WorkloadProducer>::operator()() {      //!每个线程都运行
   // Run any needed preparation code.  //++运行任何需要的准备代码
   producer_.Prepare();  //*初始化phase_和insert_keys_和delete_keys_
+  if constexpr (HasTombstoneValue<WorkloadProducer>::value) {
+    tombstone_.SetTombstone(producer_.TombstoneValue());
+  }
 
-  // Sets up the throughput sample output file, if needed.  //++如果需要的话，设置吞吐量样本输出文件
-  SetupOutputFileIfNeeded();
+  // The counters count this thread's events, so they are opened here (on the
+  // worker thread). Each worker thread only opens them once.
+  if (options_.perf_counters != PerfCounterMode::kOff) {
+    tracker_.EnablePerfCounters(&PerfEventGroup::ForThisThread());
+  }
 
   // Now ready to proceed; wait until we're told to start.  //++现在准备继续；等待直到我们被告知开始
   ready_.Raise();    //告诉主线程：已经完成了ready工作
   can_start_->Wait();   //等待，直到主线程发送了可以开始执行任务的命令
+  start_time_ = std::chrono::steady_clock::now();
+  core_ = CurrentCore();
 
   // Run the job.  //++运行作业
   WorkloadLoop();
+  end_time_ = std::chrono::steady_clock::now();
 
   // Notify others that we are done.   //++通知主线程：我完成了
   done_.Raise();
 }
 
-template <class DatabaseInterface, typename WorkloadProducer>
-inline void
-Executor<DatabaseInterface, WorkloadProducer>::SetupOutputFileIfNeeded() {
-  if (options_.throughput_sample_period == 0) return;
-  const auto filename =
-      options_.output_dir /
-      (options_.throughput_output_file_prefix + std::to_string(id_) + ".csv");
-  throughput_output_file_ = std::ofstream(filename);
-  if (throughput_output_file_.fail()) {
-    throw std::invalid_argument("Failed to create output file: " +
-                                filename.string());
-  }
-  throughput_output_file_ << "mrecords_per_s,elapsed_ns" << std::endl;
-}
-
 template <class DatabaseInterface, typename WorkloadProducer>
 inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //!很重要的执行工作负载函数----------------------------------------------------------
   // Initialize state needed for the replay.   //++初始化重播所需的状态
   uint32_t read_xor = 0;
   std::string value_out;
-  std::vector<std::pair<Request::Key, std::string>> scan_out;
+  std::vector<std::pair<ScanKey, std::string>> scan_out;
+  std::vector<Request> txn_requests;
+
+  TimeSeriesRecorder& time_series = tracker_.time_series();
+  const bool sample_time_series = time_series.IsEnabled();
+  if (sample_time_series) {
+    time_series.Start(std::chrono::steady_clock::now());
+  }
+  const bool sample_operation_perf =
+      options_.perf_counters == PerfCounterMode::kPerOperation;
+  tracker_.StartPerfCounters();
+
+  // Reads only need to look for tombstones if the workload has one.
+  constexpr bool kMayHaveTombstones =
+      HasTombstoneValue<WorkloadProducer>::value;
+  const bool check_tombstones = kMayHaveTombstones && tombstone_.IsEnabled();
 
-  tracker_.ResetSample();  //吞吐量采样开始
-   std::cerr <<"WorkloadLoop执行中..." <<std::endl;   ///////////////////////////
+  // If the producer reports phases, the tracker keeps separate measurements
+  // for each phase.
+  constexpr bool kTrackPhases = HasCurrentPhase<WorkloadProducer>::value;
+  std::optional<size_t> phase_id;
 
   // Run our trace slice.
   while (producer_.HasNext()) {
+    if constexpr (kTrackPhases) {
+      const size_t next_phase_id = producer_.CurrentPhase();
+      if (next_phase_id != phase_id) {
+        tracker_.BeginPhase(next_phase_id);
+        phase_id = next_phase_id;
+      }
+    }
     const auto& req = producer_.Next();
+    const KeyArg key = EncodeKey(req.key);
     // std::cerr << "拿到request了" << std::endl;      /////////////////////////////
     bool measure_latency = false;
     if (++latency_sampling_counter_ >= options_.latency_sample_period) {  //每十个request测量一次request的run_time
       measure_latency = true;
       latency_sampling_counter_ = 0;
     }
+    const bool measure_perf = sample_operation_perf && measure_latency;
+    PerfCounters perf_before;
+    if (measure_perf) {
+      perf_before = tracker_.ReadPerfCounters();
+    }
 
     switch (req.op) {
       case Request::Operation::kRead:
       case Request::Operation::kNegativeRead: {    //!request为读操作
         bool succeeded = false;
-        value_out.clear();
+        size_t value_size = 0;
         const auto run_time = MeasurementHelper(
-            [this, &req, &value_out, &read_xor, &succeeded]() {
-              succeeded = db_->Read(req.key, &value_out);    //参数为key和&value
-              ///////////////////////////
-              if (succeeded) {
-                  if(value_out == (std::string)(this->GetProducer().GetLastValue()))  succeeded = false;
-              }
-              //////////////////////////
-              if (succeeded) {
-                // Force a read of the extracted value. We want to count this
-                // time against the read latency too.//++强制读取提取的值。 我们也想将这个时间计入读取延迟。
-                read_xor ^=
-                    *reinterpret_cast<const uint32_t*>(value_out.c_str());
-              }
+            [this, key, &value_out, &read_xor, &succeeded, &value_size,
+             check_tombstones]() {
+              succeeded = ReadRecord(key, check_tombstones, &value_out,
+                                     &read_xor, &value_size);    //参数为key和&value
             },
             measure_latency);
-        tracker_.RecordRead(run_time, value_out.size(), succeeded);   //如果measure_latency为false的话，run_time是空的
+        tracker_.RecordRead(run_time, value_size, succeeded);   //如果measure_latency为false的话，run_time是空的
         if (!succeeded && options_.expect_request_success) {   //如果不成功但是参数中设置了request必须成功，则抛出错误
           throw std::runtime_error(
               "Failed to read a key that was expected to be found.");
@@ -194,12 +287,18 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
         break;
       }
 
-      ///////////////////////////
       case Request::Operation::kDelete: {     //!request为删除操作
+        if constexpr (!HasDelete<DatabaseInterface>::value) {
+          throw std::runtime_error(
+              "The workload deletes records, but the database interface does "
+              "not implement Delete().");
+        }
         bool succeeded = false;
         const auto run_time = MeasurementHelper(
-            [this, &req, &succeeded]() {
-              succeeded = db_->Delete(req.key, req.value, req.value_size);  
+            [this, &req, key, &succeeded]() {
+              if constexpr (HasDelete<DatabaseInterface>::value) {
+                succeeded = db_->Delete(key, req.value, req.value_size);
+              }
             },
             measure_latency);
         tracker_.RecordDelete(run_time, succeeded);
@@ -207,20 +306,19 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
           throw std::runtime_error(
               "Failed to delete a record (expected to succeed).");
         }
-        break; 
+        break;
       }
-      ///////////////////////////
 
       case Request::Operation::kInsert: {    //!request为插入操作
         // Inserts count the whole record size, since this should be the first
         // time the entire record is written to the DB.
         bool succeeded = false;
         const auto run_time = MeasurementHelper(
-            [this, &req, &succeeded]() {
-              succeeded = db_->Insert(req.key, req.value, req.value_size);  //参数为key,value,value.size
+            [this, &req, key, &succeeded]() {
+              succeeded = db_->Insert(key, req.value, req.value_size);  //参数为key,value,value.size
             },
             measure_latency);
-        tracker_.RecordWrite(run_time, req.value_size + sizeof(req.key),    //记录key和value的大小
+        tracker_.RecordWrite(run_time, req.value_size + KeySize(key),    //记录key和value的大小
                              succeeded);
         if (!succeeded && options_.expect_request_success) {
           throw std::runtime_error(
@@ -234,8 +332,8 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
         // exist in the DB.
         bool succeeded = false;
         const auto run_time = MeasurementHelper(
-            [this, &req, &succeeded]() {
-              succeeded = db_->Update(req.key, req.value, req.value_size);  //参数为key,value,value.size
+            [this, &req, key, &succeeded]() {
+              succeeded = db_->Update(key, req.value, req.value_size);  //参数为key,value,value.size
             },
             measure_latency);
         tracker_.RecordWrite(run_time, req.value_size, succeeded);   //记录value大小
@@ -248,41 +346,62 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
 
       case Request::Operation::kScan: {     //!request为扫描操作
         bool succeeded = false;
-        scan_out.clear();
-        scan_out.reserve(req.scan_amount);
-        const auto run_time = MeasurementHelper(
-            [this, &req, &scan_out, &read_xor, &succeeded]() {
-              succeeded = db_->Scan(req.key, req.scan_amount, &scan_out);
-              /////////////////////////
-              if(succeeded){
-                std::string lastvalue = (std::string)(this->GetProducer().GetLastValue());
-                for(int i =0;i<scan_out.size();i++){
-                  if(scan_out[i].second == lastvalue )
-                  succeeded == false;
-                  break;
-                }
-              }
-              ////////////////////////
-              if (succeeded && scan_out.size() > 0) {
-                // Force a read of the first extracted value. We want to count
-                // this time against the read latency too.//++强制读取第一个提取的值。 我们也想将这个时间计入读取延迟
-                read_xor ^= *reinterpret_cast<const uint32_t*>(
-                    scan_out.front().second.c_str());
-              }
-            },
-            measure_latency);
+        size_t scanned_records = 0;
         size_t scanned_bytes = 0;
-        for (const auto& entry : scan_out) {
-          scanned_bytes += sizeof(entry.first) + entry.second.size();  //记录所有的key的大小+value的大小
+        std::optional<std::chrono::nanoseconds> run_time;
+        if constexpr (HasVisitScan<DatabaseInterface>::value) {
+          // The visitor counts the records as the database produces them, so
+          // the records are never copied.
+          ScanVisitor visitor(req.scan_amount,
+                              check_tombstones ? &tombstone_ : nullptr);
+          run_time = MeasurementHelper(
+              [this, &req, key, &visitor, &succeeded]() {
+                succeeded = db_->VisitScan(key, req.scan_amount, visitor);
+              },
+              measure_latency);
+          read_xor ^= visitor.ReadXOR();
+          scanned_records = visitor.NumRecords();
+          scanned_bytes = visitor.NumBytes();
+        } else {
+          scan_out.clear();
+          scan_out.reserve(req.scan_amount);
+          run_time = MeasurementHelper(
+              [this, &req, key, &scan_out, &read_xor, &succeeded,
+               check_tombstones]() {
+                succeeded = db_->Scan(key, req.scan_amount, &scan_out);
+                if constexpr (kMayHaveTombstones) {
+                  // Deleted records are not part of the scan's results.
+                  if (check_tombstones && succeeded) {
+                    scan_out.erase(
+                        std::remove_if(scan_out.begin(), scan_out.end(),
+                                       [this](const auto& entry) {
+                                         return tombstone_.Matches(
+                                             entry.second);
+                                       }),
+                        scan_out.end());
+                  }
+                }
+                if (succeeded && scan_out.size() > 0) {
+                  // Force a read of the first extracted value. We want to
+                  // count this time against the read latency too.//++强制读取第一个提取的值。 我们也想将这个时间计入读取延迟
+                  read_xor ^= *reinterpret_cast<const uint32_t*>(
+                      scan_out.front().second.c_str());
+                }
+              },
+              measure_latency);
+          for (const auto& entry : scan_out) {
+            scanned_bytes += KeySize(entry.first) + entry.second.size();  //记录所有的key的大小+value的大小
+          }
+          scanned_records = scan_out.size();
         }
-        tracker_.RecordScan(run_time, scanned_bytes, scan_out.size(),
+        tracker_.RecordScan(run_time, scanned_bytes, scanned_records,
                             succeeded);
         if (!succeeded && options_.expect_request_success) {
           throw std::runtime_error(
               "Failed to run a range scan (expected to succeed).");
         }
         if (options_.expect_scan_amount_found &&    //参数设置成期待scan全都能找到，但是并没有，则抛出错误
-            scan_out.size() < req.scan_amount) {
+            scanned_records < req.scan_amount) {
           throw std::runtime_error(
               "A range scan returned too few (or too many) records.");
         }
@@ -291,24 +410,17 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
 
       case Request::Operation::kReadModifyWrite: {      //!request为read_modify_write操作
         bool succeeded = false;
+        size_t value_size = 0;
 
-        // First, do the read.
+        // First, do the read. Deleted records cannot be modified.
         const auto read_run_time = MeasurementHelper(
-            [this, &req, &value_out, &read_xor, &succeeded]() {
-              // Do the read.
-              succeeded = db_->Read(req.key, &value_out);   //先读
-              if (!succeeded) return;
-              ///////////////////////////
-              if (succeeded) {
-                  if(value_out == (std::string)(this->GetProducer().GetLastValue()))  succeeded = false;
-              }
-              //////////////////////////
-              // Force a read of the extracted value. We want to count this
-              // time against the read latency too.
-              if (succeeded) read_xor ^= *reinterpret_cast<const uint32_t*>(value_out.c_str());
+            [this, key, &value_out, &read_xor, &succeeded, &value_size,
+             check_tombstones]() {
+              succeeded = ReadRecord(key, check_tombstones, &value_out,
+                                     &read_xor, &value_size);   //先读
             },
             measure_latency);
-        tracker_.RecordRead(read_run_time, value_out.size(), succeeded);
+        tracker_.RecordRead(read_run_time, value_size, succeeded);
         if (!succeeded && options_.expect_request_success) {
           throw std::runtime_error(
               "Failed to read a record during a read-modify-write (expected to "
@@ -319,8 +431,8 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
 
         // Now do the write.
         const auto write_run_time = MeasurementHelper(
-            [this, &req, &succeeded]() {
-              succeeded = db_->Update(req.key, req.value, req.value_size);   //再更新
+            [this, &req, key, &succeeded]() {
+              succeeded = db_->Update(key, req.value, req.value_size);   //再更新
             },
             measure_latency);
         tracker_.RecordWrite(write_run_time, req.value_size, succeeded);
@@ -332,22 +444,255 @@ inline void Executor<DatabaseInterface, WorkloadProducer>::WorkloadLoop() {   //
         break;
       }
 
+      case Request::Operation::kDeleteRange: {
+        if constexpr (!HasDeleteRange<DatabaseInterface>::value) {
+          throw std::runtime_error(
+              "The workload deletes ranges of records, but the database "
+              "interface does not implement DeleteRange().");
+        }
+        bool succeeded = false;
+        const auto run_time = MeasurementHelper(
+            [this, &req, key, &succeeded]() {
+              if constexpr (HasDeleteRange<DatabaseInterface>::value) {
+                succeeded = db_->DeleteRange(key, req.scan_amount);
+              }
+            },
+            measure_latency);
+        tracker_.RecordDeleteRange(run_time, req.scan_amount, succeeded);
+        if (!succeeded && options_.expect_request_success) {
+          throw std::runtime_error(
+              "Failed to delete a range of records (expected to succeed).");
+        }
+        break;
+      }
+
+      case Request::Operation::kMerge: {
+        if constexpr (!HasMerge<DatabaseInterface>::value) {
+          throw std::runtime_error(
+              "The workload merges records, but the database interface does "
+              "not implement Merge().");
+        }
+        bool succeeded = false;
+        const auto run_time = MeasurementHelper(
+            [this, &req, key, &succeeded]() {
+              if constexpr (HasMerge<DatabaseInterface>::value) {
+                succeeded = db_->Merge(key, req.value, req.value_size);
+              }
+            },
+            measure_latency);
+        tracker_.RecordMerge(run_time, req.value_size, succeeded);
+        if (!succeeded && options_.expect_request_success) {
+          throw std::runtime_error(
+              "Failed to merge into a record (expected to succeed).");
+        }
+        break;
+      }
+
+      case Request::Operation::kCompareAndSwap: {
+        if constexpr (!HasCompareAndSwap<DatabaseInterface>::value) {
+          throw std::runtime_error(
+              "The workload makes compare-and-swaps, but the database "
+              "interface does not implement CompareAndSwap().");
+        }
+        bool succeeded = false;
+        size_t value_size = 0;
+
+        // First, read the current value to use as the expected value. The
+        // value is always copied, since it must stay valid for the swap.
+        const auto read_run_time = MeasurementHelper(
+            [this, key, &value_out, &read_xor, &succeeded, &value_size,
+             check_tombstones]() {
+              value_out.clear();
+              succeeded = db_->Read(key, &value_out);
+              value_size = value_out.size();
+              if constexpr (kMayHaveTombstones) {
+                if (check_tombstones && succeeded &&
+                    tombstone_.Matches(value_out)) {
+                  succeeded = false;
+                }
+              }
+              if (succeeded && value_size >= sizeof(uint32_t)) {
+                read_xor ^=
+                    *reinterpret_cast<const uint32_t*>(value_out.data());
+              }
+            },
+            measure_latency);
+        tracker_.RecordRead(read_run_time, value_size, succeeded);
+        if (!succeeded && options_.expect_request_success) {
+          throw std::runtime_error(
+              "Failed to read a record during a compare-and-swap (expected to "
+              "succeed).");
+        }
+        // Skip the swap if the read failed.
+        if (!succeeded) break;
+
+        // Now do the swap.
+        const auto swap_run_time = MeasurementHelper(
+            [this, &req, key, &value_out, &succeeded]() {
+              if constexpr (HasCompareAndSwap<DatabaseInterface>::value) {
+                succeeded = db_->CompareAndSwap(key, value_out.data(),
+                                                value_out.size(), req.value,
+                                                req.value_size);
+              }
+            },
+            measure_latency);
+        tracker_.RecordCompareAndSwap(swap_run_time, req.value_size,
+                                      succeeded);
+        if (!succeeded && options_.expect_request_success) {
+          throw std::runtime_error(
+              "Failed to run a compare-and-swap (expected to succeed).");
+        }
+        break;
+      }
+
+      case Request::Operation::kTransaction: {
+        if constexpr (!HasTransactions<DatabaseInterface>::value) {
+          throw std::runtime_error(
+              "The workload makes transactions, but the database interface "
+              "does not implement BeginTxn(), Commit(), and Abort().");
+        }
+        // The transaction's requests follow it. They are collected first so
+        // that an aborted transaction can be retried.
+        txn_requests.clear();
+        for (uint32_t i = 0; i < req.scan_amount; ++i) {
+          if (!producer_.HasNext()) {
+            throw std::runtime_error(
+                "The workload ended in the middle of a transaction.");
+          }
+          txn_requests.push_back(producer_.Next());
+        }
+        bool committed = false;
+        size_t num_attempts = 0;
+        size_t bytes = 0;
+        const auto run_time = MeasurementHelper(
+            [this, &txn_requests, &value_out, &read_xor, &committed,
+             &num_attempts, &bytes, check_tombstones]() {
+              while (!committed &&
+                     num_attempts <= options_.max_transaction_retries) {
+                ++num_attempts;
+                committed = RunTransaction(txn_requests, check_tombstones,
+                                           &value_out, &read_xor, &bytes);
+              }
+            },
+            measure_latency);
+        tracker_.RecordTransaction(run_time, txn_requests.size(), bytes,
+                                   num_attempts, committed);
+        if (!committed && options_.expect_request_success) {
+          throw std::runtime_error(
+              "Failed to commit a transaction (expected to succeed).");
+        }
+        break;
+      }
+
       default:
         throw std::runtime_error("Unrecognized request operation!");   //无法识别的请求
     }
 
-    if (options_.throughput_sample_period > 0 &&   //如果参数中设置了吞吐量采样时间间隔且大于0，则每隔options_.throughput_sample_period个request，采样一次吞吐量到throughput_output_file_文件中
-        ++throughput_sampling_counter_ >= options_.throughput_sample_period) {
-      auto sample = tracker_.GetSample();
-      throughput_output_file_ << sample.MRecordsPerSecond() << ","
-                              << sample.ElapsedTimeNanos().count() << std::endl;
-      throughput_sampling_counter_ = 0;
+    if (measure_perf) {
+      tracker_.RecordOperationPerf(
+          req.op, tracker_.ReadPerfCounters() - perf_before);
+    }
+    if (sample_time_series) {
+      time_series.MaybeTakeSample();
     }
   }
+  if (sample_time_series) {
+    time_series.Finish(std::chrono::steady_clock::now());
+  }
+  if constexpr (kTrackPhases) {
+    tracker_.EndPhase();
+  }
+  tracker_.StopPerfCounters();
   // Used to prevent optimizing away reads.//++用于防止优化流失读取？
   tracker_.SetReadXOR(read_xor);
 }
 
+template <class DatabaseInterface, typename WorkloadProducer>
+inline typename Executor<DatabaseInterface, WorkloadProducer>::KeyArg
+Executor<DatabaseInterface, WorkloadProducer>::EncodeKey(
+    const Request::Key key) {
+  if constexpr (kStringKeys) {
+    return std::string_view(
+        key_buffer_.get(), options_.key_encoder.Encode(key, key_buffer_.get()));
+  } else {
+    return key;
+  }
+}
+
+template <class DatabaseInterface, typename WorkloadProducer>
+inline bool Executor<DatabaseInterface, WorkloadProducer>::ReadRecord(
+    const KeyArg key, const bool check_tombstones,
+    std::string* value_out, uint32_t* read_xor, size_t* value_size) {
+  std::string_view value;
+  bool succeeded = false;
+  PinnedValue pinned;
+  if constexpr (HasPinnedRead<DatabaseInterface>::value) {
+    succeeded = db_->PinnedRead(key, &pinned);
+    value = pinned.value();
+  } else {
+    value_out->clear();
+    succeeded = db_->Read(key, value_out);
+    value = *value_out;
+  }
+  *value_size = value.size();
+  if (!succeeded) return false;
+  if constexpr (HasTombstoneValue<WorkloadProducer>::value) {
+    // A tombstone means the record was deleted.
+    if (check_tombstones && tombstone_.Matches(value)) return false;
+  }
+  // Force a read of the extracted value. We want to count this time against
+  // the read latency too. A pinned value is released (when `pinned` goes out
+  // of scope) only after this read.
+  uint32_t word = 0;
+  std::memcpy(&word, value.data(),
+              value.size() < sizeof(word) ? value.size() : sizeof(word));
+  *read_xor ^= word;
+  return true;
+}
+
+template <class DatabaseInterface, typename WorkloadProducer>
+inline bool Executor<DatabaseInterface, WorkloadProducer>::RunTransaction(
+    const std::vector<Request>& requests, const bool check_tombstones,
+    std::string* value_out, uint32_t* read_xor, size_t* bytes) {
+  if constexpr (HasTransactions<DatabaseInterface>::value) {
+    *bytes = 0;
+    db_->BeginTxn();
+    for (const Request& req : requests) {
+      const KeyArg key = EncodeKey(req.key);
+      switch (req.op) {
+        case Request::Operation::kRead:
+        case Request::Operation::kNegativeRead: {
+          // A read that finds nothing does not abort the transaction.
+          size_t value_size = 0;
+          ReadRecord(key, check_tombstones, value_out, read_xor, &value_size);
+          *bytes += value_size;
+          break;
+        }
+        case Request::Operation::kInsert:
+        case Request::Operation::kUpdate: {
+          const bool succeeded =
+              req.op == Request::Operation::kInsert
+                  ? db_->Insert(key, req.value, req.value_size)
+                  : db_->Update(key, req.value, req.value_size);
+          if (!succeeded) {
+            db_->Abort();
+            return false;
+          }
+          *bytes += req.value_size;
+          break;
+        }
+        default:
+          db_->Abort();
+          throw std::runtime_error(
+              "Transactions can only contain reads, inserts, and updates.");
+      }
+    }
+    return db_->Commit();
+  } else {
+    return false;
+  }
+}
+
 template <class DatabaseInterface, typename WorkloadProducer>
 inline void Executor<DatabaseInterface, WorkloadProducer>::BM_WorkloadLoop() {
   WorkloadLoop();
@@ -1,6 +1,13 @@
 #pragma once
 
-#include <future>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "../run_options.h"
+#include "util.h"
 
 namespace ycsbr {
 namespace impl {
@@ -8,15 +15,28 @@ namespace impl {
 // A thread synchronization object representing a "flag" that can be raised (but
 // never lowered). Threads can wait for the flag to be raised, and one thread is
 // allowed to "raise" the flag to notify the waiting threads.//++一个线程同步对象，表示可以raise（但永远不会降低）的“flag”。线程可以等待该标志被raise，并且允许一个线程“raise”该flag以通知等待的线程。
-class Flag {
+//
+// Waiting threads poll the flag first and only fall back to blocking on a
+// condition variable if the `WaitPolicy` allows it. The flag sits on its own
+// cache line so that polling threads do not contend with unrelated writes.
+class alignas(64) Flag {
  public:
-  Flag() : future_(flag_.get_future().share()) {}  //!构造函数，初始化Flag
+  explicit Flag(WaitPolicy policy = WaitPolicy::kSpinThenPark)
+      : raised_(false), policy_(policy), num_parked_(0) {}
+
+  Flag(const Flag&) = delete;
+  Flag& operator=(const Flag&) = delete;
 
   // "Raises" this flag, allowing any threads that have called `Wait()` or will
   // call it in the future to proceed.//++“raises”此flag，允许任何已调用“Wait（）”或将来将调用它的线程继续进行。
   //
   // NOTE: Caller must guarantee that this method is called **at most once**.//++注意：调用者必须保证此方法最多被调用一次**。
-  void Raise() { flag_.set_value(); }
+  void Raise() {
+    raised_.store(true, std::memory_order_seq_cst);
+    if (num_parked_.load(std::memory_order_seq_cst) == 0) return;
+    { std::unique_lock<std::mutex> lock(mutex_); }
+    cv_.notify_all();
+  }
 
   // Wait for this flag to be raised. Threads will be blocked until the flag has
   // been raised. Threads that call this method after the flag has been raised
@@ -24,11 +44,39 @@ class Flag {
   //
   // This method can be called concurrently by multiple threads without mutual
   // exclusion.//++此方法可以由多个线程同时调用，而不会相互排斥。
-  void Wait() const { future_.get(); }
+  void Wait() const {
+    for (size_t i = 0; i < kSpinIterations || policy_ == WaitPolicy::kSpin;
+         ++i) {
+      if (IsRaised()) return;
+      CpuRelax();
+    }
+    if (policy_ == WaitPolicy::kSpinThenYield) {
+      while (!IsRaised()) {
+        std::this_thread::yield();
+      }
+      return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    num_parked_.fetch_add(1, std::memory_order_seq_cst);
+    cv_.wait(lock, [this]() {
+      return raised_.load(std::memory_order_seq_cst);
+    });
+    num_parked_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  bool IsRaised() const { return raised_.load(std::memory_order_acquire); }
 
  private:
-  std::promise<void> flag_;
-  std::shared_future<void> future_;
+  // Number of times a waiter polls the flag before yielding or parking.
+  static constexpr size_t kSpinIterations = 1 << 14;
+
+  std::atomic<bool> raised_;
+  const WaitPolicy policy_;
+
+  // Only used by waiters that park.
+  alignas(64) mutable std::atomic<size_t> num_parked_;
+  mutable std::mutex mutex_;
+  mutable std::condition_variable cv_;
 };
 
 }  // namespace impl
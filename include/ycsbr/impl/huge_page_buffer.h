@@ -0,0 +1,84 @@
+#pragma once
+
+#include <utility>
+
+#include "../memory_options.h"
+#include "page_allocator.h"
+
+namespace ycsbr {
+namespace impl {
+
+// A zero-initialized byte buffer. Large buffers (e.g., a trace's value pool)
+// are mapped according to `MemoryOptions` (see `MapPages()`); if the mapping
+// fails, or if the buffer is small, it is allocated from the heap instead.
+class HugePageBuffer {
+ public:
+  HugePageBuffer() : data_(nullptr), size_(0), is_mapped_(false) {}
+  HugePageBuffer(size_t size, const MemoryOptions& options);
+  ~HugePageBuffer() { Release(); }
+
+  HugePageBuffer(const HugePageBuffer&) = delete;
+  HugePageBuffer& operator=(const HugePageBuffer&) = delete;
+  HugePageBuffer(HugePageBuffer&& other) noexcept;
+  HugePageBuffer& operator=(HugePageBuffer&& other) noexcept;
+
+  char* get() const { return data_; }
+  size_t size() const { return size_; }
+  char& operator[](size_t index) const { return data_[index]; }
+
+  // Returns true if the buffer was mapped (instead of allocated from the
+  // heap).
+  bool IsMapped() const { return is_mapped_; }
+
+ private:
+  void Release();
+
+  char* data_;
+  size_t size_;
+  bool is_mapped_;
+};
+
+// Implementation details follow.
+
+inline HugePageBuffer::HugePageBuffer(const size_t size,
+                                      const MemoryOptions& options)
+    : data_(nullptr), size_(size), is_mapped_(false) {
+  if (size == 0) return;
+  if (ShouldMapPages(size, options)) {
+    data_ = static_cast<char*>(MapPages(size, options));
+    is_mapped_ = data_ != nullptr;
+  }
+  if (data_ == nullptr) {
+    data_ = new char[size]();
+  }
+}
+
+inline HugePageBuffer::HugePageBuffer(HugePageBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      is_mapped_(std::exchange(other.is_mapped_, false)) {}
+
+inline HugePageBuffer& HugePageBuffer::operator=(
+    HugePageBuffer&& other) noexcept {
+  if (this == &other) return *this;
+  Release();
+  data_ = std::exchange(other.data_, nullptr);
+  size_ = std::exchange(other.size_, 0);
+  is_mapped_ = std::exchange(other.is_mapped_, false);
+  return *this;
+}
+
+inline void HugePageBuffer::Release() {
+  if (data_ == nullptr) return;
+  if (is_mapped_) {
+    UnmapPages(data_, size_);
+  } else {
+    delete[] data_;
+  }
+  data_ = nullptr;
+  size_ = 0;
+  is_mapped_ = false;
+}
+
+}  // namespace impl
+}  // namespace ycsbr
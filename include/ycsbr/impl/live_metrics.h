@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+#include "../time_series.h"
+
+namespace ycsbr {
+namespace impl {
+
+// Progress counters that a worker publishes while a workload runs, so that a
+// `ProgressReporter` thread can read them. Only the owning worker writes to
+// these counters, so updates are relaxed loads and stores (no read-modify-write
+// instructions) on the worker's own cache lines.
+struct alignas(64) LiveMetrics {
+  enum Operation : size_t {
+    kRead = 0,
+    kWrite,
+    kScan,
+    kDelete,
+    kRangeDelete,
+    kMerge,
+    kCompareAndSwap,
+    kTransaction,
+    kNumOperations
+  };
+
+  LiveMetrics() : records(0), latency_sum_ns(0), phase(-1) {
+    for (size_t i = 0; i < kNumOperations; ++i) {
+      succeeded[i].store(0, std::memory_order_relaxed);
+      failed[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : latency_buckets) {
+      bucket.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  LiveMetrics(const LiveMetrics&) = delete;
+  LiveMetrics& operator=(const LiveMetrics&) = delete;
+
+  void Record(Operation op, std::optional<std::chrono::nanoseconds> run_time,
+              size_t num_records, bool request_succeeded) {
+    Add(request_succeeded ? succeeded[op] : failed[op], 1);
+    Add(records, num_records);
+    if (run_time.has_value()) {
+      Add(latency_buckets[LatencyHistogram::BucketFor(*run_time)], 1);
+      Add(latency_sum_ns, run_time->count());
+    }
+  }
+
+  void SetPhase(size_t phase_id) {
+    phase.store(phase_id, std::memory_order_relaxed);
+  }
+
+  static void Add(std::atomic<uint64_t>& counter, uint64_t amount) {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  std::atomic<uint64_t> succeeded[kNumOperations];
+  std::atomic<uint64_t> failed[kNumOperations];
+  std::atomic<uint64_t> records;
+  // Only includes the requests whose latency was measured.
+  std::atomic<uint64_t> latency_buckets[LatencyHistogram::kNumBuckets];
+  std::atomic<uint64_t> latency_sum_ns;
+  // The workload phase the worker is running, or -1 if the workload does not
+  // report phases.
+  std::atomic<int64_t> phase;
+};
+
+}  // namespace impl
+}  // namespace ycsbr
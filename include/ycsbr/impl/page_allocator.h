@@ -0,0 +1,158 @@
+#pragma once
+
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../memory_options.h"
+
+namespace ycsbr {
+namespace impl {
+
+inline constexpr size_t kHugePageSize = 2ULL << 20;
+
+// Returns true if an allocation of `size_bytes` should be mapped directly
+// (instead of coming from the heap) under `options`.
+inline bool ShouldMapPages(const size_t size_bytes,
+                           const MemoryOptions& options) {
+  return size_bytes >= kHugePageSize &&
+         (options.use_huge_pages || options.use_hugetlbfs ||
+          options.numa_node >= 0);
+}
+
+// The size of the mapping that `MapPages()` creates for `size_bytes`.
+inline size_t MappedSize(const size_t size_bytes) {
+  return (size_bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+}
+
+inline constexpr size_t kMaxNumaNodes = 8 * sizeof(unsigned long);
+
+// Binds the (untouched) `pages` to `options.numa_node`, if it is set.
+inline void BindPages(void* pages, const size_t mapped_size,
+                      const MemoryOptions& options) {
+  if (options.numa_node < 0) return;
+  // The pages have not been touched yet, so they will be allocated on the
+  // node. The kernel reads one bit less than `maxnode`.
+  const unsigned long node_mask = 1UL << options.numa_node;
+  syscall(SYS_mbind, pages, mapped_size, MPOL_BIND, &node_mask,
+          kMaxNumaNodes + 1, 0);
+}
+
+// Maps `MappedSize(size_bytes)` zeroed bytes at a huge page aligned address
+// and applies `options`. Returns nullptr if the mapping fails. Release the
+// memory with `UnmapPages()`.
+inline void* MapPages(const size_t size_bytes, const MemoryOptions& options) {
+  if (options.numa_node >= static_cast<int>(kMaxNumaNodes)) {
+    throw std::invalid_argument("Unsupported NUMA node.");
+  }
+  const size_t mapped_size = MappedSize(size_bytes);
+
+#ifdef MAP_HUGETLB
+  if (options.use_hugetlbfs) {
+    // Reserved huge page mappings are always aligned. Ask for 2 MiB pages in
+    // case the system's default huge page size differs.
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_SHIFT
+    flags |= 21 << MAP_HUGE_SHIFT;
+#endif
+    void* const pages =
+        mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (pages != MAP_FAILED) {
+      BindPages(pages, mapped_size, options);
+      return pages;
+    }
+    // Not enough reserved huge pages; fall back to transparent huge pages.
+  }
+#endif
+
+  // Over-allocate so that we can trim the mapping to an aligned range (the
+  // kernel only uses huge pages for aligned 2 MiB regions).
+  const size_t padded_size = mapped_size + kHugePageSize;
+  void* const mapping = mmap(nullptr, padded_size, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) return nullptr;
+
+  const uintptr_t start = reinterpret_cast<uintptr_t>(mapping);
+  const uintptr_t aligned =
+      (start + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  const size_t head = aligned - start;
+  const size_t tail = padded_size - head - mapped_size;
+  if (head > 0) munmap(mapping, head);
+  if (tail > 0) munmap(reinterpret_cast<void*>(aligned + mapped_size), tail);
+  void* const pages = reinterpret_cast<void*>(aligned);
+
+#ifdef MADV_HUGEPAGE
+  if (options.use_huge_pages || options.use_hugetlbfs) {
+    // This is only a hint; it fails harmlessly if THP is disabled.
+    madvise(pages, mapped_size, MADV_HUGEPAGE);
+  }
+#endif
+  BindPages(pages, mapped_size, options);
+  return pages;
+}
+
+inline void UnmapPages(void* pages, const size_t size_bytes) {
+  munmap(pages, MappedSize(size_bytes));
+}
+
+// A standard library allocator that maps large allocations according to its
+// `MemoryOptions` (see `MapPages()`). Small allocations come from the heap.
+template <typename T>
+class PageAllocator {
+ public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  PageAllocator() = default;
+  explicit PageAllocator(const MemoryOptions& options) : options_(options) {}
+  template <typename U>
+  PageAllocator(const PageAllocator<U>& other) : options_(other.options()) {}
+
+  T* allocate(const size_t n) {
+    const size_t size_bytes = n * sizeof(T);
+    if (!ShouldMapPages(size_bytes, options_)) {
+      return static_cast<T*>(::operator new(size_bytes));
+    }
+    void* const pages = MapPages(size_bytes, options_);
+    if (pages == nullptr) throw std::bad_alloc();
+    return static_cast<T*>(pages);
+  }
+
+  void deallocate(T* ptr, const size_t n) {
+    const size_t size_bytes = n * sizeof(T);
+    if (!ShouldMapPages(size_bytes, options_)) {
+      ::operator delete(ptr);
+      return;
+    }
+    UnmapPages(ptr, size_bytes);
+  }
+
+  const MemoryOptions& options() const { return options_; }
+
+  template <typename U>
+  bool operator==(const PageAllocator<U>& other) const {
+    return options_ == other.options();
+  }
+  template <typename U>
+  bool operator!=(const PageAllocator<U>& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  MemoryOptions options_;
+};
+
+template <typename T>
+using PageVector = std::vector<T, PageAllocator<T>>;
+
+}  // namespace impl
+}  // namespace ycsbr
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "../perf_counters.h"
+
+namespace ycsbr {
+namespace impl {
+
+// A group of hardware performance counters (see `PerfCounters::Event`) that
+// count the user-space events of the thread that opened them. The counters are
+// opened as one `perf_event_open` group so that they are scheduled onto the
+// PMU together; if the kernel multiplexes the group, the counts are scaled by
+// the fraction of time the group was running.
+//
+// Events that cannot be opened (e.g., inside a VM without a virtual PMU) are
+// skipped; `Read()` reports them as not measured.
+class PerfEventGroup {
+ public:
+  // Opens the counters for the calling thread.
+  PerfEventGroup();
+  ~PerfEventGroup();
+
+  PerfEventGroup(const PerfEventGroup&) = delete;
+  PerfEventGroup& operator=(const PerfEventGroup&) = delete;
+
+  // The calling thread's counters. They are opened the first time a thread
+  // calls this method and stay open until the thread exits.
+  static const PerfEventGroup& ForThisThread();
+
+  bool IsOpen() const { return leader_fd_ >= 0; }
+
+  // The event counts since the counters were opened.
+  PerfCounters Read() const;
+
+ private:
+  int leader_fd_;
+  std::array<int, PerfCounters::kNumEvents> fds_;
+  std::array<uint64_t, PerfCounters::kNumEvents> ids_;
+};
+
+// Implementation details follow.
+
+inline PerfEventGroup::PerfEventGroup() : leader_fd_(-1), fds_(), ids_() {
+  fds_.fill(-1);
+  ids_.fill(0);
+  for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    switch (i) {
+      case PerfCounters::kCycles:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CPU_CYCLES;
+        break;
+      case PerfCounters::kInstructions:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        break;
+      case PerfCounters::kLLCMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_LL |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+      case PerfCounters::kDTLBMisses:
+        attr.type = PERF_TYPE_HW_CACHE;
+        attr.config = PERF_COUNT_HW_CACHE_DTLB |
+                      (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                      (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+        break;
+      case PerfCounters::kBranchMisses:
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+        break;
+    }
+    attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID |
+                       PERF_FORMAT_TOTAL_TIME_ENABLED |
+                       PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    // The first event that opens successfully leads the group.
+    const int fd = syscall(__NR_perf_event_open, &attr, /*pid=*/0,
+                           /*cpu=*/-1, /*group_fd=*/leader_fd_, /*flags=*/0);
+    if (fd < 0) continue;
+    uint64_t id = 0;
+    if (ioctl(fd, PERF_EVENT_IOC_ID, &id) != 0) {
+      close(fd);
+      continue;
+    }
+    fds_[i] = fd;
+    ids_[i] = id;
+    if (leader_fd_ < 0) leader_fd_ = fd;
+  }
+}
+
+inline PerfEventGroup::~PerfEventGroup() {
+  // Close the members before the leader.
+  for (const int fd : fds_) {
+    if (fd >= 0 && fd != leader_fd_) close(fd);
+  }
+  if (leader_fd_ >= 0) close(leader_fd_);
+}
+
+inline const PerfEventGroup& PerfEventGroup::ForThisThread() {
+  thread_local const PerfEventGroup group;
+  return group;
+}
+
+inline PerfCounters PerfEventGroup::Read() const {
+  PerfCounters result;
+  if (leader_fd_ < 0) return result;
+
+  // The layout used by `PERF_FORMAT_GROUP` (see `man perf_event_open`).
+  struct {
+    uint64_t num_events;
+    uint64_t time_enabled;
+    uint64_t time_running;
+    struct {
+      uint64_t value;
+      uint64_t id;
+    } values[PerfCounters::kNumEvents];
+  } data;
+  const ssize_t bytes_read = read(leader_fd_, &data, sizeof(data));
+  if (bytes_read <= 0 || data.time_running == 0) return result;
+
+  const double scale =
+      static_cast<double>(data.time_enabled) / data.time_running;
+  for (uint64_t v = 0; v < data.num_events && v < PerfCounters::kNumEvents;
+       ++v) {
+    for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+      if (fds_[i] < 0 || ids_[i] != data.values[v].id) continue;
+      result.counts[i] = static_cast<uint64_t>(data.values[v].value * scale);
+      result.measured[i] = true;
+    }
+  }
+  return result;
+}
+
+}  // namespace impl
+}  // namespace ycsbr
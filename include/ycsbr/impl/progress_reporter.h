@@ -0,0 +1,301 @@
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "../run_options.h"
+#include "live_metrics.h"
+
+namespace ycsbr {
+namespace impl {
+
+// Publishes the workers' `LiveMetrics` in the Prometheus text exposition
+// format while a workload runs. The reporter runs on its own thread and only
+// reads the workers' counters, so it never blocks them.
+//
+// The metrics are written to `RunOptions::report_file` every
+// `RunOptions::report_interval` (the file is replaced atomically) and/or served
+// over HTTP on `127.0.0.1:<RunOptions::report_port>`.
+class ProgressReporter {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Sets up the report outputs. Throws `std::invalid_argument` if no output is
+  // configured or if an output cannot be opened, so that problems are caught
+  // before the workload starts.
+  ProgressReporter(const LiveMetrics* workers, size_t num_workers,
+                   const RunOptions& options);
+  ~ProgressReporter();
+
+  ProgressReporter(const ProgressReporter&) = delete;
+  ProgressReporter& operator=(const ProgressReporter&) = delete;
+
+  // Starts publishing. Elapsed times are measured from `workload_start`.
+  void Start(Clock::time_point workload_start);
+
+  // Publishes a final report and stops the reporter thread.
+  void Stop();
+
+  // Renders the current metrics in the Prometheus text format.
+  std::string Render() const;
+
+ private:
+  // How often the reporter thread checks whether it should stop.
+  static constexpr auto kStopCheckInterval = std::chrono::milliseconds(50);
+
+  void ReporterMain();
+  void WriteReportFile() const;
+  void ServeClient() const;
+
+  const LiveMetrics* workers_;
+  const size_t num_workers_;
+  const std::chrono::milliseconds interval_;
+  const std::filesystem::path report_file_;
+  int listen_fd_;
+
+  Clock::time_point workload_start_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stop_;
+};
+
+// Implementation details follow.
+
+inline ProgressReporter::ProgressReporter(const LiveMetrics* workers,
+                                          const size_t num_workers,
+                                          const RunOptions& options)
+    : workers_(workers),
+      num_workers_(num_workers),
+      interval_(options.report_interval),
+      report_file_(options.report_file),
+      listen_fd_(-1),
+      workload_start_(Clock::now()),
+      stop_(false) {
+  if (interval_.count() <= 0) {
+    throw std::invalid_argument("The report interval must be positive.");
+  }
+  if (report_file_.empty() && options.report_port == 0) {
+    throw std::invalid_argument(
+        "Progress reports need a report file and/or a report port.");
+  }
+  if (!report_file_.empty()) {
+    std::ofstream out(report_file_);
+    if (out.fail()) {
+      throw std::invalid_argument("Failed to create report file: " +
+                                  report_file_.string());
+    }
+  }
+  if (options.report_port != 0) {
+    listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+      throw std::invalid_argument("Failed to create the report socket.");
+    }
+    const int reuse = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    sockaddr_in address;
+    std::memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = htons(options.report_port);
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address),
+             sizeof(address)) != 0 ||
+        listen(listen_fd_, 8) != 0) {
+      close(listen_fd_);
+      listen_fd_ = -1;
+      throw std::invalid_argument("Failed to listen on report port " +
+                                  std::to_string(options.report_port) + ".");
+    }
+  }
+}
+
+inline ProgressReporter::~ProgressReporter() {
+  Stop();
+  if (listen_fd_ >= 0) {
+    close(listen_fd_);
+  }
+}
+
+inline void ProgressReporter::Start(const Clock::time_point workload_start) {
+  workload_start_ = workload_start;
+  thread_ = std::thread(&ProgressReporter::ReporterMain, this);
+}
+
+inline void ProgressReporter::Stop() {
+  if (!thread_.joinable()) return;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  cv_.notify_all();
+  thread_.join();
+}
+
+inline void ProgressReporter::ReporterMain() {
+  auto next_report = workload_start_ + interval_;
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (stop_) break;
+    }
+    const auto now = Clock::now();
+    if (now >= next_report) {
+      WriteReportFile();
+      while (next_report <= now) {
+        next_report += interval_;
+      }
+    }
+
+    const auto wait = std::min<Clock::duration>(next_report - now,
+                                                kStopCheckInterval);
+    if (listen_fd_ >= 0) {
+      pollfd listener{listen_fd_, POLLIN, 0};
+      const int timeout_ms = std::max<int>(
+          1, std::chrono::duration_cast<std::chrono::milliseconds>(wait)
+                 .count());
+      if (poll(&listener, 1, timeout_ms) > 0) {
+        ServeClient();
+      }
+    } else {
+      std::unique_lock<std::mutex> lock(mutex_);
+      cv_.wait_for(lock, wait, [this]() { return stop_; });
+    }
+  }
+  // The final report shows the completed workload.
+  WriteReportFile();
+}
+
+inline void ProgressReporter::WriteReportFile() const {
+  if (report_file_.empty()) return;
+  // Write to a temporary file first so that readers never see a partial
+  // report.
+  std::filesystem::path temp_file = report_file_;
+  temp_file += ".tmp";
+  {
+    std::ofstream out(temp_file);
+    if (out.fail()) return;
+    out << Render();
+  }
+  std::error_code error;
+  std::filesystem::rename(temp_file, report_file_, error);
+}
+
+inline void ProgressReporter::ServeClient() const {
+  const int client_fd = accept(listen_fd_, nullptr, nullptr);
+  if (client_fd < 0) return;
+  // Read (and ignore) the request; every path returns the metrics.
+  pollfd client{client_fd, POLLIN, 0};
+  if (poll(&client, 1, 100) > 0) {
+    char request[1024];
+    [[maybe_unused]] const ssize_t unused =
+        recv(client_fd, request, sizeof(request), 0);
+  }
+  const std::string body = Render();
+  const std::string response =
+      "HTTP/1.1 200 OK\r\n"
+      "Content-Type: text/plain; version=0.0.4\r\n"
+      "Content-Length: " +
+      std::to_string(body.size()) +
+      "\r\n"
+      "Connection: close\r\n\r\n" +
+      body;
+  size_t sent = 0;
+  while (sent < response.size()) {
+    const ssize_t result = send(client_fd, response.data() + sent,
+                                response.size() - sent, MSG_NOSIGNAL);
+    if (result <= 0) break;
+    sent += result;
+  }
+  close(client_fd);
+}
+
+inline std::string ProgressReporter::Render() const {
+  static const char* const kOperationNames[] = {
+      "read", "write", "scan", "delete", "range_delete", "merge",
+      "compare_and_swap", "transaction"};
+  static_assert(sizeof(kOperationNames) / sizeof(kOperationNames[0]) ==
+                LiveMetrics::kNumOperations);
+  const auto load = [](const std::atomic<uint64_t>& counter) {
+    return counter.load(std::memory_order_relaxed);
+  };
+
+  std::ostringstream out;
+  out << "# HELP ycsbr_elapsed_seconds Time since the workload started.\n"
+      << "# TYPE ycsbr_elapsed_seconds gauge\n"
+      << "ycsbr_elapsed_seconds "
+      << std::chrono::duration_cast<std::chrono::duration<double>>(
+             Clock::now() - workload_start_)
+             .count()
+      << "\n";
+  out << "# HELP ycsbr_workers Number of worker threads.\n"
+      << "# TYPE ycsbr_workers gauge\n"
+      << "ycsbr_workers " << num_workers_ << "\n";
+
+  out << "# HELP ycsbr_requests_total Requests made by each worker.\n"
+      << "# TYPE ycsbr_requests_total counter\n";
+  for (size_t w = 0; w < num_workers_; ++w) {
+    for (size_t op = 0; op < LiveMetrics::kNumOperations; ++op) {
+      out << "ycsbr_requests_total{worker=\"" << w << "\",op=\""
+          << kOperationNames[op] << "\",status=\"ok\"} "
+          << load(workers_[w].succeeded[op]) << "\n";
+      out << "ycsbr_requests_total{worker=\"" << w << "\",op=\""
+          << kOperationNames[op] << "\",status=\"failed\"} "
+          << load(workers_[w].failed[op]) << "\n";
+    }
+  }
+
+  out << "# HELP ycsbr_records_total Records processed by each worker.\n"
+      << "# TYPE ycsbr_records_total counter\n";
+  for (size_t w = 0; w < num_workers_; ++w) {
+    out << "ycsbr_records_total{worker=\"" << w << "\"} "
+        << load(workers_[w].records) << "\n";
+  }
+
+  out << "# HELP ycsbr_phase The workload phase each worker is running.\n"
+      << "# TYPE ycsbr_phase gauge\n";
+  for (size_t w = 0; w < num_workers_; ++w) {
+    const int64_t phase = workers_[w].phase.load(std::memory_order_relaxed);
+    if (phase < 0) continue;
+    out << "ycsbr_phase{worker=\"" << w << "\"} " << phase << "\n";
+  }
+
+  out << "# HELP ycsbr_request_latency_ns Latencies of the sampled requests.\n"
+      << "# TYPE ycsbr_request_latency_ns histogram\n";
+  for (size_t w = 0; w < num_workers_; ++w) {
+    uint64_t cumulative = 0;
+    for (size_t b = 0; b < LatencyHistogram::kNumBuckets; ++b) {
+      cumulative += load(workers_[w].latency_buckets[b]);
+      out << "ycsbr_request_latency_ns_bucket{worker=\"" << w << "\",le=\"";
+      if (b + 1 == LatencyHistogram::kNumBuckets) {
+        out << "+Inf";
+      } else {
+        out << LatencyHistogram::BucketUpperBound(b).count();
+      }
+      out << "\"} " << cumulative << "\n";
+    }
+    out << "ycsbr_request_latency_ns_sum{worker=\"" << w << "\"} "
+        << load(workers_[w].latency_sum_ns) << "\n";
+    out << "ycsbr_request_latency_ns_count{worker=\"" << w << "\"} "
+        << cumulative << "\n";
+  }
+  return out.str();
+}
+
+}  // namespace impl
+}  // namespace ycsbr
@@ -1,19 +1,29 @@
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <fstream>
+#include <future>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <thread>
 
 #include "../meter.h"
 #include "../trace_workload.h"
+#include "db_traits.h"
 #include "executor.h"
+#include "live_metrics.h"
+#include "progress_reporter.h"
+#include "time_series.h"
 
 namespace ycsbr {
 
 template <class DatabaseInterface> //C++模板类Session的构造函数的实现
 inline Session<DatabaseInterface>::Session(size_t num_threads,
                                            const std::vector<size_t>& core_map)
-    : threads_(core_map.size() == num_threads
+    : topology_(impl::CpuTopology::Discover()),
+      threads_(core_map.size() == num_threads
                    ? (std::make_unique<impl::ThreadPool>(
                          num_threads, core_map,
                          [this]() {
@@ -37,6 +47,12 @@ inline Session<DatabaseInterface>::Session(size_t num_threads,
   }
 }
 
+template <class DatabaseInterface>
+inline Session<DatabaseInterface>::Session(const size_t num_threads,
+                                           const PlacementPolicy placement)
+    : Session(num_threads, impl::CpuTopology::Discover().MakeCoreMap(
+                               num_threads, placement)) {}
+
 template <class DatabaseInterface>
 inline Session<DatabaseInterface>::~Session() {
   Terminate();
@@ -90,6 +106,80 @@ inline BenchmarkResult Session<DatabaseInterface>::ReplayBulkLoadTrace(
                          0);
 }
 
+template <class DatabaseInterface>
+inline BenchmarkResult Session<DatabaseInterface>::ReplayBulkLoadTraceParallel(
+    const BulkLoadTrace& load, const BulkLoadTrace::Partitioning partitioning) {
+  static_assert(impl::HasBulkLoadPartition<DatabaseInterface>::value,
+                "Parallel bulk loads require the DatabaseInterface to "
+                "implement `void BulkLoadPartition(const "
+                "BulkLoadTrace::Partition&)`.");
+  const std::vector<BulkLoadTrace::Partition> partitions =
+      load.Split(num_threads_, partitioning);
+
+  struct WorkerTiming {
+    std::chrono::steady_clock::time_point start, end;
+    size_t core = 0;
+  };
+  std::vector<WorkerTiming> timings(num_threads_);
+  std::atomic<size_t> num_ready(0);
+  impl::Flag can_start(WaitPolicy::kSpinThenYield);
+
+  std::vector<std::future<void>> done;
+  done.reserve(num_threads_);
+  for (size_t i = 0; i < num_threads_; ++i) {
+    // Each job blocks until all jobs have started, so every worker thread
+    // ends up loading exactly one partition.
+    done.push_back(threads_->Submit([this, &partitions, &timings, &num_ready,
+                                     &can_start, i]() {
+      ++num_ready;
+      can_start.Wait();
+      WorkerTiming& timing = timings[i];
+      timing.core = impl::CurrentCore();
+      timing.start = std::chrono::steady_clock::now();
+      db_.BulkLoadPartition(partitions[i]);
+      timing.end = std::chrono::steady_clock::now();
+    }));
+  }
+  while (num_ready.load() < num_threads_) {
+    std::this_thread::yield();
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  can_start.Raise();
+  for (auto& job : done) {
+    job.get();
+  }
+  const auto end = std::chrono::steady_clock::now();
+
+  std::vector<Meter> load_meters;
+  std::vector<BenchmarkResult::ThreadResult> per_thread;
+  load_meters.reserve(num_threads_);
+  per_thread.reserve(num_threads_);
+  auto last_start = start;
+  for (size_t i = 0; i < num_threads_; ++i) {
+    const auto run_time = timings[i].end - timings[i].start;
+    last_start = std::max(last_start, timings[i].start);
+    Meter meter;
+    meter.RecordMultipleRecords(run_time, partitions[i].DatasetSizeBytes(),
+                                partitions[i].size());
+    // Bulk loads only write; the other meters stay empty.
+    BenchmarkResult::ThreadResult thread;
+    thread.worker_id = i;
+    thread.core = timings[i].core;
+    thread.run_time = run_time;
+    thread.writes = Meter(meter).Freeze();
+    per_thread.push_back(std::move(thread));
+    load_meters.push_back(std::move(meter));
+  }
+
+  BenchmarkResult result(end - start, 0, FrozenMeter(),
+                         Meter::FreezeGroup(std::move(load_meters)),
+                         FrozenMeter(), FrozenMeter(), 0, 0, 0, 0);
+  result.start_skew_ = last_start - start;
+  result.per_thread_ = std::move(per_thread);
+  return result;
+}
+
 template <class DatabaseInterface>
 inline BenchmarkResult Session<DatabaseInterface>::ReplayTrace(
     const Trace& trace, const RunOptions& options) {
@@ -107,15 +197,27 @@ inline BenchmarkResult Session<DatabaseInterface>::RunWorkload(
   auto producers = workload.GetProducers(num_threads_);   //*返回一个Producer容器，里面有num_threads_个producer
   assert(producers.size() == num_threads_);  
 
-  impl::Flag can_start;
+  // Set up the progress reporter first, so that any problems with its outputs
+  // are reported before the workload starts.
+  std::unique_ptr<impl::LiveMetrics[]> live_metrics;
+  std::unique_ptr<impl::ProgressReporter> reporter;
+  if (options.report_interval.count() > 0) {
+    live_metrics = std::make_unique<impl::LiveMetrics[]>(num_threads_);
+    reporter = std::make_unique<impl::ProgressReporter>(live_metrics.get(),
+                                                        num_threads_, options);
+  }
+
+  impl::Flag can_start(options.start_wait_policy);
   std::vector<std::unique_ptr<Runner>> executors;
   executors.reserve(num_threads_);   //预留num_threads_个位置存放Runners指针
 
   size_t executor_id = 0;
   // std::cerr << "RunWorkload执行中..." <<std::endl;  /////////////////////////
   for (auto& producer : producers) {
+    impl::LiveMetrics* const live =
+        live_metrics != nullptr ? &live_metrics[executor_id] : nullptr;
     executors.push_back(std::make_unique<Runner>(
-        &db_, std::move(producer), executor_id++, &can_start, options));  //*初始化Runner,并将其装入executors,producer和Runner一对一（id相同）
+        &db_, std::move(producer), executor_id++, &can_start, options, live));  //*初始化Runner,并将其装入executors,producer和Runner一对一（id相同）
     threads_->SubmitNoWait([exec = executors.back().get()]() { (*exec)(); });   //向线程池提交任务
   }
 
@@ -124,47 +226,97 @@ inline BenchmarkResult Session<DatabaseInterface>::RunWorkload(
     executor->WaitForReady();
   }
 
-  /////////////////////////
-  //清空load_keys_
-  executors[0]->GetProducer().GetLoadKeys()->clear();
- //将set中的元素移动到load_keys_
-  std::move(executors[0]->GetProducer().GetLoadKeysSet()->begin(),executors[0]->GetProducer().GetLoadKeysSet()->end(),std::back_inserter(*(executors[0]->GetProducer().GetLoadKeys())));
-  //设置num_load_keys
-  executors[0]->GetProducer().SetNumLoadKeys(executors[0]->GetProducer().GetLoadKeys()->size());
-  //将load_keys_中的元素排序
-  std::sort(executors[0]->GetProducer().GetLoadKeys()->begin(),executors[0]->GetProducer().GetLoadKeys()->end());
-  //为每第一个个phase设置itemcount
-  size_t size = *(executors[0]->GetProducer().GetNumLoadKeys());
-  for ( auto& executor : executors) {
-    auto& phase = executor->GetProducer().GetPhases()[0];
-      phase.SetItemCount(size + executor->GetProducer().GetNumDeleteKeys());
-  }
-
-  // for ( auto& executor : executors) {
-  //   size_t size = *(executors[0]->GetProducer().GetNumLoadKeys());
-  //   for (auto& phase : executor->GetProducer().GetPhases() ){
-  //     phase.SetItemCount(size );
-  //     size += phase.num_inserts;
-  //   }
-  // }
-  ////////////////////////
+  // Let the producers finish any setup that depends on the other producers
+  // (e.g., the keys they will delete), before any of them starts.
+  for (auto& executor : executors) {
+    executor->FinishPrepare();
+  }
 
   // Start the workload and the timer. 
   const auto start = std::chrono::steady_clock::now();
   can_start.Raise();   //告诉所有的线程可以开始运行工作负载了
+  if (reporter != nullptr) {
+    reporter->Start(start);
+  }
   for (auto& executor : executors) {   //等待所有的线程都完成
     executor->WaitForCompletion();     
   }
-  const auto end = std::chrono::steady_clock::now();
+  if (reporter != nullptr) {
+    reporter->Stop();
+  }
+  // Stop the timer when the last executor finished its work rather than when
+  // this thread observed it. With duration-based phases, all executors stop at
+  // (about) the same deadline, so this excludes any wake-up delay here.
+  auto end = start;
+  for (const auto& executor : executors) {
+    end = std::max(end, executor->EndTime());
+  }
 
   // Retrieve the results.
   std::vector<impl::MetricsTracker> results;
   results.reserve(num_threads_);
+  auto last_start = start;
+  std::map<size_t, BenchmarkResult::NodeSummary> per_node;
+  std::vector<std::vector<TimeSeriesSample>> time_series;
+  time_series.reserve(num_threads_);
   for (auto& executor : executors) {
+    last_start = std::max(last_start, executor->StartTime());
     results.emplace_back(std::move(*executor).GetResults());
+    time_series.push_back(results.back().time_series().GetSamples(start));
+
+    const size_t node_id = topology_.NodeOfCpu(executor->Core());
+    auto& node =
+        per_node
+            .emplace(node_id, BenchmarkResult::NodeSummary{node_id, 0, 0})
+            .first->second;
+    node.num_threads += 1;
+    node.num_requests += results.back().TotalRequestCount();
   }
 
-  return impl::MetricsTracker::FinalizeGroup(end - start, std::move(results));
+  BenchmarkResult result =
+      impl::MetricsTracker::FinalizeGroup(end - start, std::move(results));
+  result.start_skew_ = last_start - start;
+  for (size_t i = 0; i < executors.size(); ++i) {
+    auto& thread = result.per_thread_[i];
+    thread.core = executors[i]->Core();
+    thread.run_time = executors[i]->EndTime() - executors[i]->StartTime();
+    thread.time_series = std::move(time_series[i]);
+  }
+  for (const auto& entry : per_node) {
+    result.per_node_.push_back(entry.second);
+  }
+
+  if (options.throughput_sample_interval.count() > 0) {
+    std::vector<std::vector<TimeSeriesSample>> samples;
+    samples.reserve(result.per_thread_.size());
+    for (const auto& thread : result.per_thread_) {
+      samples.push_back(thread.time_series);
+    }
+    result.timeline_ =
+        impl::MergeTimeSeries(samples, options.throughput_sample_interval);
+    // The samples are only written out once the workload is over, so that
+    // the file I/O does not interfere with the measurements.
+    for (const auto& thread : result.per_thread_) {
+      WriteTimeSeries(options, std::to_string(thread.worker_id),
+                      thread.time_series);
+    }
+    WriteTimeSeries(options, "all", result.timeline_);
+  }
+  return result;
+}
+
+template <class DatabaseInterface>
+inline void Session<DatabaseInterface>::WriteTimeSeries(
+    const RunOptions& options, const std::string& name,
+    const std::vector<TimeSeriesSample>& samples) {
+  const auto filename = options.output_dir /
+                        (options.throughput_output_file_prefix + name + ".csv");
+  std::ofstream out(filename);
+  if (out.fail()) {
+    throw std::invalid_argument("Failed to create output file: " +
+                                filename.string());
+  }
+  PrintTimeSeriesAsCSV(samples, out);
 }
 
 }  // namespace ycsbr
@@ -1,6 +1,8 @@
 #include <cassert>
+#include <cstdint>
 
 #include "affinity.h"
+#include "util.h"
 
 namespace ycsbr {
 namespace impl {
@@ -8,63 +10,254 @@ namespace impl {
 inline ThreadPool::ThreadPool(size_t num_threads,
                               std::function<void()> on_start,
                               std::function<void()> on_shutdown)
-    : shutdown_(false),
+    : next_queue_(0),
+      overflow_size_(0),
+      num_parked_(0),
+      shutdown_(false),
       on_start_(std::move(on_start)),
       on_shutdown_(std::move(on_shutdown)) {
-  for (size_t i = 0; i < num_threads; ++i) {   //每次循环都创建一个新线程
-    threads_.emplace_back(&ThreadPool::ThreadMain, this);   //&ThreadPool::ThreadMain作为线程的执行函数，this指针作为传递给线程的参数；这意味着每个线程都将执行ThreadPool类中的ThreadMain成员函数，并且可以访问该线程池的实例
-  }
+  Start(num_threads, nullptr);
 }
 
 inline ThreadPool::ThreadPool(size_t num_threads,
                               const std::vector<size_t>& thread_to_core,
                               std::function<void()> on_start,
                               std::function<void()> on_shutdown)
-    : shutdown_(false),
+    : next_queue_(0),
+      overflow_size_(0),
+      num_parked_(0),
+      shutdown_(false),
       on_start_(std::move(on_start)),
       on_shutdown_(std::move(on_shutdown)) {
   assert(num_threads == thread_to_core.size());
+  Start(num_threads, &thread_to_core);
+}
+
+inline void ThreadPool::Start(const size_t num_threads,
+                              const std::vector<size_t>* thread_to_core) {
+  // All queues must exist before any worker starts (workers steal from each
+  // other's queues).
+  queues_.reserve(num_threads);
   for (size_t i = 0; i < num_threads; ++i) {
-    threads_.emplace_back(&ThreadPool::ThreadMainOnCore, this,
-                          thread_to_core[i]);
+    queues_.emplace_back(std::make_unique<WorkerQueue>());
+  }
+  threads_.reserve(num_threads);
+  for (size_t i = 0; i < num_threads; ++i) {   //每次循环都创建一个新线程
+    if (thread_to_core != nullptr) {
+      threads_.emplace_back(&ThreadPool::ThreadMainOnCore, this, i,
+                            (*thread_to_core)[i]);
+    } else {
+      threads_.emplace_back(&ThreadPool::ThreadMain, this, i);
+    }
   }
 }
 
 inline ThreadPool::~ThreadPool() {   //超出作用域自动析构，销毁线程，使线程执行on_shundown_()函数
   {
-    std::unique_lock<std::mutex> lock(mutex_);
-    shutdown_ = true;
+    std::unique_lock<std::mutex> lock(park_mutex_);
+    shutdown_.store(true, std::memory_order_release);
   }
-  cv_.notify_all();
+  park_cv_.notify_all();
   for (auto& thread : threads_) {
     thread.join();
   }
 }
 
-inline void ThreadPool::ThreadMainOnCore(size_t core_id) {
+inline void ThreadPool::Enqueue(Task task) {
+  const size_t num_queues = queues_.size();
+  bool queued = false;
+  if (num_queues > 0) {
+    const size_t start = next_queue_.fetch_add(1, std::memory_order_relaxed);
+    for (size_t i = 0; i < num_queues && !queued; ++i) {
+      queued = queues_[(start + i) % num_queues]->TryPush(task);
+    }
+  }
+  if (!queued) {
+    std::unique_lock<std::mutex> lock(overflow_mutex_);
+    overflow_.emplace_back(std::move(task));
+    overflow_size_.fetch_add(1, std::memory_order_release);
+  }
+
+  // Pairs with the fence in `ThreadMain()` before a worker re-checks the
+  // queues and parks. Either the worker sees this task, or we see the worker.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_parked_.load(std::memory_order_relaxed) > 0) {
+    WakeOne();
+  }
+}
+
+inline void ThreadPool::WakeOne() {
+  // Acquiring the lock ensures a worker that is about to park has either not
+  // yet checked for work (and will see the new task) or is already waiting.
+  { std::unique_lock<std::mutex> lock(park_mutex_); }
+  park_cv_.notify_one();
+}
+
+inline bool ThreadPool::TryGetTask(const size_t worker_index, Task* task) {
+  // Own queue first, then try to steal from the other workers.
+  const size_t num_queues = queues_.size();
+  for (size_t i = 0; i < num_queues; ++i) {
+    if (queues_[(worker_index + i) % num_queues]->TryPop(task)) return true;
+  }
+  if (overflow_size_.load(std::memory_order_acquire) == 0) return false;
+  std::unique_lock<std::mutex> lock(overflow_mutex_);
+  if (overflow_.empty()) return false;
+  *task = std::move(overflow_.front());
+  overflow_.pop_front();
+  overflow_size_.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+inline bool ThreadPool::AnyQueueLooksNonEmpty() const {
+  for (const auto& queue : queues_) {
+    if (!queue->LooksEmpty()) return true;
+  }
+  return overflow_size_.load(std::memory_order_acquire) > 0;
+}
+
+inline void ThreadPool::ThreadMainOnCore(size_t worker_index, size_t core_id) {
   PinToCore(core_id);
-  ThreadMain();
+  ThreadMain(worker_index);
 }
 
-inline void ThreadPool::ThreadMain() {    //每个线程接收任何可以执行的任务
+inline void ThreadPool::ThreadMain(const size_t worker_index) {    //每个线程接收任何可以执行的任务
   on_start_();  //创建统计信息local并置0
-  std::unique_ptr<Task> next_job = nullptr;
+  Task next_job;
+  size_t idle_iterations = 0;
   while (true) {
-    {
-      std::unique_lock<std::mutex> lock(mutex_);
-      // Need a loop here to handle spurious wakeup   
-      while (!shutdown_ && work_queue_.empty()) {
-        cv_.wait(lock);      //!如果满足while条件，线程就释放锁，并一直在这里等待直到被唤醒
+    if (TryGetTask(worker_index, &next_job)) {
+      // If there is more queued work and some workers are parked, pass the
+      // wakeup along. This matters when tasks block (e.g., executors waiting
+      // for the start signal), since each one needs its own worker.
+      if (num_parked_.load(std::memory_order_relaxed) > 0 &&
+          AnyQueueLooksNonEmpty()) {
+        WakeOne();
       }
-      if (shutdown_ && work_queue_.empty()) break;    
-      next_job.reset(work_queue_.front().release());  //从任务队列里取出一个任务
-      work_queue_.pop();  
+      next_job();
+      next_job.Reset();
+      idle_iterations = 0;
+      continue;
+    }
+    // Only exit once all submitted work has been drained.
+    if (shutdown_.load(std::memory_order_acquire)) {
+      if (AnyQueueLooksNonEmpty()) continue;
+      break;
+    }
+
+    ++idle_iterations;
+    if (idle_iterations < kSpinIterations) {
+      CpuRelax();
+    } else if (idle_iterations < kSpinIterations + kYieldIterations) {
+      std::this_thread::yield();
+    } else {
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      num_parked_.fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      // Need a predicate here to handle spurious wakeups.
+      park_cv_.wait(lock, [this]() {
+        return shutdown_.load(std::memory_order_acquire) ||
+               AnyQueueLooksNonEmpty();
+      });
+      num_parked_.fetch_sub(1, std::memory_order_relaxed);
+      idle_iterations = 0;
     }
-    (*next_job)();
-    next_job.reset(nullptr);
   }
   on_shutdown_();   //将local汇总到全局
 }
 
+// `ThreadPool::Task` implementation.
+
+inline ThreadPool::Task::Task(Task&& other) noexcept : ops_(other.ops_) {
+  if (ops_ != nullptr) {
+    ops_->relocate(&storage_, &other.storage_);
+    other.ops_ = nullptr;
+  }
+}
+
+inline ThreadPool::Task& ThreadPool::Task::operator=(Task&& other) noexcept {
+  if (this == &other) return *this;
+  Reset();
+  ops_ = other.ops_;
+  if (ops_ != nullptr) {
+    ops_->relocate(&storage_, &other.storage_);
+    other.ops_ = nullptr;
+  }
+  return *this;
+}
+
+inline void ThreadPool::Task::Reset() {
+  if (ops_ == nullptr) return;
+  ops_->destroy(&storage_);
+  ops_ = nullptr;
+}
+
+// `ThreadPool::WorkerQueue` implementation.
+
+inline ThreadPool::WorkerQueue::WorkerQueue()
+    : cells_(std::make_unique<Cell[]>(kCapacity)),
+      enqueue_pos_(0),
+      dequeue_pos_(0) {
+  static_assert((kCapacity & (kCapacity - 1)) == 0,
+                "WorkerQueue::kCapacity must be a power of 2.");
+  for (size_t i = 0; i < kCapacity; ++i) {
+    cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+}
+
+inline bool ThreadPool::WorkerQueue::TryPush(Task& task) {
+  Cell* cell = nullptr;
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &cells_[pos & (kCapacity - 1)];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The queue is full.
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  cell->task = std::move(task);
+  cell->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+inline bool ThreadPool::WorkerQueue::TryPop(Task* task) {
+  Cell* cell = nullptr;
+  size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  while (true) {
+    cell = &cells_[pos & (kCapacity - 1)];
+    const size_t seq = cell->sequence.load(std::memory_order_acquire);
+    const intptr_t diff =
+        static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+    if (diff == 0) {
+      if (dequeue_pos_.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // The queue is empty.
+      return false;
+    } else {
+      pos = dequeue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+  *task = std::move(cell->task);
+  cell->sequence.store(pos + kCapacity, std::memory_order_release);
+  return true;
+}
+
+inline bool ThreadPool::WorkerQueue::LooksEmpty() const {
+  return enqueue_pos_.load(std::memory_order_acquire) ==
+         dequeue_pos_.load(std::memory_order_acquire);
+}
+
 }  // namespace impl
 }  // namespace ycsbr
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <thread>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace ycsbr {
@@ -14,10 +19,17 @@ namespace impl {
 
 // A thread pool that supports thread-to-core pinning.
 //
+// Each worker thread owns a bounded lock-free task queue. Submissions from
+// outside the pool are distributed round-robin across the worker queues and
+// idle workers steal from their peers' queues. Idle workers spin briefly
+// before parking, so that bursts of small submissions (e.g., starting one
+// executor per worker) do not pay for a futex wakeup per task.
+//
 // Acknowledgements: This implementation is based on other existing thread pools
 //   - https://github.com/fbastos1/thread_pool_cpp17
 //   - https://github.com/progschj/ThreadPool
 //   - https://github.com/vit-vit/CTPL
+// The per-worker queues are Dmitry Vyukov's bounded MPMC queue.
 class ThreadPool {
  public:
   // Create a thread pool with `num_threads` threads.//!构造函数
@@ -36,6 +48,9 @@ class ThreadPool {
   // Waits for all submitted functions to execute before returning.//等待所有提交的函数执行后再返回。
   ~ThreadPool();
 
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
   // Schedule `f(...args)` to run on a thread in this thread pool.//计划“f（…args）”在此线程池中的线程上运行。
   //
   // This method returns a `std::future` that can be used to wait for `f` to
@@ -47,38 +62,123 @@ class ThreadPool {
 
   // Similar to `Submit()`, but instead does not provide a future that can be
   // used to wait on the function's result.
+  //
+  // Callables whose captured state fits in `Task::kInlineSize` bytes are
+  // stored without a heap allocation.
   template <typename Function, typename... Args,
             std::enable_if_t<std::is_invocable<Function&&, Args&&...>::value,
                              bool> = true>
   void SubmitNoWait(Function&& f, Args&&... args);  //!类似于“Submit（）”，但没有提供可用于等待函数结果的future。
 
+  size_t NumThreads() const { return threads_.size(); }
+
  private:
+  // A type-erased, move-only callable. Small callables are stored inline;
+  // larger ones fall back to a heap allocation.
   class Task {
    public:
-    virtual ~Task() = default;
-    virtual void operator()() = 0;
+    static constexpr size_t kInlineSize = 64;
+
+    Task() : ops_(nullptr) {}
+
+    template <typename Function,
+              typename Decayed = std::decay_t<Function>,
+              std::enable_if_t<!std::is_same<Decayed, Task>::value, bool> =
+                  true>
+    explicit Task(Function&& f);
+
+    Task(Task&& other) noexcept;
+    Task& operator=(Task&& other) noexcept;
+    ~Task() { Reset(); }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    explicit operator bool() const { return ops_ != nullptr; }
+    void operator()() { ops_->invoke(&storage_); }
+    void Reset();
+
+   private:
+    struct Ops {
+      void (*invoke)(void* storage);
+      // Move-constructs the callable in `src` into `dest` and destroys the
+      // callable in `src`.
+      void (*relocate)(void* dest, void* src);
+      void (*destroy)(void* storage);
+    };
+
+    template <typename Function>
+    static constexpr bool kStoredInline =
+        sizeof(Function) <= kInlineSize &&
+        alignof(Function) <= alignof(std::max_align_t) &&
+        std::is_nothrow_move_constructible<Function>::value;
+
+    template <typename Function>
+    static const Ops* InlineOps();
+    template <typename Function>
+    static const Ops* HeapOps();
+
+    const Ops* ops_;
+    alignas(std::max_align_t) unsigned char storage_[kInlineSize];
   };
 
-  template <typename Function>
-  class TaskContainer : public Task {
+  // A bounded multi-producer multi-consumer queue owned by one worker thread.
+  // Any thread may push (submitters) or pop (the owner, or thieves).
+  class alignas(64) WorkerQueue {
    public:
-    TaskContainer(Function&& f) : f_(std::forward<Function>(f)) {} //!构造函数，初始化f_
-    void operator()() override { f_(); }
+    static constexpr size_t kCapacity = 256;  // Must be a power of 2.
+
+    WorkerQueue();
+
+    // Returns false (leaving `task` untouched) if the queue is full.
+    bool TryPush(Task& task);
+    // Returns false if the queue is empty.
+    bool TryPop(Task* task);
+    // A racy emptiness check that is only used as a parking hint.
+    bool LooksEmpty() const;
 
    private:
-    Function f_;
+    struct alignas(64) Cell {
+      std::atomic<size_t> sequence;
+      Task task;
+    };
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_;
+    alignas(64) std::atomic<size_t> dequeue_pos_;
   };
 
+  // Number of empty polls a worker makes (with a CPU relax hint) before it
+  // starts yielding, and the number of yields before it parks.
+  static constexpr size_t kSpinIterations = 2048;
+  static constexpr size_t kYieldIterations = 16;
+
+  void Start(size_t num_threads, const std::vector<size_t>* thread_to_core);
+  void Enqueue(Task task);
+  bool TryGetTask(size_t worker_index, Task* task);
+  bool AnyQueueLooksNonEmpty() const;
+  void WakeOne();
+
   // Worker threads run this code.
-  void ThreadMain();
+  void ThreadMain(size_t worker_index);
 
   // Ensures the worker thread runs `ThreadMain()` on core `core_id`. //!确保工作线程在核心“core_id”上运行“ThreadMain（）”`
-  void ThreadMainOnCore(size_t core_id);
+  void ThreadMainOnCore(size_t worker_index, size_t core_id);
+
+  std::vector<std::unique_ptr<WorkerQueue>> queues_;
+  alignas(64) std::atomic<size_t> next_queue_;
+
+  // Tasks that did not fit into any worker queue. This is a slow path that is
+  // only used when every queue is full.
+  std::mutex overflow_mutex_;
+  std::deque<Task> overflow_;
+  std::atomic<size_t> overflow_size_;
+
+  // Used to park idle workers.
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+  alignas(64) std::atomic<size_t> num_parked_;
+  std::atomic<bool> shutdown_;
 
-  std::mutex mutex_;
-  std::condition_variable cv_;
-  bool shutdown_;
-  std::queue<std::unique_ptr<Task>> work_queue_;
   std::vector<std::thread> threads_;
 
   // Called by each thread when it starts.
@@ -97,11 +197,7 @@ inline auto ThreadPool::Submit(Function&& f, Args&&... args) {
         return std::apply(std::move(runnable), std::move(task_args));  //?std::apply(Function, Tuple);
       });
   auto future = task.get_future();    //创建了一个 std::future 对象，用于获取任务的返回值
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    work_queue_.emplace(new TaskContainer(std::move(task)));  //将任务添加到线程池的工作队列中
-  }
-  cv_.notify_one();  //通知一个等待的线程来执行任务
+  Enqueue(Task(std::move(task)));  //将任务添加到线程池的工作队列中
   return future;
 }
 
@@ -112,13 +208,50 @@ inline void ThreadPool::SubmitNoWait(Function&& f, Args&&... args) {
   auto task = [runnable = std::move(f),
                task_args =
                    std::make_tuple(std::forward<Args>(args)...)]() mutable {
-    std::apply(std::move(runnable), std::move(task_args));     
+    std::apply(std::move(runnable), std::move(task_args));
   };
-  {
-    std::unique_lock<std::mutex> lock(mutex_);
-    work_queue_.emplace(new TaskContainer(std::move(task)));
+  Enqueue(Task(std::move(task)));
+}
+
+template <typename Function, typename Decayed,
+          std::enable_if_t<!std::is_same<Decayed, ThreadPool::Task>::value,
+                           bool>>
+inline ThreadPool::Task::Task(Function&& f) {
+  if constexpr (kStoredInline<Decayed>) {
+    new (&storage_) Decayed(std::forward<Function>(f));
+    ops_ = InlineOps<Decayed>();
+  } else {
+    *reinterpret_cast<Decayed**>(&storage_) =
+        new Decayed(std::forward<Function>(f));
+    ops_ = HeapOps<Decayed>();
   }
-  cv_.notify_one();
+}
+
+template <typename Function>
+inline const ThreadPool::Task::Ops* ThreadPool::Task::InlineOps() {
+  static constexpr Ops ops = {
+      [](void* storage) { (*std::launder(reinterpret_cast<Function*>(storage)))(); },
+      [](void* dest, void* src) {
+        Function* from = std::launder(reinterpret_cast<Function*>(src));
+        new (dest) Function(std::move(*from));
+        from->~Function();
+      },
+      [](void* storage) {
+        std::launder(reinterpret_cast<Function*>(storage))->~Function();
+      }};
+  return &ops;
+}
+
+template <typename Function>
+inline const ThreadPool::Task::Ops* ThreadPool::Task::HeapOps() {
+  static constexpr Ops ops = {
+      [](void* storage) { (**reinterpret_cast<Function**>(storage))(); },
+      [](void* dest, void* src) {
+        *reinterpret_cast<Function**>(dest) =
+            *reinterpret_cast<Function**>(src);
+      },
+      [](void* storage) { delete *reinterpret_cast<Function**>(storage); }};
+  return &ops;
 }
 
 }  // namespace impl
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "../time_series.h"
+
+namespace ycsbr {
+namespace impl {
+
+// Collects one worker's throughput and latency samples while a workload runs.
+// Samples are taken by time interval and are stored in a ring that is
+// allocated up front; once the ring is full, the oldest samples are
+// overwritten. Only the owning worker writes to the ring, and the samples are
+// only read once the worker has finished.
+class TimeSeriesRecorder {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  // Creates a disabled recorder.
+  TimeSeriesRecorder() : TimeSeriesRecorder(std::chrono::nanoseconds(0), 0) {}
+  TimeSeriesRecorder(std::chrono::nanoseconds interval, size_t capacity);
+
+  bool IsEnabled() const { return !ring_.empty(); }
+
+  // Starts the first sampling interval.
+  void Start(Clock::time_point now);
+
+  void Record(std::optional<std::chrono::nanoseconds> run_time,
+              size_t num_records) {
+    ++current_.num_requests;
+    current_.num_records += num_records;
+    if (run_time.has_value()) {
+      current_.latency.Record(*run_time);
+    }
+  }
+
+  // Meant to be called after each request. Reading the clock is not free, so
+  // this only checks whether the interval has ended every few requests.
+  void MaybeTakeSample() {
+    if (++requests_since_clock_check_ < kRequestsPerClockCheck) return;
+    requests_since_clock_check_ = 0;
+    const auto now = Clock::now();
+    if (now >= interval_end_) TakeSample(now);
+  }
+
+  // Ends the last (possibly partial) sampling interval.
+  void Finish(Clock::time_point now);
+
+  // Returns the retained samples in chronological order, with elapsed times
+  // measured from `origin`.
+  std::vector<TimeSeriesSample> GetSamples(Clock::time_point origin) const;
+
+ private:
+  static constexpr size_t kRequestsPerClockCheck = 16;
+
+  struct RawSample {
+    Clock::time_point end;
+    std::chrono::nanoseconds interval;
+    size_t num_requests;
+    size_t num_records;
+    LatencyHistogram latency;
+  };
+
+  void TakeSample(Clock::time_point now);
+
+  std::chrono::nanoseconds interval_;
+  std::vector<RawSample> ring_;
+  // The total number of samples taken (including overwritten ones).
+  size_t num_samples_;
+
+  RawSample current_;
+  Clock::time_point interval_start_, interval_end_;
+  size_t requests_since_clock_check_;
+};
+
+// Combines per-worker samples (with elapsed times measured from the same
+// origin) into one timeline with a sample for every `interval`. A worker's
+// sample counts towards the interval that holds its midpoint. The timeline
+// starts at the first interval with any requests (earlier samples may have
+// been overwritten).
+std::vector<TimeSeriesSample> MergeTimeSeries(
+    const std::vector<std::vector<TimeSeriesSample>>& per_worker,
+    std::chrono::nanoseconds interval);
+
+// Implementation details follow.
+
+inline TimeSeriesRecorder::TimeSeriesRecorder(
+    const std::chrono::nanoseconds interval, const size_t capacity)
+    : interval_(interval),
+      ring_(interval.count() > 0 ? capacity : 0),
+      num_samples_(0),
+      current_(),
+      interval_start_(),
+      interval_end_(),
+      requests_since_clock_check_(0) {}
+
+inline void TimeSeriesRecorder::Start(const Clock::time_point now) {
+  num_samples_ = 0;
+  current_ = RawSample();
+  interval_start_ = now;
+  interval_end_ = now + interval_;
+  requests_since_clock_check_ = 0;
+}
+
+inline void TimeSeriesRecorder::Finish(const Clock::time_point now) {
+  if (current_.num_requests == 0) return;
+  TakeSample(now);
+}
+
+inline void TimeSeriesRecorder::TakeSample(const Clock::time_point now) {
+  RawSample& slot = ring_[num_samples_ % ring_.size()];
+  slot = current_;
+  slot.end = now;
+  slot.interval = now - interval_start_;
+  ++num_samples_;
+
+  current_.num_requests = 0;
+  current_.num_records = 0;
+  current_.latency.Reset();
+  interval_start_ = now;
+  // Intervals stay aligned to the start time, even if a check was late.
+  while (interval_end_ <= now) {
+    interval_end_ += interval_;
+  }
+}
+
+inline std::vector<TimeSeriesSample> TimeSeriesRecorder::GetSamples(
+    const Clock::time_point origin) const {
+  std::vector<TimeSeriesSample> samples;
+  if (ring_.empty()) return samples;
+  const size_t num_retained = std::min(num_samples_, ring_.size());
+  samples.reserve(num_retained);
+  for (size_t i = num_samples_ - num_retained; i < num_samples_; ++i) {
+    const RawSample& raw = ring_[i % ring_.size()];
+    samples.push_back(TimeSeriesSample{raw.end - origin, raw.interval,
+                                       raw.num_requests, raw.num_records,
+                                       raw.latency});
+  }
+  return samples;
+}
+
+inline std::vector<TimeSeriesSample> MergeTimeSeries(
+    const std::vector<std::vector<TimeSeriesSample>>& per_worker,
+    const std::chrono::nanoseconds interval) {
+  std::vector<TimeSeriesSample> merged;
+  if (interval.count() <= 0) return merged;
+  std::chrono::nanoseconds last_end(0);
+  for (const auto& samples : per_worker) {
+    for (const auto& sample : samples) {
+      last_end = std::max(last_end, sample.elapsed);
+      const auto midpoint = sample.elapsed - sample.interval / 2;
+      const size_t index =
+          std::max(midpoint.count(), int64_t(0)) / interval.count();
+      while (merged.size() <= index) {
+        const int64_t next = merged.size() + 1;
+        merged.push_back(TimeSeriesSample{interval * next, interval, 0, 0,
+                                          LatencyHistogram()});
+      }
+      TimeSeriesSample& bucket = merged[index];
+      bucket.num_requests += sample.num_requests;
+      bucket.num_records += sample.num_records;
+      bucket.latency.Merge(sample.latency);
+    }
+  }
+  // The run usually ends partway through the last interval.
+  if (!merged.empty() && last_end < merged.back().elapsed) {
+    merged.back().interval -= merged.back().elapsed - last_end;
+    merged.back().elapsed = last_end;
+  }
+  const auto first = std::find_if(
+      merged.begin(), merged.end(),
+      [](const TimeSeriesSample& sample) { return sample.num_requests > 0; });
+  merged.erase(merged.begin(), first);
+  return merged;
+}
+
+}  // namespace impl
+}  // namespace ycsbr
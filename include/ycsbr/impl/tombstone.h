@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace ycsbr {
+namespace impl {
+
+// Recognizes a workload's tombstone value (see `TombstoneValue()` in
+// `workload_example.h`) in the values returned by reads and scans. The
+// tombstone is copied when the matcher is set up, so matching never calls back
+// into the producer. Most values are rejected by the size check or by the
+// first eight bytes, so a match costs at most one `memcmp()`.
+class TombstoneMatcher {
+ public:
+  TombstoneMatcher() : prefix_(0) {}
+
+  void SetTombstone(std::string_view tombstone) {
+    tombstone_.assign(tombstone.data(), tombstone.size());
+    prefix_ = LoadPrefix(tombstone_.data(), tombstone_.size());
+  }
+
+  // Returns false if the workload does not have a tombstone.
+  bool IsEnabled() const { return !tombstone_.empty(); }
+
+  bool Matches(std::string_view value) const {
+    if (value.size() != tombstone_.size() || tombstone_.empty()) return false;
+    if (LoadPrefix(value.data(), value.size()) != prefix_) return false;
+    return value.size() <= sizeof(prefix_) ||
+           std::memcmp(value.data() + sizeof(prefix_),
+                       tombstone_.data() + sizeof(prefix_),
+                       value.size() - sizeof(prefix_)) == 0;
+  }
+
+ private:
+  static uint64_t LoadPrefix(const char* data, size_t size) {
+    uint64_t prefix = 0;
+    std::memcpy(&prefix, data, size < sizeof(prefix) ? size : sizeof(prefix));
+    return prefix;
+  }
+
+  std::string tombstone_;
+  uint64_t prefix_;
+};
+
+}  // namespace impl
+}  // namespace ycsbr
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <sched.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ycsbr {
+
+// Controls how a `Session` places its worker threads onto cores.
+enum class PlacementPolicy {
+  // Fill up all the cores on one NUMA node before moving on to the next node.
+  kCompact,
+  // Assign threads to NUMA nodes in round-robin order.
+  kScatter,
+  // Place exactly one thread on each NUMA node (on the node's first core). The
+  // number of threads cannot exceed the number of NUMA nodes.
+  kOnePerNode
+};
+
+namespace impl {
+
+// The NUMA nodes (and their cores) that the calling process is allowed to run
+// on.
+class CpuTopology {
+ public:
+  struct Node {
+    size_t id;
+    // Sorted in ascending order.
+    std::vector<size_t> cpus;
+  };
+
+  // Reads the topology from sysfs. If NUMA information is not available, this
+  // returns a topology with one node that holds all usable CPUs.
+  static CpuTopology Discover();
+
+  // Creates a topology from an explicit node list (useful for testing).
+  explicit CpuTopology(std::vector<Node> nodes);
+
+  const std::vector<Node>& nodes() const { return nodes_; }
+  size_t NumNodes() const { return nodes_.size(); }
+
+  // Returns the ID of the node that owns `cpu`, or the first node's ID if the
+  // CPU is not part of this topology.
+  size_t NodeOfCpu(size_t cpu) const;
+
+  // Computes a thread-to-core map (suitable for `Session`) for `num_threads`
+  // threads. If there are more threads than cores, cores are reused.
+  std::vector<size_t> MakeCoreMap(size_t num_threads,
+                                  PlacementPolicy policy) const;
+
+ private:
+  std::vector<Node> nodes_;
+};
+
+// Parses a Linux CPU list string (e.g., "0-3,8,10-11").
+inline std::vector<size_t> ParseCpuList(const std::string& cpu_list) {
+  std::vector<size_t> cpus;
+  size_t pos = 0;
+  while (pos < cpu_list.size()) {
+    size_t end = cpu_list.find(',', pos);
+    if (end == std::string::npos) end = cpu_list.size();
+    const std::string token = cpu_list.substr(pos, end - pos);
+    pos = end + 1;
+    if (token.find_first_of("0123456789") == std::string::npos) continue;
+
+    const size_t dash = token.find('-');
+    const size_t first = std::strtoull(token.c_str(), nullptr, 10);
+    const size_t last =
+        dash == std::string::npos
+            ? first
+            : std::strtoull(token.c_str() + dash + 1, nullptr, 10);
+    if (last < first) {
+      throw std::invalid_argument("Invalid CPU list: " + cpu_list);
+    }
+    for (size_t cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+inline CpuTopology::CpuTopology(std::vector<Node> nodes)
+    : nodes_(std::move(nodes)) {
+  if (nodes_.empty()) {
+    throw std::invalid_argument("A CPU topology needs at least one node.");
+  }
+}
+
+inline CpuTopology CpuTopology::Discover() {
+  namespace fs = std::filesystem;
+
+  // Only consider CPUs that this process is allowed to run on.
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  const bool have_affinity =
+      sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+  const auto is_allowed = [&](size_t cpu) {
+    return !have_affinity || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed));
+  };
+
+  std::vector<Node> nodes;
+  const fs::path node_root("/sys/devices/system/node");
+  std::error_code err;
+  if (fs::is_directory(node_root, err)) {
+    for (const auto& entry : fs::directory_iterator(node_root, err)) {
+      const std::string name = entry.path().filename().string();
+      if (name.rfind("node", 0) != 0 || name.size() <= 4 ||
+          name.find_first_not_of("0123456789", 4) != std::string::npos) {
+        continue;
+      }
+      std::ifstream cpulist_file(entry.path() / "cpulist");
+      std::string cpulist;
+      if (!cpulist_file || !std::getline(cpulist_file, cpulist)) continue;
+
+      Node node;
+      node.id = std::strtoull(name.c_str() + 4, nullptr, 10);
+      for (const size_t cpu : ParseCpuList(cpulist)) {
+        if (is_allowed(cpu)) node.cpus.push_back(cpu);
+      }
+      // Skip memory-only nodes and nodes we cannot run on.
+      if (!node.cpus.empty()) nodes.push_back(std::move(node));
+    }
+  }
+
+  if (nodes.empty()) {
+    Node node;
+    node.id = 0;
+    const size_t num_cpus =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    for (size_t cpu = 0; cpu < num_cpus; ++cpu) {
+      if (is_allowed(cpu)) node.cpus.push_back(cpu);
+    }
+    if (node.cpus.empty()) node.cpus.push_back(0);
+    nodes.push_back(std::move(node));
+  }
+
+  std::sort(nodes.begin(), nodes.end(),
+            [](const Node& n1, const Node& n2) { return n1.id < n2.id; });
+  return CpuTopology(std::move(nodes));
+}
+
+inline size_t CpuTopology::NodeOfCpu(const size_t cpu) const {
+  for (const auto& node : nodes_) {
+    if (std::binary_search(node.cpus.begin(), node.cpus.end(), cpu)) {
+      return node.id;
+    }
+  }
+  return nodes_.front().id;
+}
+
+inline std::vector<size_t> CpuTopology::MakeCoreMap(
+    const size_t num_threads, const PlacementPolicy policy) const {
+  std::vector<size_t> core_map;
+  core_map.reserve(num_threads);
+
+  switch (policy) {
+    case PlacementPolicy::kCompact: {
+      std::vector<size_t> all_cpus;
+      for (const auto& node : nodes_) {
+        all_cpus.insert(all_cpus.end(), node.cpus.begin(), node.cpus.end());
+      }
+      for (size_t i = 0; i < num_threads; ++i) {
+        core_map.push_back(all_cpus[i % all_cpus.size()]);
+      }
+      break;
+    }
+
+    case PlacementPolicy::kScatter: {
+      for (size_t i = 0; i < num_threads; ++i) {
+        const Node& node = nodes_[i % nodes_.size()];
+        const size_t index_in_node = i / nodes_.size();
+        core_map.push_back(node.cpus[index_in_node % node.cpus.size()]);
+      }
+      break;
+    }
+
+    case PlacementPolicy::kOnePerNode: {
+      if (num_threads > nodes_.size()) {
+        throw std::invalid_argument(
+            "Cannot place " + std::to_string(num_threads) +
+            " threads one per node; there are only " +
+            std::to_string(nodes_.size()) + " NUMA node(s).");
+      }
+      for (size_t i = 0; i < num_threads; ++i) {
+        core_map.push_back(nodes_[i].cpus.front());
+      }
+      break;
+    }
+  }
+
+  return core_map;
+}
+
+}  // namespace impl
+}  // namespace ycsbr
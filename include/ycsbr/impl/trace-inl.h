@@ -4,20 +4,16 @@
 #include <fstream>
 #include <random>
 #include <stdexcept>
+#include <string_view>
 
 #include "util.h"
 
 namespace ycsbr {
 
-// We recycle values in the synthetic dataset to avoid having to allocate too
-// much memory for very large bulk loads.
-constexpr size_t kNumUniqueValues = 1024;
-
 inline Trace Trace::LoadFromFile(const std::string& file,
                                  const Options& options) {
-  if (options.value_size < 4) {
-    throw std::invalid_argument("Options::value_size must be at least 4.");
-  }
+  // Fail fast, before reading the file.
+  ValidateOptions(options);
   std::ifstream input(file, std::ios::in | std::ios::binary);
   if (!input) {
     throw std::runtime_error(
@@ -35,7 +31,15 @@ inline Trace Trace::LoadFromFile(const std::string& file,
       break;
     }
 
-    if (encoded.op == Request::Operation::kScan) {
+    if (static_cast<uint8_t>(encoded.op) >
+        static_cast<uint8_t>(Request::Operation::kTransaction)) {
+      throw std::invalid_argument(
+          "Failed to load workload from file. Unknown request operation in: " +
+          file);
+    }
+    if (encoded.op == Request::Operation::kScan ||
+        encoded.op == Request::Operation::kDeleteRange ||
+        encoded.op == Request::Operation::kTransaction) {
       input.read(reinterpret_cast<char*>(&scan_amount), sizeof(scan_amount));
     }
     if (encoded.op == Request::Operation::kInsert ||
@@ -54,6 +58,7 @@ inline Trace Trace::LoadFromFile(const std::string& file,
 
 inline Trace Trace::ProcessRawTrace(std::vector<Request> raw_trace,
                                     const Options& options) {
+  ValidateOptions(options);
   if (options.sort_requests) {
     if (options.use_v1_semantics) {
       std::sort(raw_trace.begin(), raw_trace.end(),
@@ -65,29 +70,106 @@ inline Trace Trace::ProcessRawTrace(std::vector<Request> raw_trace,
     }
   }
 
-  // Create the values and initialize them.
-  size_t total_value_size = kNumUniqueValues * options.value_size;
+  // Inserts, updates, read-modify-writes, merges, and compare-and-swaps
+  // write a value.
+  const auto writes_value = [](const Request::Operation op) {
+    return op == Request::Operation::kInsert ||
+           op == Request::Operation::kUpdate ||
+           op == Request::Operation::kReadModifyWrite ||
+           op == Request::Operation::kMerge ||
+           op == Request::Operation::kCompareAndSwap;
+  };
+  size_t num_writes = 0;
+  bool has_deletes = false;
+  bool has_transactions = false;
+  for (const auto& raw : raw_trace) {
+    if (writes_value(raw.op)) {
+      ++num_writes;
+    } else if (raw.op == Request::Operation::kDelete) {
+      has_deletes = true;
+    } else if (raw.op == Request::Operation::kTransaction) {
+      has_transactions = true;
+    }
+  }
+
+  // Choose the size of each distinct value and lay the values out
+  // contiguously. We recycle values (by default) to avoid having to allocate
+  // too much memory for very large bulk loads.
+  const size_t num_values =
+      options.num_unique_values == 0
+          ? num_writes
+          : std::min(options.num_unique_values, num_writes);
+  const size_t max_value_size =
+      std::max(options.value_size, options.max_value_size);
   std::mt19937 rng(options.rng_seed);
-  std::unique_ptr<char[]> values = impl::GetRandomBytes(total_value_size, rng);
+  std::uniform_int_distribution<size_t> value_size_dist(options.value_size,
+                                                        max_value_size);
+  std::vector<size_t> value_offsets;
+  value_offsets.reserve(num_values + 1);
+  value_offsets.push_back(0);
+  for (size_t i = 0; i < num_values; ++i) {
+    value_offsets.push_back(value_offsets.back() + value_size_dist(rng));
+  }
+
+  // Create the values and initialize them. Deletes share one tombstone, which
+  // is stored after the values.
+  const size_t tombstone_size = has_deletes ? options.value_size : 0;
+  const size_t total_value_size = value_offsets.back();
+  impl::HugePageBuffer values(total_value_size + tombstone_size,
+                              options.memory);
+  switch (options.value_content) {
+    case Options::ValueContent::kRandom:
+      impl::FillRandomBytes(values.get(), total_value_size, rng);
+      break;
+    case Options::ValueContent::kCompressible:
+      impl::FillCompressibleBytes(values.get(), total_value_size,
+                                  options.value_compression_ratio, rng);
+      break;
+    case Options::ValueContent::kZeros:
+      // The buffer is zero-initialized.
+      break;
+  }
+  // The tombstone is all 0xFF bytes, so that it differs from zero-filled
+  // values.
+  std::string_view tombstone;
+  if (has_deletes) {
+    memset(&values[total_value_size], 0xFF, tombstone_size);
+    tombstone = std::string_view(&values[total_value_size], tombstone_size);
+  }
 
-  std::vector<Request> trace;
+  impl::PageVector<Request> trace{
+      impl::PageAllocator<Request>(options.memory)};
   trace.reserve(raw_trace.size());
   size_t value_index = 0;
   for (size_t i = 0; i < raw_trace.size(); ++i) {
     const auto& raw = raw_trace[i];
-    if (raw.op == Request::Operation::kInsert ||
-        raw.op == Request::Operation::kUpdate) {
-      trace.emplace_back(
-          raw.op, raw.key, raw.scan_amount,
-          &values[(value_index % kNumUniqueValues) * options.value_size],
-          options.value_size);
+    if (writes_value(raw.op)) {
+      const size_t id = value_index % num_values;
+      trace.emplace_back(raw.op, raw.key, raw.scan_amount,
+                         &values[value_offsets[id]],
+                         value_offsets[id + 1] - value_offsets[id]);
       value_index += 1;
+    } else if (raw.op == Request::Operation::kDelete) {
+      trace.emplace_back(raw.op, raw.key, 0, tombstone.data(),
+                         tombstone.size());
     } else {
       trace.emplace_back(raw);
     }
   }
 
-  return Trace(std::move(trace), std::move(values), options.use_v1_semantics);
+  return Trace(std::move(trace), std::move(values), tombstone,
+               options.use_v1_semantics, has_transactions);
+}
+
+inline void Trace::ValidateOptions(const Options& options) {
+  if (options.value_size < 4) {
+    throw std::invalid_argument("Options::value_size must be at least 4.");
+  }
+  if (options.value_content == Options::ValueContent::kCompressible &&
+      options.value_compression_ratio < 1.0) {
+    throw std::invalid_argument(
+        "Options::value_compression_ratio must be at least 1.");
+  }
 }
 
 inline Trace::MinMaxKeys Trace::GetKeyRange() const {
@@ -114,6 +196,14 @@ inline Trace::MinMaxKeys Trace::GetKeyRange() const {
   return MinMaxKeys(min, max);
 }
 
+inline bool Trace::KeyLessThan(const Request::Key k1,
+                               const Request::Key k2) const {
+  if (use_v1_semantics_) {
+    return memcmp(&k1, &k2, sizeof(Request::Key)) < 0;
+  }
+  return k1 < k2;
+}
+
 inline BulkLoadTrace BulkLoadTrace::LoadFromFile(
     const std::string& file, const Trace::Options& options) {
   Trace workload = Trace::LoadFromFile(file, options);
@@ -127,8 +217,10 @@ inline BulkLoadTrace BulkLoadTrace::LoadFromFile(
   return BulkLoadTrace(std::move(workload));
 }
 
+template <class Allocator>
 inline BulkLoadTrace BulkLoadTrace::LoadFromKeys(
-    const std::vector<Request::Key>& keys, const Trace::Options& options) {
+    const std::vector<Request::Key, Allocator>& keys,
+    const Trace::Options& options) {
   std::vector<Request> raw_trace;
   raw_trace.reserve(keys.size());
   for (const auto& key : keys) {
@@ -150,4 +242,80 @@ inline size_t BulkLoadTrace::DatasetSizeBytes() const {
   return total_size;
 }
 
+inline std::vector<BulkLoadTrace::Partition> BulkLoadTrace::Split(
+    const size_t num_partitions, const Partitioning partitioning) const {
+  if (num_partitions == 0) {
+    throw std::invalid_argument("Must use at least 1 partition.");
+  }
+  std::vector<Partition> partitions;
+  partitions.reserve(num_partitions);
+
+  if (partitioning == Partitioning::kRoundRobin) {
+    for (size_t id = 0; id < num_partitions; ++id) {
+      const size_t num_records =
+          id < size() ? (size() - id + num_partitions - 1) / num_partitions
+                      : 0;
+      partitions.push_back(Partition(this, nullptr, id, num_partitions, id,
+                                     num_partitions, num_records));
+    }
+    return partitions;
+  }
+
+  // Key range partitions are contiguous slices of the records in key order.
+  // We only need an explicit order if the trace is not already sorted.
+  std::shared_ptr<std::vector<size_t>> order;
+  const bool is_sorted = std::is_sorted(
+      begin(), end(), [this](const Request& r1, const Request& r2) {
+        return KeyLessThan(r1.key, r2.key);
+      });
+  if (!is_sorted) {
+    order = std::make_shared<std::vector<size_t>>(size());
+    for (size_t i = 0; i < size(); ++i) {
+      (*order)[i] = i;
+    }
+    std::sort(order->begin(), order->end(), [this](size_t i1, size_t i2) {
+      return KeyLessThan((*this)[i1].key, (*this)[i2].key);
+    });
+  }
+
+  const size_t min_records_per_partition = size() / num_partitions;
+  size_t leftover_records = size() % num_partitions;
+  size_t next_offset = 0;
+  for (size_t id = 0; id < num_partitions; ++id) {
+    size_t num_records = min_records_per_partition;
+    if (leftover_records > 0) {
+      ++num_records;
+      --leftover_records;
+    }
+    partitions.push_back(Partition(this, order, id, num_partitions,
+                                   next_offset, /*stride=*/1, num_records));
+    next_offset += num_records;
+  }
+  return partitions;
+}
+
+inline const Request& BulkLoadTrace::Partition::operator[](
+    const size_t index) const {
+  const size_t position = start_ + index * stride_;
+  return (*trace_)[order_ != nullptr ? (*order_)[position] : position];
+}
+
+inline BulkLoadTrace::Partition::const_iterator
+BulkLoadTrace::Partition::begin() const {
+  return const_iterator(this, 0);
+}
+
+inline BulkLoadTrace::Partition::const_iterator BulkLoadTrace::Partition::end()
+    const {
+  return const_iterator(this, size_);
+}
+
+inline size_t BulkLoadTrace::Partition::DatasetSizeBytes() const {
+  size_t total_size = 0;
+  for (const auto& request : *this) {
+    total_size += sizeof(request.key) + request.value_size;
+  }
+  return total_size;
+}
+
 }  // namespace ycsbr
@@ -1,36 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <cstdlib>
+#include <map>
 #include <optional>
 #include <vector>
 
 #include "../benchmark_result.h"
 #include "../meter.h"
+#include "../perf_counters.h"
+#include "../request.h"
+#include "live_metrics.h"
+#include "perf_event_group.h"
+#include "time_series.h"
 
 namespace ycsbr {
 namespace impl {
 
-class ThroughputSample {
- public:
-  ThroughputSample(size_t records_processed, std::chrono::nanoseconds elapsed);
-
-  // Amount of time "captured" by this throughput sample.//++此吞吐量样本“捕获”的时间量
-  template <typename Units>
-  Units ElapsedTime() const;
-  std::chrono::nanoseconds ElapsedTimeNanos() const;
-
-  // Throughput in millions of records processed per second.//++每秒处理数百万条记录的吞吐量。
-  double MRecordsPerSecond() const;
-
-  // The number of records processed.   //++处理的记录的数量
-  size_t NumRecordsProcessed() const;
-
- private:
-  size_t records_processed_;
-  std::chrono::nanoseconds elapsed_;
-};
-
 class MetricsTracker {
  public:
   MetricsTracker(size_t num_reads_hint = 100000,
@@ -41,14 +29,35 @@ class MetricsTracker {
         writes_(num_writes_hint),
         scans_(num_scans_hint),
         deletes_(num_deletes_hint),   ////////////////////
+        // The less common operations share the deletes' hint.
+        range_deletes_(num_deletes_hint),
+        merges_(num_deletes_hint),
+        compare_and_swaps_(num_deletes_hint),
+        transactions_(num_deletes_hint),
         failed_reads_(0),
         failed_writes_(0),
         failed_scans_(0),
         failed_deletes_(0),    //////////////////
-        read_xor_(0) {}
+        failed_range_deletes_(0),
+        failed_merges_(0),
+        failed_compare_and_swaps_(0),
+        failed_transactions_(0),
+        transaction_aborts_(0),
+        transaction_retries_(0),
+        read_xor_(0),
+        num_reads_hint_(num_reads_hint),
+        num_writes_hint_(num_writes_hint),
+        num_scans_hint_(num_scans_hint),
+        num_deletes_hint_(num_deletes_hint),
+        completed_phase_requests_(0),
+        live_(nullptr),
+        perf_(nullptr),
+        operation_perf_samples_() {}
 
   void RecordRead(std::optional<std::chrono::nanoseconds> run_time,
                   size_t read_bytes, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? 1 : 0);
+    RecordLive(LiveMetrics::kRead, run_time, succeeded ? 1 : 0, succeeded);
     if (succeeded) {
       reads_.Record(run_time, read_bytes);   //!调用Meter类型记录一个read request的运行时间和字节数，记录数=1;如果插入失败则不记录
     } else {
@@ -58,6 +67,8 @@ class MetricsTracker {
 
   void RecordWrite(std::optional<std::chrono::nanoseconds> run_time,
                    size_t write_bytes, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? 1 : 0);
+    RecordLive(LiveMetrics::kWrite, run_time, succeeded ? 1 : 0, succeeded);
     if (succeeded) {
       writes_.Record(run_time, write_bytes);   //!调用Meter类型记录一个write request的运行时间和字节数，记录数=1；如果插入失败则不记录
     } else {
@@ -67,6 +78,9 @@ class MetricsTracker {
 
   void RecordScan(std::optional<std::chrono::nanoseconds> run_time,
                   size_t scanned_bytes, size_t scanned_amount, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? scanned_amount : 0);
+    RecordLive(LiveMetrics::kScan, run_time, succeeded ? scanned_amount : 0,
+               succeeded);
     if (succeeded) {
       scans_.RecordMultipleRecords(run_time, scanned_bytes, scanned_amount);     //!调用Meter类型记录一个scan request的运行时间和字节数,记录数；如果插入失败则不记录
     } else {
@@ -77,6 +91,8 @@ class MetricsTracker {
 ////////////////////
   void RecordDelete(std::optional<std::chrono::nanoseconds> run_time,
                   bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? 1 : 0);
+    RecordLive(LiveMetrics::kDelete, run_time, succeeded ? 1 : 0, succeeded);
     if (succeeded) {
       deletes_.Record(run_time, 0);    //没有写，也没有读任何字节
     }else{
@@ -84,29 +100,121 @@ class MetricsTracker {
     }
   }
 ////////////////////
+  // A range delete counts the number of records it asked to delete (see
+  // `BenchmarkResult::RangeDeletes()`).
+  void RecordDeleteRange(std::optional<std::chrono::nanoseconds> run_time,
+                         size_t range_length, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? range_length : 0);
+    RecordLive(LiveMetrics::kRangeDelete, run_time,
+               succeeded ? range_length : 0, succeeded);
+    if (succeeded) {
+      range_deletes_.RecordMultipleRecords(run_time, 0, range_length);
+    } else {
+      ++failed_range_deletes_;
+    }
+  }
+
+  void RecordMerge(std::optional<std::chrono::nanoseconds> run_time,
+                   size_t write_bytes, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? 1 : 0);
+    RecordLive(LiveMetrics::kMerge, run_time, succeeded ? 1 : 0, succeeded);
+    if (succeeded) {
+      merges_.Record(run_time, write_bytes);
+    } else {
+      ++failed_merges_;
+    }
+  }
+
+  // A compare-and-swap fails if the record changed after it was read.
+  void RecordCompareAndSwap(std::optional<std::chrono::nanoseconds> run_time,
+                            size_t write_bytes, bool succeeded) {
+    RecordTimeSeries(run_time, succeeded ? 1 : 0);
+    RecordLive(LiveMetrics::kCompareAndSwap, run_time, succeeded ? 1 : 0,
+               succeeded);
+    if (succeeded) {
+      compare_and_swaps_.Record(run_time, write_bytes);
+    } else {
+      ++failed_compare_and_swaps_;
+    }
+  }
+
+  // Records a transaction of `num_operations` requests that was attempted
+  // `num_attempts` times. `run_time` covers all the attempts; a transaction
+  // that never committed counts as failed.
+  void RecordTransaction(std::optional<std::chrono::nanoseconds> run_time,
+                         size_t num_operations, size_t bytes,
+                         size_t num_attempts, bool committed) {
+    RecordTimeSeries(run_time, committed ? num_operations : 0);
+    RecordLive(LiveMetrics::kTransaction, run_time,
+               committed ? num_operations : 0, committed);
+    if (committed) {
+      transactions_.RecordMultipleRecords(run_time, bytes, num_operations);
+    } else {
+      ++failed_transactions_;
+    }
+    transaction_aborts_ += committed ? num_attempts - 1 : num_attempts;
+    transaction_retries_ += num_attempts - 1;
+  }
+
   void SetReadXOR(uint32_t value) { read_xor_ = value; }
 
-  ThroughputSample GetSample() {   //!返回完成的一个吞吐量样本（从上次取样开始，到现在）
+  // Attributes all measurements recorded from now on to workload phase
+  // `phase_id`. The measurements recorded since the previous call (if any)
+  // are set aside as that phase's results.
+  void BeginPhase(size_t phase_id) {
     const auto now = std::chrono::steady_clock::now();
-    const size_t count = TotalRequestCount();
-    const ThroughputSample result(count - last_count_, now - last_sample_time_);
-    last_count_ = count;
-    last_sample_time_ = now;
-    return result;
+    const PerfCounters perf_now = ReadPerfCounters();
+    EndPhase(now, perf_now);
+    phase_id_ = phase_id;
+    phase_start_ = now;
+    phase_perf_start_ = perf_now;
+    if (live_ != nullptr) {
+      live_->SetPhase(phase_id);
+    }
   }
 
-  void ResetSample() {   //!将此时刻设为取样开始点
-    last_count_ = TotalRequestCount();
-    last_sample_time_ = std::chrono::steady_clock::now();
+  // Marks the end of the current workload phase, if there is one.
+  void EndPhase() {
+    EndPhase(std::chrono::steady_clock::now(), ReadPerfCounters());
+  }
+
+  // Starts collecting a time series of throughput and latency samples, taken
+  // every `interval`. At most `max_samples` of the most recent samples are
+  // kept.
+  void EnableTimeSeries(std::chrono::nanoseconds interval,
+                        size_t max_samples) {
+    time_series_ = TimeSeriesRecorder(interval, max_samples);
+  }
+  TimeSeriesRecorder& time_series() { return time_series_; }
+  const TimeSeriesRecorder& time_series() const { return time_series_; }
+
+  // Also publishes all measurements to `live`, which must outlive this
+  // tracker's use.
+  void SetLiveMetrics(LiveMetrics* live) { live_ = live; }
+
+  // Counts hardware events using `group`, which must belong to the thread that
+  // records the measurements. The counters are read when the run and each
+  // phase start and end.
+  void EnablePerfCounters(const PerfEventGroup* group) { perf_ = group; }
+  // Returns empty counts if the counters are not enabled.
+  PerfCounters ReadPerfCounters() const {
+    return perf_ != nullptr ? perf_->Read() : PerfCounters();
+  }
+  void StartPerfCounters() { perf_start_ = ReadPerfCounters(); }
+  void StopPerfCounters() { perf_total_ = ReadPerfCounters() - perf_start_; }
+  // Attributes `counters` (measured around one request) to the request's
+  // operation type.
+  void RecordOperationPerf(Request::Operation op,
+                           const PerfCounters& counters) {
+    const size_t index = OperationIndex(op);
+    operation_perf_[index] += counters;
+    ++operation_perf_samples_[index];
   }
 
   BenchmarkResult Finalize(std::chrono::nanoseconds total_run_time) {   //!构造一个benchmarkresult
-    return BenchmarkResult(
-        total_run_time, read_xor_, std::move(reads_).Freeze(),
-        std::move(writes_).Freeze(), std::move(scans_).Freeze(), 
-        std::move(deletes_).Freeze(),failed_deletes_,    ///////////////////////
-        failed_reads_,
-        failed_writes_, failed_scans_);
+    std::vector<MetricsTracker> trackers;
+    trackers.emplace_back(std::move(*this));
+    return FinalizeGroup(total_run_time, std::move(trackers));
   }
 
   static BenchmarkResult FinalizeGroup(std::chrono::nanoseconds total_run_time,
@@ -116,80 +224,299 @@ class MetricsTracker {
     std::vector<Meter> deletes;
     size_t failed_deletes_ = 0;
     /////////////////
+    std::vector<Meter> range_deletes, merges, compare_and_swaps, transactions;
     size_t failed_reads = 0, failed_writes = 0, failed_scans = 0;
+    size_t failed_range_deletes = 0, failed_merges = 0,
+           failed_compare_and_swaps = 0;
+    size_t failed_transactions = 0, transaction_aborts = 0,
+           transaction_retries = 0;
     uint32_t read_xor = 0;
     reads.reserve(trackers.size());
     writes.reserve(trackers.size());
     scans.reserve(trackers.size());
     deletes.reserve(trackers.size());     ////////////////////
+    range_deletes.reserve(trackers.size());
+    merges.reserve(trackers.size());
+    compare_and_swaps.reserve(trackers.size());
+    transactions.reserve(trackers.size());
+
+    // Per-phase measurements, keyed by phase ID.
+    struct PhaseGroup {
+      std::chrono::steady_clock::time_point start, end;
+      std::vector<Meter> reads, writes, scans, deletes;
+      std::vector<Meter> range_deletes, merges, compare_and_swaps,
+          transactions;
+      PerfCounters perf;
+    };
+    std::map<size_t, PhaseGroup> phase_groups;
+
+    PerfCounters perf;
+    std::array<BenchmarkResult::OperationPerf, LiveMetrics::kNumOperations>
+        operation_perf;
+
+    // Each tracker's own measurements (across all phases).
+    std::vector<BenchmarkResult::ThreadResult> per_thread;
+    per_thread.reserve(trackers.size());
 
     for (auto& tracker : trackers) {
+      std::vector<Meter> thread_reads, thread_writes, thread_scans,
+          thread_deletes, thread_range_deletes, thread_merges,
+          thread_compare_and_swaps, thread_transactions;
+      for (const auto& phase : tracker.completed_phases_) {
+        thread_reads.push_back(phase.reads);
+        thread_writes.push_back(phase.writes);
+        thread_scans.push_back(phase.scans);
+        thread_deletes.push_back(phase.deletes);
+        thread_range_deletes.push_back(phase.range_deletes);
+        thread_merges.push_back(phase.merges);
+        thread_compare_and_swaps.push_back(phase.compare_and_swaps);
+        thread_transactions.push_back(phase.transactions);
+      }
+      thread_reads.push_back(tracker.reads_);
+      thread_writes.push_back(tracker.writes_);
+      thread_scans.push_back(tracker.scans_);
+      thread_deletes.push_back(tracker.deletes_);
+      thread_range_deletes.push_back(tracker.range_deletes_);
+      thread_merges.push_back(tracker.merges_);
+      thread_compare_and_swaps.push_back(tracker.compare_and_swaps_);
+      thread_transactions.push_back(tracker.transactions_);
+      // The caller fills in the worker's core and run time, if known.
+      BenchmarkResult::ThreadResult thread;
+      thread.worker_id = per_thread.size();
+      thread.reads = Meter::FreezeGroup(std::move(thread_reads));
+      thread.writes = Meter::FreezeGroup(std::move(thread_writes));
+      thread.scans = Meter::FreezeGroup(std::move(thread_scans));
+      thread.deletes = Meter::FreezeGroup(std::move(thread_deletes));
+      thread.range_deletes =
+          Meter::FreezeGroup(std::move(thread_range_deletes));
+      thread.merges = Meter::FreezeGroup(std::move(thread_merges));
+      thread.compare_and_swaps =
+          Meter::FreezeGroup(std::move(thread_compare_and_swaps));
+      thread.transactions = Meter::FreezeGroup(std::move(thread_transactions));
+      thread.num_failed =
+          tracker.failed_reads_ + tracker.failed_writes_ +
+          tracker.failed_scans_ + tracker.failed_deletes_ +
+          tracker.failed_range_deletes_ + tracker.failed_merges_ +
+          tracker.failed_compare_and_swaps_ + tracker.failed_transactions_;
+      thread.perf = tracker.perf_total_;
+      per_thread.push_back(std::move(thread));
+
+      for (auto& phase : tracker.completed_phases_) {
+        auto it = phase_groups.find(phase.phase_id);
+        if (it == phase_groups.end()) {
+          PhaseGroup group;
+          group.start = phase.start;
+          group.end = phase.end;
+          it = phase_groups.emplace(phase.phase_id, std::move(group)).first;
+        }
+        PhaseGroup& group = it->second;
+        group.start = std::min(group.start, phase.start);
+        group.end = std::max(group.end, phase.end);
+        // The phase's meters also count towards the overall results.
+        group.reads.push_back(phase.reads);
+        group.writes.push_back(phase.writes);
+        group.scans.push_back(phase.scans);
+        group.deletes.push_back(phase.deletes);
+        group.range_deletes.push_back(phase.range_deletes);
+        group.merges.push_back(phase.merges);
+        group.compare_and_swaps.push_back(phase.compare_and_swaps);
+        group.transactions.push_back(phase.transactions);
+        group.perf += phase.perf;
+        reads.emplace_back(std::move(phase.reads));
+        writes.emplace_back(std::move(phase.writes));
+        scans.emplace_back(std::move(phase.scans));
+        deletes.emplace_back(std::move(phase.deletes));
+        range_deletes.emplace_back(std::move(phase.range_deletes));
+        merges.emplace_back(std::move(phase.merges));
+        compare_and_swaps.emplace_back(std::move(phase.compare_and_swaps));
+        transactions.emplace_back(std::move(phase.transactions));
+      }
       reads.emplace_back(std::move(tracker.reads_));
       writes.emplace_back(std::move(tracker.writes_));
       scans.emplace_back(std::move(tracker.scans_));
       deletes.emplace_back(std::move(tracker.deletes_));   /////////////////////
+      range_deletes.emplace_back(std::move(tracker.range_deletes_));
+      merges.emplace_back(std::move(tracker.merges_));
+      compare_and_swaps.emplace_back(std::move(tracker.compare_and_swaps_));
+      transactions.emplace_back(std::move(tracker.transactions_));
       read_xor ^= tracker.read_xor_;
       failed_reads += tracker.failed_reads_;
       failed_writes += tracker.failed_writes_;
       failed_scans += tracker.failed_scans_;
       failed_deletes_ += tracker.failed_deletes_;  ////////////////////////////
+      failed_range_deletes += tracker.failed_range_deletes_;
+      failed_merges += tracker.failed_merges_;
+      failed_compare_and_swaps += tracker.failed_compare_and_swaps_;
+      failed_transactions += tracker.failed_transactions_;
+      transaction_aborts += tracker.transaction_aborts_;
+      transaction_retries += tracker.transaction_retries_;
+      perf += tracker.perf_total_;
+      for (size_t i = 0; i < LiveMetrics::kNumOperations; ++i) {
+        operation_perf[i].counters += tracker.operation_perf_[i];
+        operation_perf[i].num_sampled_requests +=
+            tracker.operation_perf_samples_[i];
+      }
     }
 
-    return BenchmarkResult(total_run_time, read_xor,
+    BenchmarkResult result(total_run_time, read_xor,
                            Meter::FreezeGroup(std::move(reads)),
                            Meter::FreezeGroup(std::move(writes)),
                            Meter::FreezeGroup(std::move(scans)),
                            Meter::FreezeGroup(std::move(deletes)),failed_deletes_,   ////////////////////////
                            failed_reads,
-                           failed_writes, failed_scans);
+                           failed_writes, failed_scans,
+                           Meter::FreezeGroup(std::move(range_deletes)),
+                           Meter::FreezeGroup(std::move(merges)),
+                           Meter::FreezeGroup(std::move(compare_and_swaps)),
+                           failed_range_deletes, failed_merges,
+                           failed_compare_and_swaps,
+                           Meter::FreezeGroup(std::move(transactions)),
+                           failed_transactions, transaction_aborts,
+                           transaction_retries);
+    for (auto& entry : phase_groups) {
+      PhaseGroup& group = entry.second;
+      result.per_phase_.push_back(BenchmarkResult::PhaseResult{
+          entry.first, group.end - group.start,
+          Meter::FreezeGroup(std::move(group.reads)),
+          Meter::FreezeGroup(std::move(group.writes)),
+          Meter::FreezeGroup(std::move(group.scans)),
+          Meter::FreezeGroup(std::move(group.deletes)),
+          Meter::FreezeGroup(std::move(group.range_deletes)),
+          Meter::FreezeGroup(std::move(group.merges)),
+          Meter::FreezeGroup(std::move(group.compare_and_swaps)),
+          Meter::FreezeGroup(std::move(group.transactions)), group.perf});
+    }
+    result.per_thread_ = std::move(per_thread);
+    result.perf_ = perf;
+    result.operation_perf_ = BenchmarkResult::PerfByOperation{
+        operation_perf[LiveMetrics::kRead], operation_perf[LiveMetrics::kWrite],
+        operation_perf[LiveMetrics::kScan],
+        operation_perf[LiveMetrics::kDelete],
+        operation_perf[LiveMetrics::kRangeDelete],
+        operation_perf[LiveMetrics::kMerge],
+        operation_perf[LiveMetrics::kCompareAndSwap],
+        operation_perf[LiveMetrics::kTransaction]};
+    return result;
   }
 
- private:
+  // The number of requests processed so far (successful or not).
   size_t TotalRequestCount() const {   //!返回之前的所有处理过的request数（不管失败还是成功）
-    return reads_.RequestCount() + writes_.RequestCount() +
+    return completed_phase_requests_ + reads_.RequestCount() + writes_.RequestCount() +
            scans_.RequestCount() + 
            deletes_.RequestCount() + failed_deletes_ +   //////////////////
+           range_deletes_.RequestCount() + merges_.RequestCount() +
+           compare_and_swaps_.RequestCount() + failed_range_deletes_ +
+           failed_merges_ + failed_compare_and_swaps_ +
+           transactions_.RequestCount() + failed_transactions_ +
            failed_reads_ + failed_writes_ +
            failed_scans_;
   }
 
+ private:
+  struct PhaseMeters {
+    size_t phase_id;
+    std::chrono::steady_clock::time_point start, end;
+    Meter reads, writes, scans, deletes;
+    Meter range_deletes, merges, compare_and_swaps, transactions;
+    PerfCounters perf;
+  };
+
+  static size_t OperationIndex(Request::Operation op) {
+    switch (op) {
+      case Request::Operation::kInsert:
+      case Request::Operation::kUpdate:
+      case Request::Operation::kReadModifyWrite:
+        return LiveMetrics::kWrite;
+      case Request::Operation::kScan:
+        return LiveMetrics::kScan;
+      case Request::Operation::kDelete:
+        return LiveMetrics::kDelete;
+      case Request::Operation::kDeleteRange:
+        return LiveMetrics::kRangeDelete;
+      case Request::Operation::kMerge:
+        return LiveMetrics::kMerge;
+      case Request::Operation::kCompareAndSwap:
+        return LiveMetrics::kCompareAndSwap;
+      case Request::Operation::kTransaction:
+        return LiveMetrics::kTransaction;
+      default:
+        return LiveMetrics::kRead;
+    }
+  }
+
+  void RecordTimeSeries(std::optional<std::chrono::nanoseconds> run_time,
+                        size_t num_records) {
+    if (time_series_.IsEnabled()) {
+      time_series_.Record(run_time, num_records);
+    }
+  }
+
+  void RecordLive(LiveMetrics::Operation op,
+                  std::optional<std::chrono::nanoseconds> run_time,
+                  size_t num_records, bool succeeded) {
+    if (live_ != nullptr) {
+      live_->Record(op, run_time, num_records, succeeded);
+    }
+  }
+
+  void EndPhase(const std::chrono::steady_clock::time_point now,
+                const PerfCounters& perf_now) {
+    if (!phase_id_.has_value()) return;
+    completed_phase_requests_ += reads_.RequestCount() +
+                                 writes_.RequestCount() +
+                                 scans_.RequestCount() +
+                                 deletes_.RequestCount() +
+                                 range_deletes_.RequestCount() +
+                                 merges_.RequestCount() +
+                                 compare_and_swaps_.RequestCount() +
+                                 transactions_.RequestCount();
+    completed_phases_.push_back(PhaseMeters{
+        *phase_id_, phase_start_, now, std::move(reads_), std::move(writes_),
+        std::move(scans_), std::move(deletes_), std::move(range_deletes_),
+        std::move(merges_), std::move(compare_and_swaps_),
+        std::move(transactions_), perf_now - phase_perf_start_});
+    reads_ = Meter(num_reads_hint_);
+    writes_ = Meter(num_writes_hint_);
+    scans_ = Meter(num_scans_hint_);
+    deletes_ = Meter(num_deletes_hint_);
+    range_deletes_ = Meter(num_deletes_hint_);
+    merges_ = Meter(num_deletes_hint_);
+    compare_and_swaps_ = Meter(num_deletes_hint_);
+    transactions_ = Meter(num_deletes_hint_);
+    phase_id_.reset();
+  }
+
   Meter reads_, writes_, scans_;
   Meter deletes_;   ///////////////
+  Meter range_deletes_, merges_, compare_and_swaps_;
+  Meter transactions_;
   size_t failed_reads_, failed_writes_, failed_scans_;
   size_t failed_deletes_;   ////////////////
+  size_t failed_range_deletes_, failed_merges_, failed_compare_and_swaps_;
+  size_t failed_transactions_;
+  // A retried transaction aborted at least once; the aborts also include the
+  // last attempt of each failed transaction.
+  size_t transaction_aborts_, transaction_retries_;
   uint32_t read_xor_;
 
-  size_t last_count_;
-  std::chrono::steady_clock::time_point last_sample_time_;   //?std::chrono::steady_clock::time_point 是C++标准库中用于表示时间点（时间戳）的类型
-};
+  size_t num_reads_hint_, num_writes_hint_, num_scans_hint_, num_deletes_hint_;
 
-// Additional implementation details follow.
-
-inline ThroughputSample::ThroughputSample(size_t records_processed,
-                                          std::chrono::nanoseconds elapsed)
-    : records_processed_(records_processed), elapsed_(elapsed) {}
-
-inline double ThroughputSample::MRecordsPerSecond() const {
-  return records_processed_ /
-         // Converts the elapsed time into microseconds, represented using a
-         // double (to account for fractional microseconds).//++将经过的时间转换为微秒，使用双精度数表示（以考虑小数微秒）
-         std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
-             elapsed_)
-             .count();
-}
-
-template <typename Units>
-inline Units ThroughputSample::ElapsedTime() const {   //将elapsed_转换为Units类型
-  return std::chrono::duration_cast<Units>(elapsed_);
-}
-
-inline std::chrono::nanoseconds ThroughputSample::ElapsedTimeNanos() const {   //将elapsed_转换为std::chrono::nanoseconds类型
-  return ElapsedTime<std::chrono::nanoseconds>();
-}
-
-inline size_t ThroughputSample::NumRecordsProcessed() const {    
-  return records_processed_;
-}
+  // Measurements of the workload phases that have ended. The meters above
+  // hold the current phase's measurements.
+  std::vector<PhaseMeters> completed_phases_;
+  size_t completed_phase_requests_;
+  std::optional<size_t> phase_id_;
+  std::chrono::steady_clock::time_point phase_start_;
+
+  TimeSeriesRecorder time_series_;
+  LiveMetrics* live_;
+
+  // Hardware event counts (only collected if `perf_` is not null).
+  const PerfEventGroup* perf_;
+  PerfCounters perf_start_, perf_total_, phase_perf_start_;
+  std::array<PerfCounters, LiveMetrics::kNumOperations> operation_perf_;
+  std::array<size_t, LiveMetrics::kNumOperations> operation_perf_samples_;
+};
 
 }  // namespace impl
 }  // namespace ycsbr
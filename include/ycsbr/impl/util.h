@@ -1,7 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 namespace ycsbr {
@@ -20,5 +23,45 @@ inline std::unique_ptr<char[]> GetRandomBytes(const size_t size,
   return values;
 }
 
+// Fills `dest` with `size` random bytes.
+template <class RNG>
+inline void FillRandomBytes(char* dest, const size_t size, RNG& prng) {
+  for (size_t i = 0; i < size; i += sizeof(uint32_t)) {
+    const uint32_t word = prng();
+    memcpy(&dest[i], &word, std::min(sizeof(word), size - i));
+  }
+}
+
+// Fills `dest` with `size` bytes that compress by about `compression_ratio`
+// (which must be at least 1). The bytes are generated in fragments; each
+// fragment repeats a random chunk whose size is inversely proportional to the
+// ratio.
+template <class RNG>
+inline void FillCompressibleBytes(char* dest, const size_t size,
+                                  const double compression_ratio, RNG& prng) {
+  constexpr size_t kFragmentSizeBytes = 128;
+  assert(compression_ratio >= 1.0);
+  const size_t random_bytes = std::clamp<size_t>(
+      std::lround(kFragmentSizeBytes / compression_ratio), sizeof(uint32_t),
+      kFragmentSizeBytes);
+  char chunk[kFragmentSizeBytes];
+  for (size_t start = 0; start < size; start += kFragmentSizeBytes) {
+    FillRandomBytes(chunk, random_bytes, prng);
+    const size_t end = std::min(start + kFragmentSizeBytes, size);
+    for (size_t i = start; i < end; ++i) {
+      dest[i] = chunk[(i - start) % random_bytes];
+    }
+  }
+}
+
+// A hint to the CPU that the calling thread is busy-waiting.
+inline void CpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+  __builtin_ia32_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
 }  // namespace impl
 }  // namespace ycsbr
@@ -0,0 +1,292 @@
+// Implementation of declarations in ycsbr/workload_snapshot.h. Do not include
+// this header!
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include "workload_traits.h"
+
+namespace ycsbr {
+
+class WorkloadSnapshot::Mapping {
+ public:
+  Mapping(const char* data, size_t size) : data_(data), size_(size) {}
+  ~Mapping() {
+    munmap(const_cast<char*>(data_), size_);
+  }
+  Mapping(const Mapping&) = delete;
+  Mapping& operator=(const Mapping&) = delete;
+
+  const char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  const char* data_;
+  size_t size_;
+};
+
+namespace impl {
+
+// Pads `out` with zero bytes to an 8 byte boundary and returns the new offset.
+inline uint64_t AlignSnapshotStream(std::ostream& out) {
+  static const char kZeros[8] = {};
+  const uint64_t offset = out.tellp();
+  const uint64_t padding = (8 - offset % 8) % 8;
+  out.write(kZeros, padding);
+  return offset + padding;
+}
+
+}  // namespace impl
+
+template <class Workload>
+inline void WorkloadSnapshot::Export(const Workload& workload,
+                                     const size_t num_producers,
+                                     const std::filesystem::path& file) {
+  using WorkloadProducer = typename Workload::Producer;
+  if (num_producers == 0) {
+    throw std::invalid_argument("Must use at least 1 producer.");
+  }
+  // The producers are drained one after another, so the first one would use up
+  // a duration phase's (shared) deadline.
+  if constexpr (impl::HasDurationPhases<Workload>::value) {
+    if (workload.HasDurationPhases()) {
+      throw std::invalid_argument(
+          "Cannot export a workload with phases bounded by a duration.");
+    }
+  }
+  std::vector<WorkloadProducer> producers =
+      workload.GetProducers(num_producers);
+  for (auto& producer : producers) {
+    producer.Prepare();
+  }
+  if constexpr (impl::HasFinishPrepare<WorkloadProducer>::value) {
+    for (auto& producer : producers) {
+      producer.FinishPrepare();
+    }
+  }
+
+  std::ofstream out(file, std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("Failed to create snapshot file: " +
+                             file.string());
+  }
+  out.exceptions(std::ofstream::badbit | std::ofstream::failbit);
+  Header header;
+  memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.num_producers = producers.size();
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  std::vector<StreamInfo> streams(producers.size());
+  out.write(reinterpret_cast<const char*>(streams.data()),
+            streams.size() * sizeof(StreamInfo));
+
+  // The values are staged in a separate file (instead of in memory) because a
+  // stream's values can be much larger than its records.
+  std::filesystem::path values_file = file;
+  values_file += ".values";
+  for (size_t id = 0; id < producers.size(); ++id) {
+    WorkloadProducer& producer = producers[id];
+    StreamInfo& stream = streams[id];
+    std::vector<PhaseRun> phases;
+    std::fstream values(values_file, std::ios::in | std::ios::out |
+                                         std::ios::binary | std::ios::trunc);
+    if (!values) {
+      throw std::runtime_error("Failed to create snapshot file: " +
+                               values_file.string());
+    }
+    values.exceptions(std::fstream::badbit | std::fstream::failbit);
+
+    stream.records_offset = impl::AlignSnapshotStream(out);
+    uint64_t values_size = 0;
+    while (producer.HasNext()) {
+      if constexpr (impl::HasCurrentPhase<WorkloadProducer>::value) {
+        const uint64_t phase_id = producer.CurrentPhase();
+        if (phases.empty() || phases.back().phase_id != phase_id) {
+          phases.push_back(PhaseRun{phase_id, stream.num_records});
+        }
+      }
+      const Request request = producer.Next();
+      Record record;
+      memset(&record, 0, sizeof(record));
+      record.key = request.key;
+      record.scan_amount = request.scan_amount;
+      record.op = request.op;
+      if (request.value != nullptr && request.value_size > 0) {
+        if (request.value_size > std::numeric_limits<uint32_t>::max()) {
+          throw std::invalid_argument(
+              "Snapshots do not support values larger than 4 GiB.");
+        }
+        record.value_offset = values_size;
+        record.value_size = request.value_size;
+        values.write(request.value, request.value_size);
+        values_size += request.value_size;
+      }
+      out.write(reinterpret_cast<const char*>(&record), sizeof(record));
+      ++stream.num_records;
+      if (!phases.empty()) phases.back().end_index = stream.num_records;
+    }
+
+    stream.values_offset = impl::AlignSnapshotStream(out);
+    stream.values_size = values_size;
+    if (values_size > 0) {
+      values.seekg(0);
+      out << values.rdbuf();
+    }
+    values.close();
+
+    stream.phases_offset = impl::AlignSnapshotStream(out);
+    stream.num_phases = phases.size();
+    out.write(reinterpret_cast<const char*>(phases.data()),
+              phases.size() * sizeof(PhaseRun));
+
+    stream.tombstone_offset = out.tellp();
+    if constexpr (impl::HasTombstoneValue<WorkloadProducer>::value) {
+      const std::string_view tombstone = producer.TombstoneValue();
+      stream.tombstone_size = tombstone.size();
+      out.write(tombstone.data(), tombstone.size());
+    }
+  }
+  std::filesystem::remove(values_file);
+
+  out.seekp(sizeof(Header));
+  out.write(reinterpret_cast<const char*>(streams.data()),
+            streams.size() * sizeof(StreamInfo));
+}
+
+inline WorkloadSnapshot WorkloadSnapshot::Open(
+    const std::filesystem::path& file) {
+  const int fd = open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open snapshot file: " + file.string());
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("Invalid snapshot file: " + file.string());
+  }
+  const size_t size = file_stat.st_size;
+  void* const data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Failed to map snapshot file: " + file.string());
+  }
+  WorkloadSnapshot snapshot(
+      std::make_shared<const Mapping>(static_cast<const char*>(data), size));
+
+  // Validate the layout so that replaying the snapshot never reads out of
+  // bounds.
+  const auto fits = [size](uint64_t offset, uint64_t length) {
+    return offset <= size && length <= size - offset;
+  };
+  const auto invalid = [&file]() {
+    return std::runtime_error("Invalid snapshot file: " + file.string());
+  };
+  if (size < sizeof(Header)) throw invalid();
+  const Header& header = snapshot.header();
+  if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion ||
+      !fits(sizeof(Header),
+            static_cast<uint64_t>(header.num_producers) * sizeof(StreamInfo))) {
+    throw invalid();
+  }
+  for (size_t id = 0; id < header.num_producers; ++id) {
+    const StreamInfo& stream = snapshot.stream(id);
+    if (stream.records_offset % alignof(Record) != 0 ||
+        stream.phases_offset % alignof(PhaseRun) != 0 ||
+        stream.num_records > size / sizeof(Record) ||
+        stream.num_phases > size / sizeof(PhaseRun) ||
+        !fits(stream.records_offset, stream.num_records * sizeof(Record)) ||
+        !fits(stream.phases_offset, stream.num_phases * sizeof(PhaseRun)) ||
+        !fits(stream.values_offset, stream.values_size) ||
+        !fits(stream.tombstone_offset, stream.tombstone_size)) {
+      throw invalid();
+    }
+  }
+  madvise(data, size, MADV_SEQUENTIAL);
+  return snapshot;
+}
+
+inline size_t WorkloadSnapshot::NumProducers() const {
+  return header().num_producers;
+}
+
+inline std::vector<WorkloadSnapshot::Producer> WorkloadSnapshot::GetProducers(
+    const size_t num_producers) const {
+  if (num_producers != NumProducers()) {
+    throw std::invalid_argument(
+        "This snapshot was recorded with " + std::to_string(NumProducers()) +
+        " producers (requested " + std::to_string(num_producers) + ").");
+  }
+  std::vector<Producer> producers;
+  producers.reserve(num_producers);
+  for (size_t id = 0; id < num_producers; ++id) {
+    producers.push_back(Producer(mapping_, stream(id)));
+  }
+  return producers;
+}
+
+inline const WorkloadSnapshot::Header& WorkloadSnapshot::header() const {
+  return *reinterpret_cast<const Header*>(mapping_->data());
+}
+
+inline const WorkloadSnapshot::StreamInfo& WorkloadSnapshot::stream(
+    const size_t producer_id) const {
+  return reinterpret_cast<const StreamInfo*>(mapping_->data() +
+                                             sizeof(Header))[producer_id];
+}
+
+inline WorkloadSnapshot::Producer::Producer(
+    std::shared_ptr<const Mapping> mapping, const StreamInfo& stream)
+    : mapping_(std::move(mapping)),
+      records_(reinterpret_cast<const Record*>(mapping_->data() +
+                                               stream.records_offset)),
+      num_records_(stream.num_records),
+      next_record_(0),
+      phases_(reinterpret_cast<const PhaseRun*>(mapping_->data() +
+                                                stream.phases_offset)),
+      num_phases_(stream.num_phases),
+      current_phase_index_(0),
+      values_(mapping_->data() + stream.values_offset),
+      tombstone_(mapping_->data() + stream.tombstone_offset,
+                 stream.tombstone_size) {}
+
+inline void WorkloadSnapshot::Producer::Prepare() {
+  if (num_records_ == 0) return;
+  // Start reading this producer's records in the background. The pages live
+  // in the page cache, so this does not add to the process' memory usage.
+  const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+  const uintptr_t start = reinterpret_cast<uintptr_t>(records_);
+  const uintptr_t aligned_start = start - start % page_size;
+  madvise(reinterpret_cast<void*>(aligned_start),
+          start - aligned_start + num_records_ * sizeof(Record),
+          MADV_WILLNEED);
+}
+
+inline Request WorkloadSnapshot::Producer::Next() {
+  const Record& record = records_[next_record_++];
+  if (current_phase_index_ + 1 < num_phases_ &&
+      next_record_ == phases_[current_phase_index_].end_index) {
+    ++current_phase_index_;
+  }
+  return Request(record.op, record.key, record.scan_amount,
+                 record.value_size > 0 ? values_ + record.value_offset
+                                       : nullptr,
+                 record.value_size);
+}
+
+inline size_t WorkloadSnapshot::Producer::CurrentPhase() const {
+  return num_phases_ == 0 ? 0 : phases_[current_phase_index_].phase_id;
+}
+
+inline std::string_view WorkloadSnapshot::Producer::TombstoneValue() const {
+  return tombstone_;
+}
+
+}  // namespace ycsbr
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+namespace ycsbr {
+namespace impl {
+
+// Compile-time detection of the optional methods a workload (or its
+// `Producer`) may implement. See `workload_example.h` for their expected
+// signatures.
+
+template <typename Workload, typename = void>
+struct HasDurationPhases : std::false_type {};
+
+template <typename Workload>
+struct HasDurationPhases<
+    Workload,
+    std::void_t<decltype(std::declval<const Workload&>().HasDurationPhases())>>
+    : std::true_type {};
+
+template <typename Producer, typename = void>
+struct HasCurrentPhase : std::false_type {};
+
+template <typename Producer>
+struct HasCurrentPhase<
+    Producer, std::void_t<decltype(std::declval<const Producer&>().CurrentPhase())>>
+    : std::true_type {};
+
+template <typename Producer, typename = void>
+struct HasFinishPrepare : std::false_type {};
+
+template <typename Producer>
+struct HasFinishPrepare<
+    Producer, std::void_t<decltype(std::declval<Producer&>().FinishPrepare())>>
+    : std::true_type {};
+
+template <typename Producer, typename = void>
+struct HasTombstoneValue : std::false_type {};
+
+template <typename Producer>
+struct HasTombstoneValue<
+    Producer,
+    std::void_t<decltype(std::declval<const Producer&>().TombstoneValue())>>
+    : std::true_type {};
+
+}  // namespace impl
+}  // namespace ycsbr
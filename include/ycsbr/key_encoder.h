@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "request.h"
+
+namespace ycsbr {
+
+class KeyBatch;
+
+// Deterministically turns the integer keys that workloads generate into byte
+// string keys, for databases that take `std::string_view` keys (see
+// `db_example.h`). Distinct integer keys always map to distinct string keys.
+//
+// - `KeyEncoder::BigEndian()` keys are a fixed prefix, the key's bytes in
+//   big-endian order, and padding up to a fixed size. Byte-wise comparison
+//   preserves the order of the integer keys, so range scans still make sense.
+// - `KeyEncoder::Hashed()` keys are a fixed prefix, the big-endian bytes of a
+//   bijective hash of the key, and padding up to a size in [min, max] chosen
+//   by the hash. The keys do not preserve the integer key order.
+class KeyEncoder {
+ public:
+  enum class Format { kBigEndian, kHashed };
+
+  // The identity encoding: the key's eight bytes in big-endian order.
+  KeyEncoder() : KeyEncoder(Format::kBigEndian, std::string(), 8, 8) {}
+
+  // Throws `std::invalid_argument` if `key_size` is too small to hold the
+  // prefix and the key.
+  static KeyEncoder BigEndian(std::string prefix, size_t key_size);
+  static KeyEncoder Hashed(std::string prefix, size_t min_key_size,
+                           size_t max_key_size);
+
+  Format format() const { return format_; }
+  const std::string& prefix() const { return prefix_; }
+  size_t MinKeySize() const { return min_key_size_; }
+  size_t MaxKeySize() const { return max_key_size_; }
+
+  // Writes the encoded `key` to `out`, which must have room for
+  // `MaxKeySize()` bytes. Returns the encoded key's size.
+  size_t Encode(Request::Key key, char* out) const;
+  std::string EncodeToString(Request::Key key) const;
+
+  // Encodes `keys` into `batch`, replacing its contents. The encoded keys are
+  // stored back to back in one buffer.
+  void EncodeBatch(const Request::Key* keys, size_t num_keys,
+                   KeyBatch* batch) const;
+
+ private:
+  KeyEncoder(Format format, std::string prefix, size_t min_key_size,
+             size_t max_key_size);
+
+  // A bijective 64-bit mixing function (the SplitMix64 finalizer).
+  static uint64_t Mix(uint64_t x);
+
+  Format format_;
+  std::string prefix_;
+  size_t min_key_size_;
+  size_t max_key_size_;
+};
+
+// Encoded keys stored contiguously in a single arena buffer. Reusing a batch
+// reuses its buffers, so re-encoding does not allocate once the batch is large
+// enough.
+class KeyBatch {
+ public:
+  size_t size() const { return offsets_.empty() ? 0 : offsets_.size() - 1; }
+  bool empty() const { return size() == 0; }
+  std::string_view operator[](size_t index) const {
+    return std::string_view(arena_.data() + offsets_[index],
+                            offsets_[index + 1] - offsets_[index]);
+  }
+
+ private:
+  friend class KeyEncoder;
+  std::vector<char> arena_;
+  std::vector<size_t> offsets_;
+};
+
+// Implementation details follow.
+
+inline KeyEncoder::KeyEncoder(Format format, std::string prefix,
+                              size_t min_key_size, size_t max_key_size)
+    : format_(format),
+      prefix_(std::move(prefix)),
+      min_key_size_(min_key_size),
+      max_key_size_(max_key_size) {
+  if (min_key_size_ < prefix_.size() + sizeof(Request::Key)) {
+    throw std::invalid_argument(
+        "Encoded keys must have room for the prefix and the 8-byte key.");
+  }
+  if (max_key_size_ < min_key_size_) {
+    throw std::invalid_argument(
+        "The maximum key size must not be less than the minimum key size.");
+  }
+}
+
+inline KeyEncoder KeyEncoder::BigEndian(std::string prefix,
+                                        const size_t key_size) {
+  return KeyEncoder(Format::kBigEndian, std::move(prefix), key_size, key_size);
+}
+
+inline KeyEncoder KeyEncoder::Hashed(std::string prefix,
+                                     const size_t min_key_size,
+                                     const size_t max_key_size) {
+  return KeyEncoder(Format::kHashed, std::move(prefix), min_key_size,
+                    max_key_size);
+}
+
+inline uint64_t KeyEncoder::Mix(uint64_t x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+inline size_t KeyEncoder::Encode(const Request::Key key, char* out) const {
+  std::memcpy(out, prefix_.data(), prefix_.size());
+  char* const id_out = out + prefix_.size();
+  const uint64_t id = format_ == Format::kHashed ? Mix(key) : key;
+  for (size_t i = 0; i < sizeof(id); ++i) {
+    id_out[i] = static_cast<char>(id >> (8 * (sizeof(id) - 1 - i)));
+  }
+  size_t key_size = min_key_size_;
+  if (max_key_size_ > min_key_size_) {
+    key_size += Mix(id) % (max_key_size_ - min_key_size_ + 1);
+  }
+  const size_t id_end = prefix_.size() + sizeof(id);
+  std::memset(out + id_end, '0', key_size - id_end);
+  return key_size;
+}
+
+inline std::string KeyEncoder::EncodeToString(const Request::Key key) const {
+  std::string encoded(max_key_size_, '\0');
+  encoded.resize(Encode(key, encoded.data()));
+  return encoded;
+}
+
+inline void KeyEncoder::EncodeBatch(const Request::Key* keys,
+                                    const size_t num_keys,
+                                    KeyBatch* batch) const {
+  batch->arena_.resize(num_keys * max_key_size_);
+  batch->offsets_.resize(num_keys + 1);
+  size_t offset = 0;
+  batch->offsets_[0] = 0;
+  for (size_t i = 0; i < num_keys; ++i) {
+    offset += Encode(keys[i], batch->arena_.data() + offset);
+    batch->offsets_[i + 1] = offset;
+  }
+}
+
+}  // namespace ycsbr
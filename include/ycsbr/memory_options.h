@@ -0,0 +1,37 @@
+#pragma once
+
+namespace ycsbr {
+
+// Controls how YCSBR allocates its large arrays (e.g., a trace's requests and
+// values, a `BufferedWorkload`'s recorded requests and the keys of a
+// `gen::PhasedWorkload`). By default, all arrays come from the heap; the options
+// below only apply to arrays that are at least as large as a huge page.
+struct MemoryOptions {
+  // If true, large arrays are mapped at huge page aligned addresses and the
+  // kernel is asked to back them with transparent huge pages. This reduces TLB
+  // misses when the arrays are accessed randomly, but rounds each array up to a
+  // multiple of the huge page size.
+  bool use_huge_pages = false;
+
+  // If true, large arrays are mapped from the kernel's reserved huge page pool
+  // (hugetlbfs, via `MAP_HUGETLB`), so they are guaranteed to use 2 MiB pages.
+  // The pool must be reserved ahead of time (e.g., via
+  // `/proc/sys/vm/nr_hugepages`). If it does not have enough free pages, the
+  // arrays fall back to transparent huge pages (as in `use_huge_pages`).
+  bool use_hugetlbfs = false;
+
+  // If non-negative, large arrays are bound to this NUMA node. Binding is best
+  // effort: it is skipped if the kernel does not allow it.
+  int numa_node = -1;
+
+  bool operator==(const MemoryOptions& other) const {
+    return use_huge_pages == other.use_huge_pages &&
+           use_hugetlbfs == other.use_hugetlbfs &&
+           numa_node == other.numa_node;
+  }
+  bool operator!=(const MemoryOptions& other) const {
+    return !(*this == other);
+  }
+};
+
+}  // namespace ycsbr
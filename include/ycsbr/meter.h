@@ -114,10 +114,13 @@ class FrozenMeter {
         record_count_(record_count),
         latencies_(std::move(latencies)) {}
 
-  const size_t bytes_;
-  const size_t request_count_;
-  const size_t record_count_;
-  const std::vector<std::chrono::nanoseconds> latencies_;
+  // Not `const`, so that results can be assembled by member assignment. The
+  // meter is still immutable once frozen: nothing outside this class can
+  // modify these fields.
+  size_t bytes_;
+  size_t request_count_;
+  size_t record_count_;
+  std::vector<std::chrono::nanoseconds> latencies_;
 };
 
 inline FrozenMeter Meter::Freeze() && {   //! FrozenMeter的构造函数， && 表示这是一个右值引用版本的函数，它表示它只能被右值对象调用
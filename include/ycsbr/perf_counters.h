@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace ycsbr {
+
+// Hardware event counts collected with `perf_event_open` (see
+// `RunOptions::perf_counters`). Events that the machine (or the kernel's
+// `perf_event_paranoid` setting) does not allow are not measured.
+struct PerfCounters {
+  enum Event : size_t {
+    kCycles = 0,
+    kInstructions,
+    kLLCMisses,
+    kDTLBMisses,
+    kBranchMisses,
+    kNumEvents
+  };
+  static const char* EventName(Event event);
+
+  std::array<uint64_t, kNumEvents> counts = {};
+  std::array<bool, kNumEvents> measured = {};
+
+  bool Measured(Event event) const { return measured[event]; }
+  bool AnyMeasured() const;
+
+  // Returns 0 if cycles or instructions were not measured.
+  double InstructionsPerCycle() const;
+  // Returns 0 if the event was not measured or if there were no requests.
+  double PerRequest(Event event, size_t num_requests) const;
+
+  PerfCounters& operator+=(const PerfCounters& other);
+};
+
+// The difference between two readings of the same counters.
+PerfCounters operator-(const PerfCounters& end, const PerfCounters& start);
+
+// Implementation details follow.
+
+inline const char* PerfCounters::EventName(const Event event) {
+  switch (event) {
+    case kCycles:
+      return "cycles";
+    case kInstructions:
+      return "instructions";
+    case kLLCMisses:
+      return "llc_misses";
+    case kDTLBMisses:
+      return "dtlb_misses";
+    case kBranchMisses:
+      return "branch_misses";
+    default:
+      return "unknown";
+  }
+}
+
+inline bool PerfCounters::AnyMeasured() const {
+  for (const bool is_measured : measured) {
+    if (is_measured) return true;
+  }
+  return false;
+}
+
+inline double PerfCounters::InstructionsPerCycle() const {
+  if (!measured[kCycles] || !measured[kInstructions] || counts[kCycles] == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(counts[kInstructions]) / counts[kCycles];
+}
+
+inline double PerfCounters::PerRequest(const Event event,
+                                       const size_t num_requests) const {
+  if (!measured[event] || num_requests == 0) return 0.0;
+  return static_cast<double>(counts[event]) / num_requests;
+}
+
+inline PerfCounters& PerfCounters::operator+=(const PerfCounters& other) {
+  for (size_t i = 0; i < kNumEvents; ++i) {
+    counts[i] += other.counts[i];
+    measured[i] = measured[i] || other.measured[i];
+  }
+  return *this;
+}
+
+inline PerfCounters operator-(const PerfCounters& end,
+                              const PerfCounters& start) {
+  PerfCounters diff;
+  for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+    diff.measured[i] = end.measured[i] && start.measured[i];
+    // Scaled counts (see `impl::PerfEventGroup`) are estimates, so they are
+    // not guaranteed to be monotonic.
+    diff.counts[i] =
+        end.counts[i] > start.counts[i] ? end.counts[i] - start.counts[i] : 0;
+  }
+  return diff;
+}
+
+}  // namespace ycsbr
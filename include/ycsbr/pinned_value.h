@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string_view>
+#include <utility>
+
+namespace ycsbr {
+
+// A value that a database returns without copying it (see `PinnedRead()` in
+// `db_example.h`). The database points the view at its own memory and can
+// register a release callback, which runs when the caller is done with the
+// value (e.g., to unpin a block or drop a reference count).
+class PinnedValue {
+ public:
+  using Releaser = void (*)(void* token);
+
+  PinnedValue() : value_(), release_(nullptr), token_(nullptr) {}
+  ~PinnedValue() { Reset(); }
+
+  PinnedValue(const PinnedValue&) = delete;
+  PinnedValue& operator=(const PinnedValue&) = delete;
+
+  PinnedValue(PinnedValue&& other) noexcept
+      : value_(other.value_), release_(other.release_), token_(other.token_) {
+    other.value_ = std::string_view();
+    other.release_ = nullptr;
+    other.token_ = nullptr;
+  }
+
+  PinnedValue& operator=(PinnedValue&& other) noexcept {
+    if (this == &other) return *this;
+    Reset();
+    value_ = std::exchange(other.value_, std::string_view());
+    release_ = std::exchange(other.release_, nullptr);
+    token_ = std::exchange(other.token_, nullptr);
+    return *this;
+  }
+
+  // Points this object at `value`. If `release` is not null, it is called with
+  // `token` once the value is no longer needed. Releases any previously pinned
+  // value first.
+  void Pin(std::string_view value, Releaser release = nullptr,
+           void* token = nullptr) {
+    Reset();
+    value_ = value;
+    release_ = release;
+    token_ = token;
+  }
+
+  // Releases the pinned value (if any).
+  void Reset() {
+    if (release_ != nullptr) {
+      release_(token_);
+    }
+    value_ = std::string_view();
+    release_ = nullptr;
+    token_ = nullptr;
+  }
+
+  std::string_view value() const { return value_; }
+
+ private:
+  std::string_view value_;
+  Releaser release_;
+  void* token_;
+};
+
+}  // namespace ycsbr
@@ -14,6 +14,16 @@ struct Request {
     kReadModifyWrite = 4,
     kNegativeRead = 5
     ,kDelete = 6    ///////////////////////////////
+    // Deletes `scan_amount` records, starting at `key`.
+    ,kDeleteRange = 7
+    // Passes `value` to the database's merge operator (e.g., an increment).
+    ,kMerge = 8
+    // Replaces the record's current value with `value` (the current value is
+    // read first, to use as the expected value).
+    ,kCompareAndSwap = 9
+    // Starts a transaction made of the next `scan_amount` requests (which must
+    // be reads, inserts, or updates).
+    ,kTransaction = 10
   };
   using Key = uint64_t;
 
@@ -24,8 +34,8 @@ struct Request {
     const Operation op;
     const Key key;
     // To save space, the `scan_amount` is only encoded for requests with
-    // Operation::kScan. The `scan_amount` is encoded directly following the
-    // request in the file.
+    // Operation::kScan, Operation::kDeleteRange, or Operation::kTransaction.
+    // The `scan_amount` is encoded directly following the request in the file.
   } __attribute__((packed));
 
   Request() : Request(Operation::kRead, 0, 0, nullptr, 0) {}
@@ -42,15 +52,18 @@ struct Request {
   Operation op;
   Key key;
 
-  // Number of keys to scan; non-zero only if `op` is `Operation::kScan`.
+  // Number of keys to scan (or to delete); non-zero only if `op` is
+  // `Operation::kScan` or `Operation::kDeleteRange`. For
+  // `Operation::kTransaction`, the number of requests in the transaction.
   uint32_t scan_amount;
 
-  // Value to write; non-null only if `op` is `Operation::kInsert` or
-  // `Operation::kUpdate`.
+  // Value to write; non-null only if `op` is `Operation::kInsert`,
+  // `Operation::kUpdate`, `Operation::kReadModifyWrite`, `Operation::kMerge`,
+  // or `Operation::kCompareAndSwap` (or the tombstone for
+  // `Operation::kDelete`).
   const char* value;
 
-  // Size of the value to write in bytes; non-zero only if `op` is
-  // `Operation::kInsert` or `Operation::kUpdate`.
+  // Size of the value to write in bytes; non-zero only if `value` is non-null.
   size_t value_size;
 };
 
@@ -1,11 +1,40 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <string>
 
+#include "key_encoder.h"
+
 namespace ycsbr {
 
+// Controls how worker threads wait on a synchronization point (e.g., the start
+// of a workload). Spinning gives the lowest wakeup latency but keeps the
+// waiting cores busy.
+enum class WaitPolicy {
+  // Busy-wait until released.
+  kSpin,
+  // Busy-wait briefly, then repeatedly yield the core.
+  kSpinThenYield,
+  // Busy-wait briefly, then block until woken up by the OS.
+  kSpinThenPark
+};
+
+// Controls which hardware performance counters (see `PerfCounters`) the
+// workers collect while a workload runs.
+enum class PerfCounterMode {
+  kOff,
+  // Count events over the whole run and over each workload phase.
+  kPerPhase,
+  // Also read the counters around each request whose latency is sampled (see
+  // `RunOptions::latency_sample_period`), attributing the events to the
+  // request's operation type. Each reading is a system call, so this adds
+  // overhead to the sampled requests.
+  kPerOperation
+};
+
 // Options used to configure Session-based trace replays and workload runs.
 struct RunOptions {
   // Used to configure latency sampling. Sampling is done by individual workers,
@@ -24,16 +53,60 @@ struct RunOptions {
   // all scan amounts to be "valid".
   bool expect_scan_amount_found = false;
 
-  // If non-zero, each worker will compute its achieved throughput every
-  // `throughput_sample_period` requests. The samples will be written to CSV
-  // files, configured using the options below.
-  size_t throughput_sample_period = 0;
+  // The number of times a worker retries an aborted transaction before giving
+  // up on it (see `Request::Operation::kTransaction`). Each retry replays the
+  // same requests.
+  size_t max_transaction_retries = 10;
+
+  // If non-zero, each worker will record its throughput and a histogram of
+  // its sampled request latencies once every `throughput_sample_interval`.
+  // The samples are kept in memory while the workload runs and are reported
+  // in `BenchmarkResult::PerThread()` and `BenchmarkResult::Timeline()` (which
+  // merges the samples across workers). They are also written to CSV files
+  // after the workload finishes, configured using the options below.
+  std::chrono::milliseconds throughput_sample_interval{0};
+
+  // The number of throughput samples each worker keeps. The samples are
+  // allocated up front; if a workload runs for more intervals, only the most
+  // recent samples are kept.
+  size_t max_throughput_samples = 4096;
 
-  // A path to where the throughput sample output files should be saved.
+  // A path to where the throughput sample output files should be saved. Each
+  // worker's samples are written to `<prefix><worker id>.csv` and the merged
+  // samples are written to `<prefix>all.csv`.
   std::filesystem::path output_dir;
 
   // An optional prefix for throughput sample output files.
   std::string throughput_output_file_prefix;
+
+  // If non-zero, a reporter thread publishes the workers' progress (request
+  // counts and latency histograms) every `report_interval` while a workload
+  // runs, using the Prometheus text format. Set `report_file` and/or
+  // `report_port` to choose where the metrics are published.
+  std::chrono::milliseconds report_interval{0};
+
+  // The reporter replaces this file atomically on every report.
+  std::filesystem::path report_file;
+
+  // If non-zero, the reporter serves the latest metrics over HTTP on
+  // `127.0.0.1:<report_port>` (any request path works).
+  uint16_t report_port = 0;
+
+  // Whether each worker should count hardware events (cycles, instructions,
+  // LLC misses, dTLB misses, and branch misses) using `perf_event_open`. The
+  // counts are reported in `BenchmarkResult::Perf()` and related methods.
+  PerfCounterMode perf_counters = PerfCounterMode::kOff;
+
+  // How keys are passed to databases that take string keys (see
+  // `db_example.h`). The default encoding is the key's eight bytes in
+  // big-endian order. Integer-keyed databases ignore this option.
+  KeyEncoder key_encoder;
+
+  // How the workers wait for the workload to start. All workers are released
+  // at once when the workload starts; the spread in their actual start times
+  // is reported by `BenchmarkResult::StartSkew()`. Use `WaitPolicy::kSpin` to
+  // minimize this skew when every worker has its own core.
+  WaitPolicy start_wait_policy = WaitPolicy::kSpinThenPark;
 };
 
 }  // namespace ycsbr
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "impl/tombstone.h"
+#include "request.h"
+
+namespace ycsbr {
+
+// Receives the records of a range scan, one at a time (see `VisitScan()` in
+// `db_example.h`). The database can pass views of its own memory: the visitor
+// reads each value while it is called and keeps no references to it, so
+// nothing is copied or allocated per record.
+class ScanVisitor {
+ public:
+  // Accepts up to `amount` records. If `tombstone` is not null, records
+  // holding the tombstone are skipped and do not count towards `amount`.
+  ScanVisitor(size_t amount, const impl::TombstoneMatcher* tombstone = nullptr)
+      : amount_(amount),
+        tombstone_(tombstone),
+        num_records_(0),
+        num_bytes_(0),
+        read_xor_(0) {}
+
+  // Visits the next record in the scan. Returns false once the scan has
+  // produced enough records; the database should stop scanning then.
+  bool operator()(Request::Key key, std::string_view value) {
+    return Visit(sizeof(key), value);
+  }
+  // Used by databases that take string keys.
+  bool operator()(std::string_view key, std::string_view value) {
+    return Visit(key.size(), value);
+  }
+
+  size_t NumRecords() const { return num_records_; }
+  size_t NumBytes() const { return num_bytes_; }
+  uint32_t ReadXOR() const { return read_xor_; }
+
+ private:
+  bool Visit(size_t key_size, std::string_view value) {
+    if (tombstone_ != nullptr && tombstone_->Matches(value)) {
+      return num_records_ < amount_;
+    }
+    if (num_records_ == 0) {
+      // Force a read of the first value (like `Read()` does) so that the
+      // scan's latency includes it.
+      uint32_t prefix = 0;
+      std::memcpy(&prefix, value.data(),
+                  value.size() < sizeof(prefix) ? value.size() : sizeof(prefix));
+      read_xor_ ^= prefix;
+    }
+    ++num_records_;
+    num_bytes_ += key_size + value.size();
+    return num_records_ < amount_;
+  }
+
+  const size_t amount_;
+  const impl::TombstoneMatcher* tombstone_;
+  size_t num_records_;
+  size_t num_bytes_;
+  uint32_t read_xor_;
+};
+
+}  // namespace ycsbr
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "benchmark_result.h"
 #include "impl/thread_pool.h"
+#include "impl/topology.h"
 #include "run_options.h"
+#include "time_series.h"
 #include "trace.h"
 
 namespace ycsbr {
@@ -22,6 +25,12 @@ class Session {
   Session(size_t num_threads,
           const std::vector<size_t>& core_map = std::vector<size_t>());
 
+  // Starts a benchmark session whose worker threads are pinned to cores chosen
+  // by `placement`, based on the machine's NUMA topology (read from sysfs).
+  // Each worker prepares its workload data on its own thread, so that memory
+  // is first touched on (and allocated from) the worker's NUMA node.
+  Session(size_t num_threads, PlacementPolicy placement);
+
   // Calls `DatabaseInterface::InitializeDatabase()` on a single worker thread.
   // This must be called before any of the Replay/Run methods. This method
   // should also only be called at most once.//!在单个工作线程上调用“DatabaseInterface::InitializeDatabase()”。//这必须在任何 Replay/Run 方法之前调用。 此方法也最多只能调用一次。
@@ -42,10 +51,20 @@ class Session {
   DatabaseInterface& db();
   const DatabaseInterface& db() const;
 
-  // Replays the provided bulk load trace. Note that bulk loads always run on
-  // one thread.//!重播提供的批量load跟踪。 请注意，批量加载始终在一个线程上运行。
+  // Replays the provided bulk load trace. Note that this bulk load runs on
+  // one thread (see `ReplayBulkLoadTraceParallel()`).//!重播提供的批量load跟踪。 请注意，批量加载始终在一个线程上运行。
   BenchmarkResult ReplayBulkLoadTrace(const BulkLoadTrace& load);
 
+  // Replays the provided bulk load trace using all the worker threads. The
+  // trace is split into one partition per worker, and the workers call
+  // `DatabaseInterface::BulkLoadPartition()` concurrently (all workers start at
+  // the same time). The result's writes are the aggregate ingest; per-worker
+  // ingest throughput is available through `BenchmarkResult::PerThread()`.
+  BenchmarkResult ReplayBulkLoadTraceParallel(
+      const BulkLoadTrace& load,
+      BulkLoadTrace::Partitioning partitioning =
+          BulkLoadTrace::Partitioning::kKeyRange);
+
   // Replays the provided trace. The trace's requests will be split among all
   // the worker threads. //!重播提供的trace。 trace的requests将在所有工作线程之间分配。
   BenchmarkResult ReplayTrace(const Trace& trace,
@@ -57,7 +76,12 @@ class Session {
                               const RunOptions& options = RunOptions());
 
  private:
+  static void WriteTimeSeries(const RunOptions& options,
+                              const std::string& name,
+                              const std::vector<TimeSeriesSample>& samples);
+
   DatabaseInterface db_;
+  impl::CpuTopology topology_;
   std::unique_ptr<impl::ThreadPool> threads_;   //num_threads个数的线程
   size_t num_threads_;
   bool initialized_;
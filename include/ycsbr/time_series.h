@@ -0,0 +1,152 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+namespace ycsbr {
+
+// A coarse latency histogram with power-of-two sized buckets. Recording a
+// latency is constant time, so it is cheap enough to use while a workload runs.
+class LatencyHistogram {
+ public:
+  // Bucket `i > 0` holds latencies in the range [2^(i - 1), 2^i) nanoseconds.
+  // The last bucket also holds all larger latencies.
+  static constexpr size_t kNumBuckets = 40;
+
+  LatencyHistogram() : counts_(), num_samples_(0) {}
+
+  void Record(std::chrono::nanoseconds latency);
+  void Merge(const LatencyHistogram& other);
+  void Reset();
+
+  uint64_t NumSamples() const { return num_samples_; }
+  uint64_t BucketCount(size_t bucket) const { return counts_[bucket]; }
+
+  // The bucket that holds `latency`.
+  static size_t BucketFor(std::chrono::nanoseconds latency);
+  // The largest latency that falls into `bucket`.
+  static std::chrono::nanoseconds BucketUpperBound(size_t bucket);
+
+  // Returns an upper bound on the given percentile (in the range [0, 1]): the
+  // upper edge of the bucket that holds the percentile. Returns 0 if there are
+  // no samples.
+  std::chrono::nanoseconds Percentile(double percentile) const;
+
+ private:
+  std::array<uint32_t, kNumBuckets> counts_;
+  uint64_t num_samples_;
+};
+
+// The requests a worker (or all workers) completed during one sampling
+// interval. See `RunOptions::throughput_sample_interval`.
+struct TimeSeriesSample {
+  // Time since the start of the workload, measured at the end of the interval.
+  std::chrono::nanoseconds elapsed;
+  // The length of the interval. The last interval of a run is usually shorter
+  // than the sampling interval.
+  std::chrono::nanoseconds interval;
+  size_t num_requests;
+  size_t num_records;
+  // Only includes the requests whose latency was measured (see
+  // `RunOptions::latency_sample_period`).
+  LatencyHistogram latency;
+
+  double MRequestsPerSecond() const;
+  double MRecordsPerSecond() const;
+};
+
+void PrintTimeSeriesCSVHeader(std::ostream& out);
+void PrintTimeSeriesAsCSV(const std::vector<TimeSeriesSample>& samples,
+                          std::ostream& out, bool print_header = true);
+
+// Implementation details follow.
+
+inline size_t LatencyHistogram::BucketFor(
+    const std::chrono::nanoseconds latency) {
+  const uint64_t nanos = latency.count() > 0 ? latency.count() : 0;
+  // The number of significant bits in `nanos`.
+  const size_t bucket = nanos == 0 ? 0 : 64 - __builtin_clzll(nanos);
+  return bucket < kNumBuckets ? bucket : kNumBuckets - 1;
+}
+
+inline std::chrono::nanoseconds LatencyHistogram::BucketUpperBound(
+    const size_t bucket) {
+  return std::chrono::nanoseconds(bucket == 0 ? 0 : (1ULL << bucket) - 1);
+}
+
+inline void LatencyHistogram::Record(const std::chrono::nanoseconds latency) {
+  ++counts_[BucketFor(latency)];
+  ++num_samples_;
+}
+
+inline void LatencyHistogram::Merge(const LatencyHistogram& other) {
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    counts_[i] += other.counts_[i];
+  }
+  num_samples_ += other.num_samples_;
+}
+
+inline void LatencyHistogram::Reset() {
+  counts_.fill(0);
+  num_samples_ = 0;
+}
+
+inline std::chrono::nanoseconds LatencyHistogram::Percentile(
+    const double percentile) const {
+  if (num_samples_ == 0) return std::chrono::nanoseconds(0);
+  const double target = percentile * num_samples_;
+  uint64_t seen = 0;
+  for (size_t i = 0; i < kNumBuckets; ++i) {
+    seen += counts_[i];
+    if (seen > 0 && seen >= target) {
+      return BucketUpperBound(i);
+    }
+  }
+  return BucketUpperBound(kNumBuckets - 1);
+}
+
+inline double TimeSeriesSample::MRequestsPerSecond() const {
+  if (interval.count() <= 0) return 0.0;
+  return num_requests /
+         std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+             interval)
+             .count();
+}
+
+inline double TimeSeriesSample::MRecordsPerSecond() const {
+  if (interval.count() <= 0) return 0.0;
+  return num_records /
+         std::chrono::duration_cast<std::chrono::duration<double, std::micro>>(
+             interval)
+             .count();
+}
+
+inline void PrintTimeSeriesCSVHeader(std::ostream& out) {
+  out << "elapsed_ns,interval_ns,num_requests,num_records,mrequests_per_s,"
+         "mrecords_per_s,latency_samples,latency_ns_p50,latency_ns_p99"
+      << std::endl;
+}
+
+inline void PrintTimeSeriesAsCSV(const std::vector<TimeSeriesSample>& samples,
+                                 std::ostream& out, bool print_header) {
+  if (print_header) {
+    PrintTimeSeriesCSVHeader(out);
+  }
+  for (const auto& sample : samples) {
+    out << sample.elapsed.count() << ",";
+    out << sample.interval.count() << ",";
+    out << sample.num_requests << ",";
+    out << sample.num_records << ",";
+    out << sample.MRequestsPerSecond() << ",";
+    out << sample.MRecordsPerSecond() << ",";
+    out << sample.latency.NumSamples() << ",";
+    out << sample.latency.Percentile(0.5).count() << ",";
+    out << sample.latency.Percentile(0.99).count() << "\n";
+  }
+  out.flush();
+}
+
+}  // namespace ycsbr
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "impl/huge_page_buffer.h"
+#include "impl/page_allocator.h"
+#include "memory_options.h"
 #include "request.h"
 
 namespace ycsbr {
@@ -27,13 +33,38 @@ class Trace {
     // If `use_v1_semantics` is set to true, the sort will be lexicographic.
     bool sort_requests = false;    //++如果为 true，request将按key升序排序。 如果“use_v1_semantics”设置为 true，则将按字典顺序排序。
 
-    // The size of the values for insert and update requests, in bytes.
+    // The size of the values for insert and update requests, in bytes. Delete
+    // requests pass a tombstone of this size.
     size_t value_size = 1024;     //++插入和更新请求的value的大小（以字节为单位）。
+
+    // If this is larger than `value_size`, the value sizes are drawn uniformly
+    // from `[value_size, max_value_size]` instead.
+    size_t max_value_size = 0;
+
+    // Insert and update requests cycle through this many distinct values
+    // (each with its own size). Set this to 0 to give every write its own
+    // value.
+    size_t num_unique_values = 1024;
+
+    enum class ValueContent {
+      // Incompressible random bytes.
+      kRandom,
+      // Random bytes that compress by about `value_compression_ratio`.
+      kCompressible,
+      // All zero bytes.
+      kZeros
+    };
+    ValueContent value_content = ValueContent::kRandom;
+    double value_compression_ratio = 2.0;
+
+    // How to allocate the trace's requests and values.
+    MemoryOptions memory;
+
     int rng_seed = 42;
   };
   static Trace LoadFromFile(const std::string& file, const Options& options);
 
-  using const_iterator = std::vector<Request>::const_iterator;
+  using const_iterator = impl::PageVector<Request>::const_iterator;
   const_iterator begin() const { return requests_.begin(); }
   const_iterator end() const { return requests_.end(); }
   size_t size() const { return requests_.size(); }
@@ -50,34 +81,143 @@ class Trace {
   // lexicographically.  //++获取此“Workload”中的最小和最大key。 key按字典顺序进行比较。
   MinMaxKeys GetKeyRange() const;
 
+  // The value this trace's delete requests pass to
+  // `DatabaseInterface::Delete()`, or an empty view if the trace has no
+  // deletes. Reads and scans that return it treat the record as deleted (see
+  // `TombstoneValue()` in `workload_example.h`).
+  std::string_view TombstoneValue() const { return tombstone_; }
+
+  // True if the trace contains transactions. A transaction's requests follow
+  // it in the trace (see `Request::Operation::kTransaction`), so the trace
+  // cannot be split between producers inside a transaction.
+  bool HasTransactions() const { return has_transactions_; }
+
  protected:
   static Trace ProcessRawTrace(std::vector<Request> raw_trace,
                                const Options& options);
-  Trace(std::vector<Request> requests, std::unique_ptr<char[]> values,  //!构造函数，需要用std::vector<Request>和value来构造
-        bool use_v1_semantics)
+  // Throws `std::invalid_argument` if `options` are invalid.
+  static void ValidateOptions(const Options& options);
+  // Returns true if `k1` orders before `k2` under this trace's semantics.
+  bool KeyLessThan(Request::Key k1, Request::Key k2) const;
+  Trace(impl::PageVector<Request> requests, impl::HugePageBuffer values,  //!构造函数，需要用std::vector<Request>和value来构造
+        std::string_view tombstone, bool use_v1_semantics,
+        bool has_transactions)
       : requests_(std::move(requests)),
         values_(std::move(values)),
-        use_v1_semantics_(use_v1_semantics) {}
+        tombstone_(tombstone),
+        use_v1_semantics_(use_v1_semantics),
+        has_transactions_(has_transactions) {}
 
  private:
-  std::vector<Request> requests_;
+  impl::PageVector<Request> requests_;
   // All values stored contiguously. //++所有value连续存储
-  std::unique_ptr<char[]> values_;  
+  impl::HugePageBuffer values_;
+  // Points into `values_` (after the write values).
+  std::string_view tombstone_;
   bool use_v1_semantics_;
+  bool has_transactions_;
 };
 
 class BulkLoadTrace : public Trace {
  public:
   static BulkLoadTrace LoadFromFile(const std::string& file,
                                     const Trace::Options& options);
-  static BulkLoadTrace LoadFromKeys(const std::vector<Request::Key>& keys,
-                                    const Trace::Options& options);
+  template <class Allocator>
+  static BulkLoadTrace LoadFromKeys(
+      const std::vector<Request::Key, Allocator>& keys,
+      const Trace::Options& options);
   size_t DatasetSizeBytes() const;
 
+  // How to divide a bulk load among multiple threads.
+  enum class Partitioning {
+    // Each partition holds a contiguous key range. The records in each
+    // partition are in ascending key order.
+    kKeyRange,
+    // Record `i` is assigned to partition `i % num_partitions`, in trace order.
+    kRoundRobin
+  };
+  class Partition;
+
+  // Splits this trace into `num_partitions` disjoint partitions of (nearly)
+  // equal size. The partitions refer to this trace, so it must outlive them.
+  std::vector<Partition> Split(size_t num_partitions,
+                               Partitioning partitioning) const;
+
  private:
   BulkLoadTrace(Trace trace) : Trace(std::move(trace)) {}   //构造函数，需要用Trace构造
 };
 
+// A read-only view of a subset of a `BulkLoadTrace`'s records. These are passed
+// to `DatabaseInterface::BulkLoadPartition()` during parallel bulk loads.
+class BulkLoadTrace::Partition {
+ public:
+  class const_iterator;
+  const_iterator begin() const;
+  const_iterator end() const;
+  size_t size() const { return size_; }
+  const Request& operator[](size_t index) const;
+
+  // This partition's index, in the range `[0, num_partitions())`.
+  size_t id() const { return id_; }
+  size_t num_partitions() const { return num_partitions_; }
+
+  size_t DatasetSizeBytes() const;
+
+ private:
+  friend class BulkLoadTrace;
+  Partition(const BulkLoadTrace* trace,
+            std::shared_ptr<const std::vector<size_t>> order, size_t id,
+            size_t num_partitions, size_t start, size_t stride, size_t size)
+      : trace_(trace),
+        order_(std::move(order)),
+        id_(id),
+        num_partitions_(num_partitions),
+        start_(start),
+        stride_(stride),
+        size_(size) {}
+
+  const BulkLoadTrace* trace_;
+  // If non-null, maps positions to indices in `trace_` (e.g., in key order).
+  std::shared_ptr<const std::vector<size_t>> order_;
+  size_t id_, num_partitions_;
+  // This partition holds positions `start_ + i * stride_` for `i < size_`.
+  size_t start_, stride_, size_;
+};
+
+class BulkLoadTrace::Partition::const_iterator {
+ public:
+  using iterator_category = std::forward_iterator_tag;
+  using value_type = Request;
+  using difference_type = std::ptrdiff_t;
+  using pointer = const Request*;
+  using reference = const Request&;
+
+  reference operator*() const { return (*partition_)[index_]; }
+  pointer operator->() const { return &(*partition_)[index_]; }
+  const_iterator& operator++() {
+    ++index_;
+    return *this;
+  }
+  const_iterator operator++(int) {
+    const_iterator prev = *this;
+    ++index_;
+    return prev;
+  }
+  bool operator==(const const_iterator& other) const {
+    return index_ == other.index_ && partition_ == other.partition_;
+  }
+  bool operator!=(const const_iterator& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  friend class Partition;
+  const_iterator(const Partition* partition, size_t index)
+      : partition_(partition), index_(index) {}
+  const Partition* partition_;
+  size_t index_;
+};
+
 }  // namespace ycsbr
 
 #include "impl/trace-inl.h"
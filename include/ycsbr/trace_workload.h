@@ -1,6 +1,10 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include "ycsbr/request.h"
@@ -8,51 +12,168 @@
 
 namespace ycsbr {
 
+// Controls how a workload's requests are divided among its producers (i.e.,
+// the worker threads).
+enum class WorkDistribution {
+  // Each producer is assigned an equal share of the requests up front. The
+  // workload finishes when the slowest producer finishes its share.
+  kStatic,
+  // Producers repeatedly claim fixed-size chunks of requests from a shared
+  // pool until it runs out. Faster producers make more requests, so a slow
+  // worker delays the end of the workload by at most one chunk.
+  kSharedChunks
+};
+
 class TraceWorkload {
  public:
-  TraceWorkload(const Trace* trace) : trace_(trace) {}
+  // The default number of requests producers claim at a time when using
+  // `WorkDistribution::kSharedChunks`.
+  static constexpr size_t kDefaultChunkSize = 1024;
+
+  TraceWorkload(const Trace* trace,
+                WorkDistribution distribution = WorkDistribution::kStatic,
+                size_t chunk_size = kDefaultChunkSize)
+      : trace_(trace), distribution_(distribution), chunk_size_(chunk_size) {}
 
   class Producer;
+  // Divides the trace among `num_producers` producers. A transaction is always
+  // given to one producer along with all of its requests, so the shares (or
+  // chunks) can differ in size by up to one transaction.
   std::vector<Producer> GetProducers(size_t num_producers) const;
 
  private:
+  // Returns the first index at or after `target` that does not fall inside a
+  // transaction. `from` must be such an index, and must not exceed `target`.
+  size_t TransactionBoundary(size_t from, size_t target) const;
+
   const Trace* trace_;
+  WorkDistribution distribution_;
+  size_t chunk_size_;
 };
 
 class TraceWorkload::Producer {
  public:
-  void Prepare() {}
+  void Prepare() {
+    if (cursor_ != nullptr) ClaimChunk();
+  }
   bool HasNext() const { return index_ < stop_before_; }
-  Request Next() { return (*trace_)[index_++]; }
+  std::string_view TombstoneValue() const { return trace_->TombstoneValue(); }
+  Request Next() {
+    const Request& req = (*trace_)[index_++];
+    if (index_ == stop_before_ && cursor_ != nullptr) ClaimChunk();
+    return req;
+  }
 
  private:
   friend class TraceWorkload;
+
+  // The index of the next unclaimed request, shared by all producers.
+  struct alignas(64) SharedCursor {
+    std::atomic<size_t> next = 0;
+  };
+
   Producer(const Trace* trace, size_t start_index, size_t num_requests)
       : trace_(trace),
         index_(start_index),
-        stop_before_(start_index + num_requests) {}
+        stop_before_(start_index + num_requests),
+        chunk_size_(0),
+        cursor_(nullptr) {}
+  Producer(const Trace* trace, size_t chunk_size,
+           std::shared_ptr<SharedCursor> cursor,
+           std::shared_ptr<const std::vector<size_t>> chunk_starts)
+      : trace_(trace),
+        index_(0),
+        stop_before_(0),
+        chunk_size_(chunk_size),
+        cursor_(std::move(cursor)),
+        chunk_starts_(std::move(chunk_starts)) {}
+
+  void ClaimChunk() {
+    if (chunk_starts_ == nullptr) {
+      const size_t start =
+          cursor_->next.fetch_add(chunk_size_, std::memory_order_relaxed);
+      index_ = std::min(start, trace_->size());
+      stop_before_ = std::min(index_ + chunk_size_, trace_->size());
+      return;
+    }
+    // The cursor counts chunks instead of requests.
+    const size_t chunk = cursor_->next.fetch_add(1, std::memory_order_relaxed);
+    if (chunk >= chunk_starts_->size()) {
+      index_ = stop_before_ = trace_->size();
+      return;
+    }
+    index_ = (*chunk_starts_)[chunk];
+    stop_before_ = chunk + 1 < chunk_starts_->size()
+                       ? (*chunk_starts_)[chunk + 1]
+                       : trace_->size();
+  }
+
   const Trace* trace_;
   size_t index_;
   size_t stop_before_;
+
+  // Only used with `WorkDistribution::kSharedChunks`.
+  size_t chunk_size_;
+  std::shared_ptr<SharedCursor> cursor_;
+  // Set if the trace has transactions: the chunks then start at these indices
+  // (so that no chunk ends inside a transaction) instead of every
+  // `chunk_size_` requests.
+  std::shared_ptr<const std::vector<size_t>> chunk_starts_;
 };
 
+inline size_t TraceWorkload::TransactionBoundary(size_t from,
+                                                 const size_t target) const {
+  if (!trace_->HasTransactions()) return target;
+  const size_t stop = std::min(target, trace_->size());
+  while (from < stop) {
+    const Request& req = (*trace_)[from];
+    from += 1;
+    if (req.op == Request::Operation::kTransaction) from += req.scan_amount;
+  }
+  return std::min(from, trace_->size());
+}
+
 inline std::vector<TraceWorkload::Producer> TraceWorkload::GetProducers(
     size_t num_producers) const {
   std::vector<Producer> producers;
   producers.reserve(num_producers);
 
+  if (distribution_ == WorkDistribution::kSharedChunks) {
+    if (chunk_size_ == 0) {
+      throw std::invalid_argument("The chunk size must be positive.");
+    }
+    std::shared_ptr<std::vector<size_t>> chunk_starts;
+    if (trace_->HasTransactions()) {
+      chunk_starts = std::make_shared<std::vector<size_t>>();
+      for (size_t start = 0; start < trace_->size();
+           start = TransactionBoundary(start, start + chunk_size_)) {
+        chunk_starts->push_back(start);
+      }
+    }
+    auto cursor = std::make_shared<Producer::SharedCursor>();
+    for (size_t producer_id = 0; producer_id < num_producers; ++producer_id) {
+      producers.push_back(Producer(trace_, chunk_size_, cursor, chunk_starts));
+    }
+    return producers;
+  }
+
   // Split up the requests.
   const size_t min_requests_per_producer = trace_->size() / num_producers;
   size_t leftover_requests = trace_->size() % num_producers;
+  size_t target_offset = 0;
   size_t next_offset = 0;
   for (size_t producer_id = 0; producer_id < num_producers; ++producer_id) {
-    size_t num_requests = min_requests_per_producer;
+    target_offset += min_requests_per_producer;
     if (leftover_requests > 0) {
-      ++num_requests;
+      ++target_offset;
       --leftover_requests;
     }
-    producers.push_back(Producer(trace_, next_offset, num_requests));
-    next_offset += num_requests;
+    // A transaction that straddles the even split goes to this producer.
+    const size_t end_offset =
+        TransactionBoundary(next_offset, std::max(next_offset, target_offset));
+    producers.push_back(
+        Producer(trace_, next_offset, end_offset - next_offset));
+    next_offset = end_offset;
   }
 
   return producers;
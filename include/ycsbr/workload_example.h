@@ -1,5 +1,6 @@
 #pragma once
 
+#include <string_view>
 #include <vector>
 
 #include "ycsbr/request.h"
@@ -16,6 +17,12 @@ class ExampleCustomWorkload final {
   // `Producer`s are meant to generate requests that are specific to a thread.
   class Producer;
   virtual std::vector<Producer> GetProducers(size_t num_producers) = 0;
+
+  // OPTIONAL: Return true if some of the workload's requests are only made
+  // until a deadline (rather than a fixed number of them). `BufferedWorkload`
+  // and `WorkloadSnapshot::Export()` generate the requests ahead of the run,
+  // so they reject such workloads.
+  virtual bool HasDurationPhases() const = 0;
 };
 
 class ExampleCustomWorkload::Producer final {
@@ -31,6 +38,24 @@ class ExampleCustomWorkload::Producer final {
 
   // This method may also return a `const Request&`.
   virtual Request Next() = 0;
+
+  // OPTIONAL: Return the ID of the workload phase that the next request
+  // (returned by `Next()`) belongs to. If this method exists, the benchmark
+  // results are also broken down by phase (see
+  // `BenchmarkResult::PerPhase()`).
+  virtual size_t CurrentPhase() const = 0;
+
+  // OPTIONAL: Called once on each producer after every producer's `Prepare()`
+  // has returned (and before the workload starts). The calls are made by one
+  // thread, in the order the producers were returned by `GetProducers()`.
+  virtual void FinishPrepare() = 0;
+
+  // OPTIONAL: Return the value this workload passes to
+  // `DatabaseInterface::Delete()`, or an empty view if the workload never
+  // deletes records. If a read or scan returns this value, the record is
+  // treated as deleted: the read counts as failed and the scanned record is
+  // dropped. Called once, after `Prepare()`; the executor keeps its own copy.
+  virtual std::string_view TombstoneValue() const = 0;
 };
 
 }  // namespace ycsbr
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "request.h"
+
+namespace ycsbr {
+
+// A workload's per-producer request streams, recorded into a file. Recording a
+// snapshot runs the workload's producers once; replaying it (the snapshot is a
+// workload) maps the file into memory and reads the requests from it, so the
+// original workload's generation and preparation costs are not paid again.
+//
+// A snapshot is tied to the number of producers it was recorded with (and to
+// the workload's seed). The file uses the machine's native byte order. Phases
+// bounded by a duration (instead of a request count) cannot be recorded.
+class WorkloadSnapshot {
+ public:
+  // Runs `workload` with `num_producers` producers (on the calling thread) and
+  // writes their request streams to `file`. The producers' optional
+  // `CurrentPhase()` and `TombstoneValue()` results are recorded too. Throws
+  // `std::invalid_argument` if the workload has phases bounded by a duration.
+  template <class Workload>
+  static void Export(const Workload& workload, size_t num_producers,
+                     const std::filesystem::path& file);
+
+  // Maps a snapshot file into memory. Throws `std::runtime_error` if the file
+  // cannot be opened or is not a valid snapshot.
+  static WorkloadSnapshot Open(const std::filesystem::path& file);
+
+  size_t NumProducers() const;
+
+  class Producer;
+  // `num_producers` must match the number of producers the snapshot was
+  // recorded with.
+  std::vector<Producer> GetProducers(size_t num_producers) const;
+
+ private:
+  static constexpr char kMagic[8] = {'Y', 'C', 'S', 'B', 'R', 'S', 'N', 'P'};
+  static constexpr uint32_t kVersion = 1;
+
+  // The on-disk layout. All offsets are from the start of the file.
+  struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_producers;
+  };
+  struct StreamInfo {
+    uint64_t records_offset;
+    uint64_t num_records;
+    uint64_t phases_offset;
+    uint64_t num_phases;
+    uint64_t values_offset;
+    uint64_t values_size;
+    uint64_t tombstone_offset;
+    uint64_t tombstone_size;
+  };
+  struct Record {
+    Request::Key key;
+    // Relative to the stream's `values_offset`.
+    uint64_t value_offset;
+    uint32_t value_size;
+    uint32_t scan_amount;
+    Request::Operation op;
+    uint8_t padding[7];
+  };
+  // A run of consecutive records that belong to the same phase.
+  struct PhaseRun {
+    uint64_t phase_id;
+    // One past the index of the run's last record.
+    uint64_t end_index;
+  };
+
+  class Mapping;
+  explicit WorkloadSnapshot(std::shared_ptr<const Mapping> mapping)
+      : mapping_(std::move(mapping)) {}
+
+  const Header& header() const;
+  const StreamInfo& stream(size_t producer_id) const;
+
+  std::shared_ptr<const Mapping> mapping_;
+};
+
+class WorkloadSnapshot::Producer {
+ public:
+  void Prepare();
+  bool HasNext() const { return next_record_ < num_records_; }
+  Request Next();
+  size_t CurrentPhase() const;
+  std::string_view TombstoneValue() const;
+
+ private:
+  friend class WorkloadSnapshot;
+  Producer(std::shared_ptr<const Mapping> mapping, const StreamInfo& stream);
+
+  std::shared_ptr<const Mapping> mapping_;
+  const Record* records_;
+  size_t num_records_;
+  size_t next_record_;
+  const PhaseRun* phases_;
+  size_t num_phases_;
+  size_t current_phase_index_;
+  const char* values_;
+  std::string_view tombstone_;
+};
+
+}  // namespace ycsbr
+
+#include "impl/workload_snapshot-inl.h"
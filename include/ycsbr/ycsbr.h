@@ -15,10 +15,16 @@
 #include "benchmark.h"
 #include "buffered_workload.h"
 #include "db_example.h"
+#include "memory_options.h"
 #include "meter.h"
+#include "perf_counters.h"
+#include "pinned_value.h"
 #include "request.h"
 #include "run_options.h"
+#include "scan_visitor.h"
 #include "session.h"
+#include "time_series.h"
 #include "trace_workload.h"
 #include "trace.h"
 #include "workload_example.h"
+#include "workload_snapshot.h"
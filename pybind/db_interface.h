@@ -1,6 +1,7 @@
 #pragma once
 
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <utility>
@@ -36,6 +37,16 @@ class DatabaseInterface {
   // Insert the specified key value pair. Return true if the insert succeeded.
   virtual bool Insert(Request::Key key, const std::string& value) = 0;
 
+  // Delete the record at the specified key. Return true if the delete
+  // succeeded. Databases without native deletes can write `tombstone` as the
+  // record's value instead; later reads and scans treat it as deleted.
+  // Implementing this is optional if the workloads never delete records.
+  virtual bool Delete(Request::Key /*key*/, const std::string& /*tombstone*/) {
+    throw std::runtime_error(
+        "The workload deletes records, but the database does not implement "
+        "delete().");
+  }
+
   // Read and return the value at the specified key. Return none if the read
   // failed.
   virtual std::optional<std::string> Read(Request::Key key) = 0;
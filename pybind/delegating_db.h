@@ -39,6 +39,10 @@ class DelegatingDB {
     return db_->Insert(key, std::string(value, value_size));
   }
 
+  bool Delete(Request::Key key, const char* tombstone, size_t tombstone_size) {
+    return db_->Delete(key, std::string(tombstone, tombstone_size));
+  }
+
   bool Read(Request::Key key, std::string* value_out) {
     auto result = db_->Read(key);
     if (!result.has_value()) {
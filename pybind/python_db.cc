@@ -36,6 +36,12 @@ bool PythonDatabase::Insert(Request::Key key, const std::string& value) {
                               pybind11::bytes(value));
 }
 
+bool PythonDatabase::Delete(Request::Key key, const std::string& tombstone) {
+  pybind11::gil_scoped_acquire acquire;
+  PYBIND11_OVERRIDE_NAME(bool, DatabaseInterface, "delete", Delete, key,
+                         pybind11::bytes(tombstone));
+}
+
 std::optional<std::string> PythonDatabase::Read(Request::Key key) {
   pybind11::gil_scoped_acquire acquire;
   PYBIND11_OVERRIDE_PURE_NAME(std::optional<std::string>, DatabaseInterface,
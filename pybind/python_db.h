@@ -29,6 +29,10 @@ class PythonDatabase : public DatabaseInterface {
   // Insert the specified key value pair. Return true if the insert succeeded.
   bool Insert(Request::Key key, const std::string& value) override;
 
+  // Delete the record at the specified key. Return true if the delete
+  // succeeded.
+  bool Delete(Request::Key key, const std::string& tombstone) override;
+
   // Read the value at the specified key. Return true if the read succeeded.
   std::optional<std::string> Read(Request::Key key) override;
 
@@ -0,0 +1,111 @@
+# Smoke test for the YCSBR Python bindings. It replays a trace that contains
+# deletes against a database implemented in Python.
+#
+# Build the bindings (-DYR_BUILD_GENERATOR=ON -DYR_BUILD_PYBIND=ON) and run:
+#   PYTHONPATH=<build dir>/pybind python3 pybind/smoke_test.py
+
+import os
+import struct
+import tempfile
+
+import ycsbr_py
+
+# Matches `ycsbr::Request::Operation`.
+OP_INSERT = 0
+OP_READ = 1
+OP_DELETE = 6
+
+VALUE_SIZE = 16
+
+
+class DictDatabase(ycsbr_py.DatabaseInterface):
+    def __init__(self):
+        ycsbr_py.DatabaseInterface.__init__(self)
+        self.records = {}
+        self.tombstones = set()
+
+    def initialize_database(self):
+        pass
+
+    def shutdown_database(self):
+        pass
+
+    def bulk_load(self, load):
+        for i in range(len(load)):
+            self.records[load.get_key_at(i)] = b"\x00" * VALUE_SIZE
+
+    def insert(self, key, value):
+        self.records[key] = value
+        return True
+
+    def update(self, key, value):
+        if key not in self.records:
+            return False
+        self.records[key] = value
+        return True
+
+    def delete(self, key, tombstone):
+        self.tombstones.add(tombstone)
+        return self.records.pop(key, None) is not None
+
+    def read(self, key):
+        return self.records.get(key)
+
+    def scan(self, key, amount):
+        keys = sorted(k for k in self.records if k >= key)[:amount]
+        return [(k, self.records[k]) for k in keys]
+
+
+def write_trace(requests):
+    # Each request is encoded as a packed `ycsbr::Request::Encoded`.
+    fd, path = tempfile.mkstemp(suffix=".ycsb", prefix="ycsbr_py_")
+    with os.fdopen(fd, "wb") as out:
+        for op, key in requests:
+            out.write(struct.pack("=BQ", op, key))
+    return path
+
+
+def main():
+    path = write_trace(
+        [
+            (OP_INSERT, 1),
+            (OP_DELETE, 1),
+            (OP_READ, 1),
+            (OP_DELETE, 2),
+            (OP_DELETE, 4),
+            (OP_READ, 3),
+        ]
+    )
+    try:
+        trace = ycsbr_py.Trace(path, value_size=VALUE_SIZE)
+    finally:
+        os.remove(path)
+    assert len(trace) == 6
+
+    db = DictDatabase()
+    session = ycsbr_py.Session(1)
+    session.set_database(db)
+    session.initialize()
+    try:
+        session.replay_bulk_load_trace(
+            ycsbr_py.BulkLoadTrace([2, 3], value_size=VALUE_SIZE)
+        )
+        result = session.replay_trace(trace)
+    finally:
+        session.terminate()
+
+    # Key 4 was never written, so its delete fails (and is not counted in
+    # `num_deletes`).
+    assert result.num_deletes == 2, result.num_deletes
+    assert result.num_failed_deletes == 1, result.num_failed_deletes
+    # Key 1 was deleted before it was read.
+    assert result.num_failed_reads == 1, result.num_failed_reads
+    assert sorted(db.records) == [3], db.records
+    # Every delete passes the trace's tombstone.
+    assert len(db.tombstones) == 1
+    assert len(db.tombstones.pop()) == VALUE_SIZE
+    print("OK")
+
+
+if __name__ == "__main__":
+    main()
@@ -28,6 +28,8 @@ PYBIND11_MODULE(ycsbr_py, m) {
            py::arg("value"))
       .def("update", &ycsbr::py::DatabaseInterface::Update, py::arg("key"),
            py::arg("value"))
+      .def("delete", &ycsbr::py::DatabaseInterface::Delete, py::arg("key"),
+           py::arg("tombstone"))
       .def("read", &ycsbr::py::DatabaseInterface::Read, py::arg("key"))
       .def("scan", &ycsbr::py::DatabaseInterface::Scan, py::arg("key"),
            py::arg("amount"));
@@ -75,6 +77,21 @@ PYBIND11_MODULE(ycsbr_py, m) {
           },
           py::arg("index"));
 
+  // Trace binding (a run trace, which may contain any kind of request)
+  py::class_<ycsbr::Trace>(m, "Trace")
+      // Load a new Trace from a serialized file.
+      .def(py::init([](const std::string& path, size_t value_size,
+                       int rng_seed) {
+             ycsbr::Trace::Options options;
+             options.value_size = value_size;
+             options.rng_seed = rng_seed;
+             auto trace = ycsbr::Trace::LoadFromFile(path, options);
+             return std::make_unique<ycsbr::Trace>(std::move(trace));
+           }),
+           py::arg("path"), py::arg("value_size") = 1024,
+           py::arg("rng_seed") = 42)
+      .def("__len__", [](const ycsbr::Trace& trace) { return trace.size(); });
+
   // PhasedWorkload binding
   py::class_<ycsbr::gen::PhasedWorkload>(m, "PhasedWorkload")
       .def_static(
@@ -149,6 +166,14 @@ PYBIND11_MODULE(ycsbr_py, m) {
       .def_property_readonly("num_failed_writes",
                              [](const ycsbr::BenchmarkResult& result) {
                                return result.NumFailedWrites();
+                             })
+      .def_property_readonly("num_deletes",
+                             [](const ycsbr::BenchmarkResult& result) {
+                               return result.Deletes().NumRequests();
+                             })
+      .def_property_readonly("num_failed_deletes",
+                             [](const ycsbr::BenchmarkResult& result) {
+                               return result.NumFailedDeletes();
                              });
 
   // yscbr::Session binding for a delegating database
@@ -182,6 +207,13 @@ PYBIND11_MODULE(ycsbr_py, m) {
             return session.ReplayBulkLoadTrace(trace);
           },
           py::arg("bulk_load_trace"))
+      .def(
+          "replay_trace",
+          [](Session& session, const ycsbr::Trace& trace) {
+            py::gil_scoped_release release;
+            return session.ReplayTrace(trace);
+          },
+          py::arg("trace"))
       .def(
           "run_phased_workload",
           [](Session& session, const ycsbr::gen::PhasedWorkload& workload) {
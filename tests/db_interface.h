@@ -1,11 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "ycsbr/key_encoder.h"
+#include "ycsbr/pinned_value.h"
 #include "ycsbr/request.h"
+#include "ycsbr/scan_visitor.h"
 #include "ycsbr/trace.h"
 
 namespace ycsbr {
@@ -23,6 +32,11 @@ class TestDatabaseInterface {
 
   void BulkLoad(const BulkLoadTrace& load) { ++bulk_load_calls; }
 
+  void BulkLoadPartition(const BulkLoadTrace::Partition& partition) {
+    ++bulk_load_partition_calls;
+    bulk_loaded_records += partition.size();
+  }
+
   bool Update(Request::Key key, const char* value, size_t value_size) {
     ++update_calls;
     return true;
@@ -52,6 +66,8 @@ class TestDatabaseInterface {
   std::atomic<size_t> initialize_calls = 0;
   std::atomic<size_t> shutdown_calls = 0;
   std::atomic<size_t> bulk_load_calls = 0;
+  std::atomic<size_t> bulk_load_partition_calls = 0;
+  std::atomic<size_t> bulk_loaded_records = 0;
   std::atomic<size_t> update_calls = 0;
   std::atomic<size_t> insert_calls = 0;
   std::atomic<size_t> read_calls = 0;
@@ -131,6 +147,31 @@ class KeyFrequencyInterface {
   std::unordered_map<Request::Key, size_t> key_freqs;
 };
 
+class ValueSizeInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {}
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    ++value_sizes[value_size];
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    ++value_sizes[value_size];
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) { return true; }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    return true;
+  }
+
+  // Value size -> Number of writes
+  std::map<size_t, size_t> value_sizes;
+};
+
 class InsertTraceInterface {
  public:
   void InitializeWorker(const std::thread::id& worker_id) {}
@@ -154,4 +195,326 @@ class InsertTraceInterface {
   std::vector<Request::Key> insert_trace;
 };
 
+// Emulates deletes by overwriting the record's value with the tombstone.
+class TombstoneInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (const auto& req : load) {
+      records[req.key] = std::string(req.value, req.value_size);
+    }
+  }
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    records[key] = std::string(value, value_size);
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    records[key] = std::string(value, value_size);
+    return true;
+  }
+  bool Delete(Request::Key key, const char* tombstone, size_t tombstone_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++delete_calls;
+    records[key] = std::string(tombstone, tombstone_size);
+    deleted.insert(key);
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = records.find(key);
+    if (it == records.end()) return false;
+    if (deleted.count(key) > 0) ++deleted_reads;
+    value_out->assign(it->second);
+    return true;
+  }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto it = records.lower_bound(key);
+         it != records.end() && scan_out->size() < amount; ++it) {
+      if (deleted.count(it->first) > 0) ++deleted_scanned;
+      scan_out->emplace_back(it->first, it->second);
+      ++scanned;
+    }
+    return true;
+  }
+
+  std::mutex mutex;
+  std::map<Request::Key, std::string> records;
+  std::unordered_set<Request::Key> deleted;
+  size_t delete_calls = 0;
+  size_t deleted_reads = 0;
+  size_t scanned = 0;
+  size_t deleted_scanned = 0;
+};
+
+// Implements the optional range delete, merge, and compare-and-swap methods.
+// A merge appends its operand to the record's value.
+class AtomicOpsInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (const auto& req : load) {
+      records[req.key] = std::string(req.value, req.value_size);
+    }
+  }
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    records[key] = std::string(value, value_size);
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    records[key] = std::string(value, value_size);
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = records.find(key);
+    if (it == records.end()) return false;
+    value_out->assign(it->second);
+    return true;
+  }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    return true;
+  }
+  bool DeleteRange(Request::Key key, size_t amount) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++delete_range_calls;
+    requested_range_length += amount;
+    max_delete_range_length = std::max(max_delete_range_length, amount);
+    auto it = records.lower_bound(key);
+    for (size_t i = 0; i < amount && it != records.end(); ++i) {
+      it = records.erase(it);
+      ++range_deleted;
+    }
+    return true;
+  }
+  bool Merge(Request::Key key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++merge_calls;
+    records[key].append(value, value_size);
+    return true;
+  }
+  bool CompareAndSwap(Request::Key key, const char* expected,
+                      size_t expected_size, const char* value,
+                      size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    ++compare_and_swap_calls;
+    auto it = records.find(key);
+    if (it == records.end() ||
+        it->second != std::string_view(expected, expected_size)) {
+      return false;
+    }
+    it->second.assign(value, value_size);
+    return true;
+  }
+
+  std::mutex mutex;
+  std::map<Request::Key, std::string> records;
+  size_t delete_range_calls = 0;
+  size_t max_delete_range_length = 0;
+  size_t requested_range_length = 0;
+  size_t range_deleted = 0;
+  size_t merge_calls = 0;
+  size_t compare_and_swap_calls = 0;
+};
+
+// Supports transactions. Every `abort_every`-th commit fails (if non-zero).
+class TransactionInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {}
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    if (InTxn()) ++txn_writes;
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    if (InTxn()) ++txn_writes;
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) {
+    if (InTxn()) ++txn_reads;
+    value_out->assign(8, 'v');
+    return true;
+  }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    return true;
+  }
+  void BeginTxn() {
+    InTxn() = true;
+    ++begin_calls;
+  }
+  bool Commit() {
+    InTxn() = false;
+    const size_t commit_number = ++commit_calls;
+    return abort_every == 0 || commit_number % abort_every != 0;
+  }
+  void Abort() {
+    InTxn() = false;
+    ++abort_calls;
+  }
+
+  size_t abort_every = 0;
+  std::atomic<size_t> begin_calls = 0;
+  std::atomic<size_t> commit_calls = 0;
+  std::atomic<size_t> abort_calls = 0;
+  std::atomic<size_t> txn_reads = 0;
+  std::atomic<size_t> txn_writes = 0;
+
+ private:
+  // Each worker thread runs its own transaction.
+  static bool& InTxn() {
+    thread_local bool in_txn = false;
+    return in_txn;
+  }
+};
+
+// Produces scans through `VisitScan()`. Every key in the range [0, num_keys)
+// is present, and each value is the key's bytes.
+class VisitScanInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {}
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) { return true; }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    ++scan_calls;
+    return true;
+  }
+  bool VisitScan(Request::Key key, size_t amount, ScanVisitor& visitor) {
+    ++visit_scan_calls;
+    for (Request::Key k = key; k < num_keys; ++k) {
+      ++visited_records;
+      if (!visitor(k, std::string_view(reinterpret_cast<const char*>(&k),
+                                       sizeof(k)))) {
+        break;
+      }
+    }
+    return true;
+  }
+
+  Request::Key num_keys = 1000;
+  std::atomic<size_t> scan_calls = 0;
+  std::atomic<size_t> visit_scan_calls = 0;
+  std::atomic<size_t> visited_records = 0;
+};
+
+// Serves reads through `PinnedRead()`. Every value is the same static buffer;
+// the interface counts the values that are still pinned.
+class PinnedReadInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {}
+  bool Update(Request::Key key, const char* value, size_t value_size) {
+    return true;
+  }
+  bool Insert(Request::Key key, const char* value, size_t value_size) {
+    return true;
+  }
+  bool Read(Request::Key key, std::string* value_out) {
+    ++read_calls;
+    return true;
+  }
+  bool PinnedRead(Request::Key key, PinnedValue* value_out) {
+    ++pinned_read_calls;
+    ++pinned;
+    value_out->Pin(std::string_view(value, sizeof(value)), &Release, this);
+    return true;
+  }
+  bool Scan(Request::Key key, size_t amount,
+            std::vector<std::pair<Request::Key, std::string>>* scan_out) {
+    return true;
+  }
+
+  static void Release(void* token) {
+    --static_cast<PinnedReadInterface*>(token)->pinned;
+  }
+
+  const char value[16] = "pinned value";
+  std::atomic<size_t> read_calls = 0;
+  std::atomic<size_t> pinned_read_calls = 0;
+  std::atomic<int64_t> pinned = 0;
+};
+
+// Stores records with string keys (see `KeyEncoder`).
+class StringKeyInterface {
+ public:
+  void InitializeWorker(const std::thread::id& worker_id) {}
+  void ShutdownWorker(const std::thread::id& worker_id) {}
+  void InitializeDatabase() {}
+  void ShutdownDatabase() {}
+  void BulkLoad(const BulkLoadTrace& load) {
+    std::vector<Request::Key> keys;
+    for (const auto& req : load) {
+      keys.push_back(req.key);
+    }
+    KeyBatch batch;
+    encoder.EncodeBatch(keys.data(), keys.size(), &batch);
+    std::unique_lock<std::mutex> lock(mutex);
+    for (size_t i = 0; i < batch.size(); ++i) {
+      records[std::string(batch[i])] = std::string(load[i].value_size, 'v');
+    }
+  }
+  bool Update(std::string_view key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = records.find(std::string(key));
+    if (it == records.end()) return false;
+    it->second.assign(value, value_size);
+    return true;
+  }
+  bool Insert(std::string_view key, const char* value, size_t value_size) {
+    std::unique_lock<std::mutex> lock(mutex);
+    records[std::string(key)] = std::string(value, value_size);
+    return true;
+  }
+  bool Read(std::string_view key, std::string* value_out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    auto it = records.find(std::string(key));
+    if (it == records.end()) return false;
+    value_out->assign(it->second);
+    return true;
+  }
+  bool Scan(std::string_view key, size_t amount,
+            std::vector<std::pair<std::string, std::string>>* scan_out) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto it = records.lower_bound(std::string(key));
+         it != records.end() && scan_out->size() < amount; ++it) {
+      scan_out->emplace_back(it->first, it->second);
+    }
+    return true;
+  }
+
+  KeyEncoder encoder;
+  std::mutex mutex;
+  std::map<std::string, std::string> records;
+};
+
 }  // namespace ycsbr
@@ -0,0 +1,169 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ycsbr/engines.h"
+#include "ycsbr/gen/workload.h"
+#include "ycsbr/session.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::engines;
+using namespace ycsbr::gen;
+
+// Runs one of the YCSB core workloads (`tests/workloads/ycsb_*.yml`) against a
+// reference engine. Each iteration loads a fresh engine and then runs the
+// workload; only the run is timed. Comparing these numbers across commits
+// shows changes in the harness's overhead, since the engines do not change.
+//
+// Run with `--benchmark_filter=BM_YCSB` (the full suite takes a few minutes).
+template <class Engine>
+void BM_YCSB(benchmark::State& state, const char* workload_file) {
+  const size_t num_threads = state.range(0);
+  const std::unique_ptr<PhasedWorkload> workload = PhasedWorkload::LoadFrom(
+      std::filesystem::path(YR_WORKLOADS_DIR) / workload_file);
+  const BulkLoadTrace load = workload->GetLoadTrace();
+
+  size_t num_requests = 0;
+  size_t num_failed = 0;
+  for (auto _ : state) {
+    Session<Engine> session(num_threads);
+    session.Initialize();
+    session.ReplayBulkLoadTrace(load);
+    const BenchmarkResult result = session.RunWorkload(*workload);
+    state.SetIterationTime(
+        result.RunTime<std::chrono::duration<double>>().count());
+    num_requests += result.Reads().NumRequests() +
+                    result.Writes().NumRequests() +
+                    result.Scans().NumRequests();
+    num_failed += result.NumFailedReads() + result.NumFailedWrites() +
+                  result.NumFailedScans();
+  }
+
+  state.SetItemsProcessed(num_requests);
+  state.counters["FailedRequests"] =
+      benchmark::Counter(num_failed, benchmark::Counter::kAvgIterations);
+}
+
+// Writes a run trace in which `delete_pct` percent of the requests delete a
+// distinct loaded key (in random order) and the rest read a uniformly chosen
+// loaded key. Returns the trace file's path, which includes the process ID so
+// that concurrent runs do not overwrite each other's traces.
+std::filesystem::path WriteDeleteHeavyTrace(const size_t num_keys,
+                                            const size_t num_requests,
+                                            const uint32_t delete_pct) {
+  std::vector<Request::Key> delete_order(num_keys);
+  std::iota(delete_order.begin(), delete_order.end(), 0);
+  std::mt19937 rng(42);
+  std::shuffle(delete_order.begin(), delete_order.end(), rng);
+  std::uniform_int_distribution<uint32_t> pct_dist(0, 99);
+  std::uniform_int_distribution<Request::Key> key_dist(0, num_keys - 1);
+
+  const std::filesystem::path trace_file =
+      std::filesystem::temp_directory_path() /
+      ("ycsbr_delete_heavy_" + std::to_string(getpid()) + ".ycsb");
+  std::ofstream out(trace_file, std::ios::binary | std::ios::trunc);
+  size_t next_delete = 0;
+  for (size_t i = 0; i < num_requests; ++i) {
+    const Request::Encoded request =
+        pct_dist(rng) < delete_pct && next_delete < delete_order.size()
+            ? Request::Encoded(Request::Operation::kDelete,
+                               delete_order[next_delete++])
+            : Request::Encoded(Request::Operation::kRead, key_dist(rng));
+    out.write(reinterpret_cast<const char*>(&request), sizeof(request));
+  }
+  return trace_file;
+}
+
+// Replays a delete-heavy trace (`state.range(1)` percent deletes) against a
+// reference engine. Reads of deleted keys fail, so `FailedRequests` grows with
+// the delete proportion.
+template <class Engine>
+void BM_DeleteHeavyTrace(benchmark::State& state) {
+  constexpr size_t kNumKeys = 1000000;
+  constexpr size_t kNumRequests = 1000000;
+  const size_t num_threads = state.range(0);
+  Trace::Options options;
+  options.value_size = 120;
+  std::vector<Request::Key> keys(kNumKeys);
+  std::iota(keys.begin(), keys.end(), 0);
+  const BulkLoadTrace load = BulkLoadTrace::LoadFromKeys(keys, options);
+  const std::filesystem::path trace_file =
+      WriteDeleteHeavyTrace(kNumKeys, kNumRequests, state.range(1));
+  const Trace trace = Trace::LoadFromFile(trace_file, options);
+  std::filesystem::remove(trace_file);
+
+  size_t num_requests = 0;
+  size_t num_failed = 0;
+  for (auto _ : state) {
+    Session<Engine> session(num_threads);
+    session.Initialize();
+    session.ReplayBulkLoadTrace(load);
+    const BenchmarkResult result = session.ReplayTrace(trace);
+    state.SetIterationTime(
+        result.RunTime<std::chrono::duration<double>>().count());
+    num_requests += result.Reads().NumRequests() +
+                    result.Deletes().NumRequests();
+    num_failed += result.NumFailedReads() + result.NumFailedDeletes();
+  }
+
+  state.SetItemsProcessed(num_requests);
+  state.counters["FailedRequests"] =
+      benchmark::Counter(num_failed, benchmark::Counter::kAvgIterations);
+}
+
+// Registers `BM_YCSB_<engine>_<workload>`, e.g., `BM_YCSB_BTreeEngine_a`.
+#define YCSB_BENCHMARK(engine, workload)                       \
+  void BM_YCSB_##engine##_##workload(benchmark::State& state) { \
+    BM_YCSB<engine>(state, "ycsb_" #workload ".yml");           \
+  }                                                             \
+  BENCHMARK(BM_YCSB_##engine##_##workload)                      \
+      ->Arg(1)                                                  \
+      ->Arg(4)                                                  \
+      ->UseManualTime()                                         \
+      ->Unit(benchmark::kMillisecond)
+
+YCSB_BENCHMARK(HashMapEngine, a);
+YCSB_BENCHMARK(HashMapEngine, b);
+YCSB_BENCHMARK(HashMapEngine, c);
+YCSB_BENCHMARK(HashMapEngine, d);
+// The hash map does not support scans, so it cannot run workload E.
+YCSB_BENCHMARK(HashMapEngine, f);
+
+YCSB_BENCHMARK(BTreeEngine, a);
+YCSB_BENCHMARK(BTreeEngine, b);
+YCSB_BENCHMARK(BTreeEngine, c);
+YCSB_BENCHMARK(BTreeEngine, d);
+YCSB_BENCHMARK(BTreeEngine, e);
+YCSB_BENCHMARK(BTreeEngine, f);
+
+YCSB_BENCHMARK(SkipListEngine, a);
+YCSB_BENCHMARK(SkipListEngine, b);
+YCSB_BENCHMARK(SkipListEngine, c);
+YCSB_BENCHMARK(SkipListEngine, d);
+YCSB_BENCHMARK(SkipListEngine, e);
+YCSB_BENCHMARK(SkipListEngine, f);
+
+// Registers `BM_DeleteHeavyTrace<engine>` with 1 and 4 threads and 50% and 90%
+// deletes.
+#define DELETE_HEAVY_BENCHMARK(engine)            \
+  BENCHMARK_TEMPLATE(BM_DeleteHeavyTrace, engine) \
+      ->ArgsProduct({{1, 4}, {50, 90}})           \
+      ->UseManualTime()                           \
+      ->Unit(benchmark::kMillisecond)
+
+DELETE_HEAVY_BENCHMARK(HashMapEngine);
+DELETE_HEAVY_BENCHMARK(BTreeEngine);
+DELETE_HEAVY_BENCHMARK(SkipListEngine);
+
+}  // namespace
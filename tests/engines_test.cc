@@ -0,0 +1,180 @@
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ycsbr/engines.h"
+#include "ycsbr/gen.h"
+#include "ycsbr/session.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::engines;
+
+std::string ValueFor(const Request::Key key) {
+  return "value-" + std::to_string(key);
+}
+
+template <class Engine>
+class EngineTest : public testing::Test {};
+
+using Engines = testing::Types<HashMapEngine, BTreeEngine, SkipListEngine>;
+TYPED_TEST_SUITE(EngineTest, Engines);
+
+template <class Engine>
+class OrderedEngineTest : public testing::Test {};
+
+using OrderedEngines = testing::Types<BTreeEngine, SkipListEngine>;
+TYPED_TEST_SUITE(OrderedEngineTest, OrderedEngines);
+
+TYPED_TEST(EngineTest, PointOperations) {
+  TypeParam db;
+  std::string value;
+  ASSERT_FALSE(db.Read(1, &value));
+  ASSERT_FALSE(db.Update(1, "a", 1));
+  ASSERT_FALSE(db.Delete(1, nullptr, 0));
+
+  ASSERT_TRUE(db.Insert(1, "a", 1));
+  ASSERT_TRUE(db.Read(1, &value));
+  ASSERT_EQ(value, "a");
+  ASSERT_TRUE(db.Update(1, "bc", 2));
+  ASSERT_TRUE(db.Read(1, &value));
+  ASSERT_EQ(value, "bc");
+
+  ASSERT_TRUE(db.Delete(1, nullptr, 0));
+  ASSERT_FALSE(db.Read(1, &value));
+  ASSERT_FALSE(db.Update(1, "d", 1));
+  ASSERT_FALSE(db.Delete(1, nullptr, 0));
+
+  // Inserting a deleted key brings it back.
+  ASSERT_TRUE(db.Insert(1, "e", 1));
+  ASSERT_TRUE(db.Read(1, &value));
+  ASSERT_EQ(value, "e");
+}
+
+TYPED_TEST(EngineTest, ConcurrentInserts) {
+  constexpr size_t kNumThreads = 4;
+  constexpr Request::Key kKeysPerThread = 20000;
+  TypeParam db;
+
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&db, t]() {
+      // The threads' keys interleave, so they insert into the same nodes.
+      for (Request::Key i = 0; i < kKeysPerThread; ++i) {
+        const Request::Key key = i * kNumThreads + t;
+        const std::string value = ValueFor(key);
+        db.Insert(key, value.data(), value.size());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::string value;
+  for (Request::Key key = 0; key < kNumThreads * kKeysPerThread; ++key) {
+    ASSERT_TRUE(db.Read(key, &value)) << key;
+    ASSERT_EQ(value, ValueFor(key));
+  }
+}
+
+TYPED_TEST(OrderedEngineTest, ScanInKeyOrder) {
+  TypeParam db;
+  // Insert the even keys in a scrambled order.
+  for (Request::Key i = 0; i < 10000; ++i) {
+    const Request::Key key = ((i * 7919) % 10000) * 2;
+    const std::string value = ValueFor(key);
+    db.Insert(key, value.data(), value.size());
+  }
+  for (Request::Key key = 1000; key < 2000; key += 2) {
+    db.Delete(key, nullptr, 0);
+  }
+
+  std::vector<std::pair<Request::Key, std::string>> scan_out;
+  ASSERT_TRUE(db.Scan(995, 300, &scan_out));
+  ASSERT_EQ(scan_out.size(), 300);
+  // The scan starts at the first key at least 995 and skips deleted records.
+  ASSERT_EQ(scan_out[0].first, 996);
+  ASSERT_EQ(scan_out[2].first, 2000);
+  for (size_t i = 2; i < scan_out.size(); ++i) {
+    ASSERT_EQ(scan_out[i].first, 2000 + 2 * (i - 2));
+    ASSERT_EQ(scan_out[i].second, ValueFor(scan_out[i].first));
+  }
+
+  // Scans stop at the end of the key range.
+  ASSERT_TRUE(db.Scan(19990, 100, &scan_out));
+  ASSERT_EQ(scan_out.size(), 5);
+
+  ScanVisitor visitor(50);
+  ASSERT_TRUE(db.VisitScan(0, 50, visitor));
+  ASSERT_EQ(visitor.NumRecords(), 50);
+}
+
+TYPED_TEST(OrderedEngineTest, ScansDuringInserts) {
+  constexpr Request::Key kNumKeys = 50000;
+  TypeParam db;
+  std::thread writer([&db]() {
+    for (Request::Key key = 0; key < kNumKeys; ++key) {
+      db.Insert(key, "v", 1);
+    }
+  });
+  std::vector<std::pair<Request::Key, std::string>> scan_out;
+  for (size_t i = 0; i < 200; ++i) {
+    ASSERT_TRUE(db.Scan(i * 100, 100, &scan_out));
+    for (size_t j = 1; j < scan_out.size(); ++j) {
+      ASSERT_LT(scan_out[j - 1].first, scan_out[j].first);
+    }
+  }
+  writer.join();
+  ASSERT_TRUE(db.Scan(0, kNumKeys, &scan_out));
+  ASSERT_EQ(scan_out.size(), kNumKeys);
+}
+
+TYPED_TEST(EngineTest, RunWorkload) {
+  const std::string config = R"(
+    record_size_bytes: 16
+    load:
+      num_records: 1000
+      distribution:
+        type: uniform
+        range_min: 1
+        range_max: 100000
+    run:
+    - num_requests: 2000
+      read:
+        proportion_pct: 50
+        distribution:
+          type: zipfian
+          theta: 0.99
+      update:
+        proportion_pct: 40
+        distribution:
+          type: uniform
+      insert:
+        proportion_pct: 10
+        distribution:
+          type: uniform
+          range_min: 1
+          range_max: 100000
+  )";
+  const auto workload = gen::PhasedWorkload::LoadFromString(config);
+  const BulkLoadTrace load = workload->GetLoadTrace();
+
+  Session<TypeParam> session(2);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(load);
+  const BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+  // Every request is for a key that exists (or is new, for inserts).
+  ASSERT_EQ(result.NumFailedReads(), 0);
+  ASSERT_EQ(result.NumFailedWrites(), 0);
+  ASSERT_EQ(result.Reads().NumRequests() + result.Writes().NumRequests(),
+            2000);
+}
+
+}  // namespace
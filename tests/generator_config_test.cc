@@ -1,3 +1,5 @@
+#include <filesystem>
+#include <map>
 #include <string>
 
 #include "gtest/gtest.h"
@@ -163,6 +165,48 @@ TEST(GeneratorConfigTest, InvalidScanLength) {
   ASSERT_THROW(ParseAndPrepare(config), std::invalid_argument);
 }
 
+TEST(GeneratorConfigTest, InvalidDeleteRangeLength) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 10000000\n"
+      "run:\n"
+      "- num_requests: 1000000\n"
+      "  deleterange:\n"
+      "    max_length: 0\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  merge:\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  ASSERT_THROW(ParseAndPrepare(config), std::invalid_argument);
+}
+
+TEST(GeneratorConfigTest, EmptyTransactions) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 10000000\n"
+      "run:\n"
+      "- num_requests: 1000000\n"
+      "  transaction:\n"
+      "    proportion_pct: 100\n"
+      "    num_reads: 0\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  ASSERT_THROW(ParseAndPrepare(config), std::invalid_argument);
+}
+
 TEST(GeneratorConfigTest, InvalidInserts) {
   const std::string missing_range_config =
       "record_size_bytes: 16\n"
@@ -215,6 +259,45 @@ TEST(GeneratorConfigTest, InvalidInserts) {
   ASSERT_THROW(ParseAndPrepare(invalid_distribution), std::invalid_argument);
 }
 
+TEST(GeneratorConfigTest, DurationPhases) {
+  const std::string header =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 10000000\n"
+      "run:\n";
+  const std::string reads =
+      "  read:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  ASSERT_NO_THROW(ParseAndPrepare(header + "- duration_s: 1.5\n" + reads));
+  ASSERT_NO_THROW(ParseAndPrepare(header +
+                                  "- duration_s: 10\n"
+                                  "  num_requests: 1000\n" +
+                                  reads));
+
+  // Phases need a request count, a duration, or both.
+  ASSERT_THROW(ParseAndPrepare(header + "- " + reads.substr(2)),
+               std::invalid_argument);
+  ASSERT_THROW(ParseAndPrepare(header + "- duration_s: 0\n" + reads),
+               std::invalid_argument);
+
+  // Inserts are generated up front, so they need a request count.
+  const std::string inserts =
+      "- duration_s: 10\n"
+      "  insert:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "      range_min: 100\n"
+      "      range_max: 10000000\n";
+  ASSERT_THROW(ParseAndPrepare(header + inserts), std::invalid_argument);
+}
+
 TEST(GeneratorConfigTest, ValidDists) {
   const std::string config =
       "record_size_bytes: 16\n"
@@ -308,4 +391,111 @@ TEST(GeneratorConfigTest, CustomInsertsNoOffset) {
   ASSERT_NO_THROW(ParseAndPrepareWithCustomInserts(config));
 }
 
+// Counts the requests of each type made by a one-producer run of `workload`.
+std::map<Request::Operation, size_t> CountRequests(PhasedWorkload& workload) {
+  std::map<Request::Operation, size_t> counts;
+  auto producers = workload.GetProducers(1);
+  producers[0].Prepare();
+  producers[0].FinishPrepare();
+  while (producers[0].HasNext()) {
+    ++counts[producers[0].Next().op];
+  }
+  return counts;
+}
+
+TEST(GeneratorConfigTest, YCSBPropertiesWorkloadE) {
+  const std::string properties =
+      "# A comment.\n"
+      "recordcount=1000\n"
+      "operationcount = 2000\n"
+      "workload=site.ycsb.workloads.CoreWorkload\n"
+      "readproportion=0\n"
+      "updateproportion=0\n"
+      "scanproportion=0.95\n"
+      "insertproportion=0.05\n"
+      "requestdistribution=zipfian\n"
+      "maxscanlength=100\n"
+      "scanlengthdistribution=uniform\n";
+  auto workload = PhasedWorkload::LoadFromYCSBPropertiesString(properties);
+  // The default record has 10 fields of 100 bytes.
+  ASSERT_EQ(workload->GetRecordSizeBytes(), 1008);
+  ASSERT_EQ(workload->GetLoadTrace().size(), 1000);
+
+  std::map<Request::Operation, size_t> counts;
+  auto producers = workload->GetProducers(1);
+  producers[0].Prepare();
+  producers[0].FinishPrepare();
+  while (producers[0].HasNext()) {
+    const Request req = producers[0].Next();
+    ++counts[req.op];
+    if (req.op == Request::Operation::kScan) {
+      ASSERT_GE(req.scan_amount, 1);
+      ASSERT_LE(req.scan_amount, 100);
+    }
+  }
+  ASSERT_EQ(counts[Request::Operation::kInsert], 100);
+  ASSERT_EQ(counts[Request::Operation::kScan], 1900);
+  ASSERT_EQ(counts.size(), 2);
+}
+
+TEST(GeneratorConfigTest, YCSBPropertiesDefaults) {
+  // YCSB defaults to 95% reads and 5% updates.
+  auto workload = PhasedWorkload::LoadFromYCSBPropertiesString(
+      "recordcount=100\noperationcount=1000\nfieldcount=2\n"
+      "fieldlength=16\ninsertorder=ordered\n");
+  ASSERT_EQ(workload->GetRecordSizeBytes(), 8 + 2 * 16);
+  const BulkLoadTrace load = workload->GetLoadTrace(/*sort_requests=*/true);
+  ASSERT_EQ(load.size(), 100);
+  // The generator stores the phase and producer IDs in the low 16 bits.
+  ASSERT_EQ(load[0].key >> 16, 0);
+  ASSERT_EQ(load[99].key >> 16, 99);
+
+  // Each request's type is chosen at random, using the proportions.
+  auto counts = CountRequests(*workload);
+  ASSERT_EQ(counts[Request::Operation::kRead] +
+                counts[Request::Operation::kUpdate],
+            1000);
+  ASSERT_NEAR(counts[Request::Operation::kRead], 950, 30);
+}
+
+TEST(GeneratorConfigTest, YCSBPropertiesRoundedProportions) {
+  // The proportions are normalized and rounded to whole percentages.
+  auto workload = PhasedWorkload::LoadFromYCSBPropertiesString(
+      "recordcount=100\noperationcount=1000\nreadproportion=1\n"
+      "updateproportion=1\nreadmodifywriteproportion=1\n");
+  auto counts = CountRequests(*workload);
+  ASSERT_NEAR(counts[Request::Operation::kRead], 340, 50);
+  ASSERT_NEAR(counts[Request::Operation::kUpdate], 330, 50);
+  ASSERT_NEAR(counts[Request::Operation::kReadModifyWrite], 330, 50);
+}
+
+TEST(GeneratorConfigTest, YCSBPropertiesUnsupported) {
+  const std::string base = "recordcount=100\noperationcount=100\n";
+  ASSERT_THROW(PhasedWorkload::LoadFromYCSBPropertiesString("operationcount=1"),
+               std::invalid_argument);
+  ASSERT_THROW(
+      PhasedWorkload::LoadFromYCSBPropertiesString(base + "recordcount=ten\n"),
+      std::invalid_argument);
+  ASSERT_THROW(PhasedWorkload::LoadFromYCSBPropertiesString(
+                   base + "requestdistribution=hotspot\n"),
+               std::invalid_argument);
+  ASSERT_THROW(PhasedWorkload::LoadFromYCSBPropertiesString(
+                   base + "scanproportion=1\nscanlengthdistribution=zipfian\n"),
+               std::invalid_argument);
+}
+
+TEST(GeneratorConfigTest, YCSBCoreWorkloadFiles) {
+  for (const char* name : {"workloada", "workloadb", "workloadc", "workloadd",
+                           "workloade", "workloadf"}) {
+    auto workload = PhasedWorkload::LoadFromYCSBProperties(
+        std::filesystem::path(YR_YCSB_PROPERTIES_DIR) / name);
+    ASSERT_EQ(workload->GetLoadTrace().size(), 1000) << name;
+    size_t num_requests = 0;
+    for (const auto& [op, count] : CountRequests(*workload)) {
+      num_requests += count;
+    }
+    ASSERT_EQ(num_requests, 1000) << name;
+  }
+}
+
 }  // namespace
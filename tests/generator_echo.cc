@@ -37,6 +37,25 @@ void PrintRequest(const Request& req) {
       std::cerr << "[UPDATE]    Key: 0x" << std::hex << req.key << std::dec
                 << "  Value Size: " << req.value_size << std::endl;
       break;
+    case Request::Operation::kDelete:
+      std::cerr << "[DELETE]    Key: 0x" << std::hex << req.key << std::dec
+                << std::endl;
+      break;
+    case Request::Operation::kDeleteRange:
+      std::cerr << "[DEL-RANGE] Key: 0x" << std::hex << req.key << std::dec
+                << "  Length: " << req.scan_amount << std::endl;
+      break;
+    case Request::Operation::kMerge:
+      std::cerr << "[MERGE]     Key: 0x" << std::hex << req.key << std::dec
+                << "  Value Size: " << req.value_size << std::endl;
+      break;
+    case Request::Operation::kCompareAndSwap:
+      std::cerr << "[CAS]       Key: 0x" << std::hex << req.key << std::dec
+                << "  Value Size: " << req.value_size << std::endl;
+      break;
+    case Request::Operation::kTransaction:
+      std::cerr << "[TXN]       Requests: " << req.scan_amount << std::endl;
+      break;
   }
 }
 
@@ -1,5 +1,6 @@
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <random>
 #include <unordered_map>
 #include <unordered_set>
@@ -111,7 +112,7 @@ TEST(GeneratorTest, UniformGenerator) {
 
   PRNG prng(42);
   UniformGenerator generator(num_samples, KeyRange(min, max));
-  std::vector<Request::Key> dest(num_samples + 10, 0);
+  KeyList dest(num_samples + 10, 0);
   generator.Generate(prng, &dest, 10);
 
   // These assertions are mostly just a sanity check.
@@ -137,7 +138,7 @@ TEST(GeneratorTest, HotspotGenerator) {
   HotspotGenerator generator(num_samples, hot_pct, overall, hot);
 
   for (size_t rep = 0; rep < repetitions; ++rep) {
-    std::vector<Request::Key> dest(num_samples + offset, 0);
+    KeyList dest(num_samples + offset, 0);
     generator.Generate(prng, &dest, offset);
 
     size_t hot_count = 0;
@@ -218,9 +219,308 @@ TEST(GeneratorTest, RequestProportions) {
   ASSERT_EQ(num_other_requests, 75);
 }
 
+TEST(GeneratorTest, DeletesLeaveTombstones) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000000\n"
+      "run:\n"
+      "- num_requests: 400\n"
+      "  delete:\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  read:\n"
+      "    proportion_pct: 25\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  scan:\n"
+      "    max_length: 50\n"
+      "    proportion_pct: 25\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  Session<TombstoneInterface> session(1);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+
+  const TombstoneInterface& db = session.db();
+  ASSERT_EQ(db.delete_calls, 200);
+  ASSERT_EQ(db.deleted.size(), 200);
+  // Reading a tombstone is reported as a failed read.
+  ASSERT_EQ(result.NumFailedReads(), db.deleted_reads);
+  // Scans drop the records that hold a tombstone.
+  ASSERT_GT(db.deleted_scanned, 0);
+  ASSERT_EQ(result.Scans().NumRecords(), db.scanned - db.deleted_scanned);
+}
+
+TEST(GeneratorTest, TombstonesAreSharedByProducers) {
+  // Only the first phase deletes, and only one producer gets a delete. The
+  // second phase's reads and scans return records deleted by any producer.
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000000\n"
+      "run:\n"
+      "- num_requests: 1\n"
+      "  delete:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "- num_requests: 1000\n"
+      "  read:\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  scan:\n"
+      "    max_length: 1000\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  const auto producers = workload->GetProducers(3);
+  ASSERT_FALSE(producers[0].TombstoneValue().empty());
+  for (const auto& producer : producers) {
+    ASSERT_EQ(producer.TombstoneValue(), producers[0].TombstoneValue());
+  }
+
+  Session<TombstoneInterface> session(3);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+
+  const TombstoneInterface& db = session.db();
+  ASSERT_EQ(db.delete_calls, 1);
+  ASSERT_EQ(result.NumFailedReads(), db.deleted_reads);
+  ASSERT_GT(db.deleted_scanned, 0);
+  ASSERT_EQ(result.Scans().NumRecords(), db.scanned - db.deleted_scanned);
+}
+
+TEST(GeneratorTest, DeleteRangeMergeCompareAndSwap) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 10000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000000\n"
+      "run:\n"
+      "- num_requests: 1000\n"
+      "  deleterange:\n"
+      "    proportion_pct: 10\n"
+      "    max_length: 5\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  merge:\n"
+      "    proportion_pct: 30\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  compareandswap:\n"
+      "    proportion_pct: 30\n"
+      "    distribution:\n"
+      "      type: zipfian\n"
+      "      theta: 0.99\n"
+      "  read:\n"
+      "    proportion_pct: 30\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  Session<AtomicOpsInterface> session(1);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+
+  const AtomicOpsInterface& db = session.db();
+  ASSERT_GT(db.delete_range_calls, 0);
+  ASSERT_GT(db.merge_calls, 0);
+  ASSERT_GT(db.compare_and_swap_calls, 0);
+  ASSERT_LE(db.max_delete_range_length, 5);
+
+  // Each operation has its own meter.
+  ASSERT_EQ(result.RangeDeletes().NumRequests(), db.delete_range_calls);
+  // Range deletes count the records they asked for, which can be more than
+  // the records they removed.
+  ASSERT_EQ(result.RangeDeletes().NumRecords(), db.requested_range_length);
+  ASSERT_LE(result.RangeDeletes().NumRecords(), db.delete_range_calls * 5);
+  ASSERT_GE(result.RangeDeletes().NumRecords(), db.range_deleted);
+  ASSERT_EQ(result.Merges().NumRequests(), db.merge_calls);
+  // With one thread, no other request runs between a compare-and-swap's read
+  // and its swap.
+  ASSERT_EQ(result.CompareAndSwaps().NumRequests(),
+            db.compare_and_swap_calls);
+  ASSERT_EQ(result.NumFailedCompareAndSwaps(), 0);
+  ASSERT_EQ(result.Writes().NumRequests(), 0);
+
+  // Compare-and-swaps also read the record (deleted records are not swapped).
+  const size_t num_requests =
+      result.Reads().NumRequests() + result.NumFailedReads() +
+      db.delete_range_calls + db.merge_calls;
+  ASSERT_EQ(num_requests, 1000);
+}
+
+const std::string kTransactionConfig =
+    "record_size_bytes: 16\n"
+    "load:\n"
+    "  num_records: 1000\n"
+    "  distribution:\n"
+    "    type: uniform\n"
+    "    range_min: 1\n"
+    "    range_max: 100000000\n"
+    "run:\n"
+    "- num_requests: 500\n"
+    "  transaction:\n"
+    "    proportion_pct: 60\n"
+    "    num_reads: 3\n"
+    "    num_writes: 2\n"
+    "    distribution:\n"
+    "      type: zipfian\n"
+    "      theta: 0.99\n"
+    "  read:\n"
+    "    proportion_pct: 40\n"
+    "    distribution:\n"
+    "      type: uniform\n";
+
+TEST(GeneratorTest, Transactions) {
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(kTransactionConfig);
+  Session<TransactionInterface> session(1);
+  session.db().abort_every = 4;
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+
+  const TransactionInterface& db = session.db();
+  const size_t num_txns = result.Transactions().NumRequests();
+  ASSERT_GT(num_txns, 0);
+  // A transaction counts as one request.
+  ASSERT_EQ(num_txns + result.Reads().NumRequests(), 500);
+  ASSERT_EQ(result.Transactions().NumRecords(), num_txns * 5);
+
+  // Every attempt runs all of the transaction's requests.
+  ASSERT_EQ(db.begin_calls, db.commit_calls);
+  ASSERT_EQ(db.abort_calls, 0);
+  ASSERT_EQ(db.txn_reads, db.begin_calls * 3);
+  ASSERT_EQ(db.txn_writes, db.begin_calls * 2);
+
+  // Aborted transactions are retried until they commit.
+  ASSERT_EQ(result.NumFailedTransactions(), 0);
+  ASSERT_EQ(result.NumTransactionAborts(), db.commit_calls / 4);
+  ASSERT_EQ(result.NumTransactionRetries(), result.NumTransactionAborts());
+  ASSERT_EQ(num_txns + result.NumTransactionAborts(), db.begin_calls);
+  ASSERT_DOUBLE_EQ(result.TransactionAbortRate(),
+                   static_cast<double>(db.commit_calls / 4) / db.begin_calls);
+}
+
+TEST(GeneratorTest, TransactionRetriesRunOut) {
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(kTransactionConfig);
+  Session<TransactionInterface> session(1);
+  session.db().abort_every = 1;
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  RunOptions options;
+  options.max_transaction_retries = 2;
+  BenchmarkResult result = session.RunWorkload(*workload, options);
+  session.Terminate();
+
+  const size_t num_txns = result.NumFailedTransactions();
+  ASSERT_GT(num_txns, 0);
+  ASSERT_EQ(result.Transactions().NumRequests(), 0);
+  ASSERT_EQ(session.db().begin_calls, num_txns * 3);
+  ASSERT_EQ(result.NumTransactionAborts(), num_txns * 3);
+  ASSERT_EQ(result.NumTransactionRetries(), num_txns * 2);
+  ASSERT_DOUBLE_EQ(result.TransactionAbortRate(), 1.0);
+}
+
+TEST(GeneratorTest, ValueSizes) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "value_compression_ratio: 4\n"
+      "load:\n"
+      "  num_records: 100\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000000\n"
+      "run:\n"
+      "- num_requests: 1000\n"
+      "  update:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  value_size:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 200\n"
+      "- num_requests: 1000\n"
+      "  update:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  value_size:\n"
+      "    type: histogram\n"
+      "    buckets:\n"
+      "    - size_bytes: 4096\n"
+      "      weight: 1\n"
+      "    - size_bytes: 32\n"
+      "      weight: 0\n"
+      "- num_requests: 10\n"
+      "  update:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  Session<ValueSizeInterface> session(1);
+  session.Initialize();
+  session.RunWorkload(*workload);
+  session.Terminate();
+
+  const auto& value_sizes = session.db().value_sizes;
+  size_t num_uniform = 0;
+  for (const auto& [size, count] : value_sizes) {
+    if (size >= 100 && size <= 200) num_uniform += count;
+  }
+  ASSERT_EQ(num_uniform, 1000);
+  ASSERT_GT(value_sizes.size(), 50);
+  ASSERT_EQ(value_sizes.at(4096), 1000);
+  ASSERT_EQ(value_sizes.count(32), 0);
+  // The last phase uses the default value size.
+  ASSERT_EQ(value_sizes.at(8), 10);
+}
+
+TEST(GeneratorTest, CompressibleValues) {
+  PRNG prng(42);
+  ValueGenerator values(/*value_size=*/1024, /*compression_ratio=*/4.0, prng);
+  // Each 128 byte fragment repeats a 32 byte random chunk.
+  const char* value = values.NextValue();
+  for (size_t i = 0; i + 32 < 128; ++i) {
+    ASSERT_EQ(value[i], value[i + 32]);
+  }
+  // Consecutive values differ.
+  ASSERT_NE(std::memcmp(value, values.NextValue(), 1024), 0);
+}
+
 TEST(GeneratorTest, Linspace) {
   std::mt19937 prng(42);
-  std::vector<Request::Key> dest(100, 0);
+  gen::KeyList dest(100, 0);
 
   // Simple case: generate dense keys from 0 to 9 inclusive.
   gen::LinspaceGenerator gen1(/*num_keys=*/10, /*start_key=*/0,
@@ -468,6 +768,28 @@ TEST(GeneratorTest, LatestChooser) {
   ASSERT_EQ(max_index200, 199);
 }
 
+TEST(GeneratorTest, LatestChooserDecrease) {
+  constexpr size_t kItemCount = 200;
+  std::mt19937 prng(42);
+  LatestChooser latest(kItemCount, /*theta=*/0.99);
+
+  // Deleting records shrinks the range; the latest index moves down with it.
+  latest.DecreaseItemCountBy(/*delta=*/100);
+  std::unordered_map<size_t, size_t> sel_count;
+  for (size_t i = 0; i < 1000; ++i) {
+    const size_t choice = latest.Next(prng);
+    ASSERT_LT(choice, 100);
+    ++sel_count[choice];
+  }
+  const size_t max_index =
+      std::max_element(sel_count.begin(), sel_count.end(),
+                       [](const auto& pair1, const auto& pair2) {
+                         return pair1.second < pair2.second;
+                       })
+          ->first;
+  ASSERT_EQ(max_index, 99);
+}
+
 TEST(GeneratorTest, InsertOnly) {
   const std::string config =
       "record_size_bytes: 16\n"
@@ -497,6 +819,153 @@ TEST(GeneratorTest, InsertOnly) {
   ASSERT_EQ(session.db().insert_calls, 100);
 }
 
+TEST(GeneratorTest, DurationPhases) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 100\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 100000\n"
+      "run:\n"
+      "- duration_s: 0.2\n"
+      "  read:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      // The request count bounds this phase before its deadline.
+      "- duration_s: 60\n"
+      "  num_requests: 100\n"
+      "  update:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+
+  Session<TestDatabaseInterface> session(2);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  const BenchmarkResult result = session.RunWorkload(*workload);
+  session.Terminate();
+
+  ASSERT_GT(session.db().read_calls, 0);
+  ASSERT_EQ(session.db().update_calls, 100);
+  ASSERT_GE(result.RunTime<std::chrono::milliseconds>().count(), 200);
+  ASSERT_LT(result.RunTime<std::chrono::seconds>().count(), 60);
+
+  // Buffering would generate the duration phase before its deadline starts.
+  BufferedWorkload<PhasedWorkload> bworkload(*workload);
+  ASSERT_THROW(bworkload.GetProducers(2), std::invalid_argument);
+}
+
+TEST(GeneratorTest, SharedChunks) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 100\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 100000\n"
+      "run:\n"
+      "- num_requests: 1000\n"
+      "  read:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      // Phases with inserts still split their requests statically.
+      "- num_requests: 101\n"
+      "  insert:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "      range_min: 100000\n"
+      "      range_max: 200000\n"
+      "- num_requests: 5\n"
+      "  update:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  workload->SetWorkDistribution(WorkDistribution::kSharedChunks,
+                                /*chunk_size=*/16);
+
+  // More workers than there are update chunks.
+  Session<TestDatabaseInterface> session(3);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  session.RunWorkload(*workload);
+  session.Terminate();
+
+  ASSERT_EQ(session.db().read_calls, 1000);
+  ASSERT_EQ(session.db().insert_calls, 101);
+  ASSERT_EQ(session.db().update_calls, 5);
+  ASSERT_THROW(workload->SetWorkDistribution(WorkDistribution::kSharedChunks, 0),
+               std::invalid_argument);
+}
+
+TEST(GeneratorTest, PerPhaseResults) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 100\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 100\n"
+      "    range_max: 100000\n"
+      "run:\n"
+      "- num_requests: 40\n"
+      "  insert:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "      range_min: 100000\n"
+      "      range_max: 200000\n"
+      "- num_requests: 100\n"
+      "  read:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "- num_requests: 10\n"
+      "  scan:\n"
+      "    proportion_pct: 100\n"
+      "    max_length: 5\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  BufferedWorkload<PhasedWorkload> bworkload(*workload);
+
+  for (const bool buffered : {false, true}) {
+    Session<TestDatabaseInterface> session(2);
+    session.Initialize();
+    session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+    const BenchmarkResult result = buffered ? session.RunWorkload(bworkload)
+                                            : session.RunWorkload(*workload);
+    session.Terminate();
+
+    const auto& phases = result.PerPhase();
+    ASSERT_EQ(phases.size(), 3);
+    for (size_t i = 0; i < phases.size(); ++i) {
+      ASSERT_EQ(phases[i].phase_id, i);
+      ASSERT_LE(phases[i].run_time, result.RunTime<std::chrono::nanoseconds>());
+    }
+    ASSERT_EQ(phases[0].writes.NumRequests(), 40);
+    ASSERT_EQ(phases[0].reads.NumRequests(), 0);
+    ASSERT_EQ(phases[1].reads.NumRequests(), 100);
+    ASSERT_EQ(phases[1].writes.NumRequests(), 0);
+    ASSERT_EQ(phases[2].scans.NumRequests(), 10);
+
+    // The aggregate includes every phase.
+    ASSERT_EQ(result.Writes().NumRequests(), 40);
+    ASSERT_EQ(result.Reads().NumRequests(), 100);
+    ASSERT_EQ(result.Scans().NumRequests(), 10);
+  }
+}
+
 TEST(GeneratorTest, BufferedWorkload) {
   const std::string config =
       "record_size_bytes: 16\n"
@@ -0,0 +1,117 @@
+#include "ycsbr/key_encoder.h"
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "db_interface.h"
+#include "gtest/gtest.h"
+#include "ycsbr/gen.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::gen;
+
+TEST(KeyEncoderTest, BigEndianPreservesOrder) {
+  const KeyEncoder encoder = KeyEncoder::BigEndian("user", 24);
+  std::string previous;
+  for (Request::Key key : {0ULL, 1ULL, 255ULL, 256ULL, 1ULL << 40,
+                           ~0ULL}) {
+    const std::string encoded = encoder.EncodeToString(key);
+    ASSERT_EQ(encoded.size(), 24);
+    ASSERT_EQ(encoded.substr(0, 4), "user");
+    ASSERT_LT(previous, encoded);
+    previous = encoded;
+  }
+}
+
+TEST(KeyEncoderTest, HashedKeysAreUniqueAndVariableLength) {
+  const KeyEncoder encoder = KeyEncoder::Hashed("p:", 16, 64);
+  std::set<std::string> keys;
+  std::set<size_t> sizes;
+  for (Request::Key key = 0; key < 10000; ++key) {
+    const std::string encoded = encoder.EncodeToString(key);
+    ASSERT_GE(encoded.size(), 16);
+    ASSERT_LE(encoded.size(), 64);
+    ASSERT_EQ(encoded, encoder.EncodeToString(key));
+    keys.insert(encoded);
+    sizes.insert(encoded.size());
+  }
+  ASSERT_EQ(keys.size(), 10000);
+  ASSERT_GT(sizes.size(), 1);
+}
+
+TEST(KeyEncoderTest, EncodeBatch) {
+  const KeyEncoder encoder = KeyEncoder::Hashed("k", 9, 32);
+  const std::vector<Request::Key> keys = {3, 1, 4, 1, 5};
+  KeyBatch batch;
+  encoder.EncodeBatch(keys.data(), keys.size(), &batch);
+  ASSERT_EQ(batch.size(), keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    ASSERT_EQ(batch[i], encoder.EncodeToString(keys[i]));
+  }
+}
+
+TEST(KeyEncoderTest, RejectsTooSmallKeys) {
+  ASSERT_THROW(KeyEncoder::BigEndian("prefix", 10), std::invalid_argument);
+  ASSERT_THROW(KeyEncoder::Hashed("", 16, 8), std::invalid_argument);
+}
+
+TEST(KeyEncoderTest, SessionWithStringKeys) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "key_encoding:\n"
+      "  type: big_endian\n"
+      "  prefix: \"user\"\n"
+      "  size_bytes: 20\n"
+      "load:\n"
+      "  num_records: 1000\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000000\n"
+      "run:\n"
+      "- num_requests: 1000\n"
+      "  read:\n"
+      "    proportion_pct: 50\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  scan:\n"
+      "    max_length: 10\n"
+      "    proportion_pct: 25\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "  insert:\n"
+      "    proportion_pct: 25\n"
+      "    distribution:\n"
+      "      type: uniform\n"
+      "      range_min: 1\n"
+      "      range_max: 100000000\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  RunOptions options;
+  options.key_encoder = workload->GetKeyEncoder();
+  options.expect_request_success = true;
+
+  Session<StringKeyInterface> session(1);
+  session.db().encoder = options.key_encoder;
+  session.Initialize();
+  session.ReplayBulkLoadTrace(workload->GetLoadTrace());
+  const BenchmarkResult result = session.RunWorkload(*workload, options);
+  session.Terminate();
+
+  // Reads of the loaded (and inserted) keys all succeed, so the string keys
+  // match the ones used in the bulk load.
+  ASSERT_EQ(result.NumFailedReads(), 0);
+  ASSERT_EQ(result.Reads().NumRequests() + result.Scans().NumRequests() +
+                result.Writes().NumRequests(),
+            1000);
+  ASSERT_EQ(session.db().records.size(), 1000 + result.Writes().NumRequests());
+  for (const auto& [key, value] : session.db().records) {
+    ASSERT_EQ(key.size(), 20);
+    ASSERT_EQ(key.substr(0, 4), "user");
+  }
+}
+
+}  // namespace
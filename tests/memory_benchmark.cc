@@ -0,0 +1,59 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ycsbr/memory_options.h"
+#include "ycsbr/request.h"
+#include "ycsbr/trace.h"
+
+namespace {
+
+using namespace ycsbr;
+
+// Replays a trace's requests in a random order, reading each request's key and
+// the start of its value. The access pattern is TLB-bound, so this compares
+// replaying a trace stored in 4 KiB pages with one stored in 2 MiB pages.
+// Run it with `--benchmark_filter=BM_TraceRandomReplay`.
+void BM_TraceRandomReplay(benchmark::State& state) {
+  const size_t num_records = state.range(1);
+  std::vector<Request::Key> keys(num_records);
+  std::iota(keys.begin(), keys.end(), 0);
+
+  Trace::Options options;
+  options.value_size = 64;
+  options.num_unique_values = 0;
+  options.memory.use_huge_pages = state.range(0) != 0;
+  const BulkLoadTrace trace = BulkLoadTrace::LoadFromKeys(keys, options);
+
+  std::vector<uint32_t> order(num_records);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), std::mt19937(42));
+
+  for (auto _ : state) {
+    uint64_t checksum = 0;
+    for (const uint32_t index : order) {
+      const Request& request = trace[index];
+      uint64_t value_word;
+      memcpy(&value_word, request.value, sizeof(value_word));
+      checksum ^= request.key ^ value_word;
+    }
+    benchmark::DoNotOptimize(checksum);
+  }
+  state.SetItemsProcessed(num_records * state.iterations());
+  state.counters["PerRequestLatency"] = benchmark::Counter(
+      num_records * state.iterations(),
+      benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_TraceRandomReplay)
+    ->Args({0, 1 << 20})  // (use_huge_pages, num_records)
+    ->Args({1, 1 << 20})
+    ->Args({0, 1 << 22})
+    ->Args({1, 1 << 22})
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace
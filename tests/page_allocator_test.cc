@@ -0,0 +1,92 @@
+#include "ycsbr/impl/page_allocator.h"
+
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+#include "gtest/gtest.h"
+#include "ycsbr/impl/huge_page_buffer.h"
+#include "ycsbr/memory_options.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::impl;
+
+bool IsHugePageAligned(const void* ptr) {
+  return reinterpret_cast<uintptr_t>(ptr) % kHugePageSize == 0;
+}
+
+MemoryOptions HugePages() {
+  MemoryOptions options;
+  options.use_huge_pages = true;
+  return options;
+}
+
+TEST(PageAllocatorTest, MapsLargeAllocations) {
+  constexpr size_t kNumElements = 3 * kHugePageSize / sizeof(uint64_t) + 1;
+  PageVector<uint64_t> values(kNumElements, 0,
+                              PageAllocator<uint64_t>(HugePages()));
+  ASSERT_TRUE(IsHugePageAligned(values.data()));
+  std::iota(values.begin(), values.end(), 0);
+  // Growing the vector moves the values into a new mapping.
+  values.resize(2 * kNumElements);
+  ASSERT_TRUE(IsHugePageAligned(values.data()));
+  for (size_t i = 0; i < kNumElements; ++i) {
+    ASSERT_EQ(values[i], i);
+    ASSERT_EQ(values[kNumElements + i], 0);
+  }
+}
+
+TEST(PageAllocatorTest, SmallOrUnmappedAllocations) {
+  ASSERT_FALSE(ShouldMapPages(kHugePageSize - 1, HugePages()));
+  ASSERT_TRUE(ShouldMapPages(kHugePageSize, HugePages()));
+
+  // Huge pages are opt-in.
+  const MemoryOptions heap;
+  ASSERT_FALSE(ShouldMapPages(kHugePageSize, heap));
+  MemoryOptions bound = heap;
+  bound.numa_node = 0;
+  ASSERT_TRUE(ShouldMapPages(kHugePageSize, bound));
+
+  PageVector<uint64_t> values(kHugePageSize, 1);
+  ASSERT_EQ(values.get_allocator().options(), heap);
+  ASSERT_NE(values.get_allocator(), PageAllocator<uint64_t>(HugePages()));
+  ASSERT_EQ(values.back(), 1);
+}
+
+TEST(PageAllocatorTest, HugetlbfsFallsBack) {
+  // The reserved huge page pool is usually empty (or too small), in which case
+  // the mapping falls back to transparent huge pages.
+  MemoryOptions options;
+  options.use_hugetlbfs = true;
+  ASSERT_TRUE(ShouldMapPages(kHugePageSize, options));
+  ASSERT_NE(options, HugePages());
+  constexpr size_t kNumElements = 2 * kHugePageSize / sizeof(uint64_t);
+  PageVector<uint64_t> values(kNumElements, 7,
+                              PageAllocator<uint64_t>(options));
+  ASSERT_TRUE(IsHugePageAligned(values.data()));
+  ASSERT_EQ(values.front(), 7);
+  ASSERT_EQ(values.back(), 7);
+}
+
+TEST(PageAllocatorTest, HugePageBuffer) {
+  HugePageBuffer large(kHugePageSize + 1, HugePages());
+  ASSERT_TRUE(large.IsMapped());
+  ASSERT_TRUE(IsHugePageAligned(large.get()));
+  ASSERT_EQ(large[kHugePageSize], 0);
+
+  HugePageBuffer unmapped(kHugePageSize + 1, MemoryOptions());
+  ASSERT_FALSE(unmapped.IsMapped());
+
+  HugePageBuffer small(64, HugePages());
+  ASSERT_FALSE(small.IsMapped());
+  ASSERT_EQ(small[63], 0);
+
+  HugePageBuffer moved(std::move(large));
+  ASSERT_TRUE(moved.IsMapped());
+  ASSERT_EQ(moved.size(), kHugePageSize + 1);
+  ASSERT_EQ(large.get(), nullptr);
+}
+
+}  // namespace
@@ -0,0 +1,66 @@
+#include "ycsbr/perf_counters.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "ycsbr/impl/perf_event_group.h"
+
+namespace {
+
+using namespace ycsbr;
+
+TEST(PerfCountersTest, Arithmetic) {
+  PerfCounters start, end;
+  for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+    start.measured[i] = true;
+    end.measured[i] = i != PerfCounters::kDTLBMisses;
+  }
+  start.counts[PerfCounters::kCycles] = 100;
+  end.counts[PerfCounters::kCycles] = 1100;
+  start.counts[PerfCounters::kInstructions] = 50;
+  end.counts[PerfCounters::kInstructions] = 2050;
+  // Scaled counts may go backwards slightly.
+  start.counts[PerfCounters::kBranchMisses] = 10;
+  end.counts[PerfCounters::kBranchMisses] = 5;
+
+  const PerfCounters diff = end - start;
+  ASSERT_EQ(diff.counts[PerfCounters::kCycles], 1000);
+  ASSERT_EQ(diff.counts[PerfCounters::kBranchMisses], 0);
+  ASSERT_FALSE(diff.Measured(PerfCounters::kDTLBMisses));
+  ASSERT_DOUBLE_EQ(diff.InstructionsPerCycle(), 2.0);
+  ASSERT_DOUBLE_EQ(diff.PerRequest(PerfCounters::kCycles, 10), 100.0);
+  ASSERT_EQ(diff.PerRequest(PerfCounters::kDTLBMisses, 10), 0.0);
+  ASSERT_EQ(diff.PerRequest(PerfCounters::kCycles, 0), 0.0);
+
+  PerfCounters total;
+  ASSERT_FALSE(total.AnyMeasured());
+  ASSERT_EQ(total.InstructionsPerCycle(), 0.0);
+  total += diff;
+  total += diff;
+  ASSERT_TRUE(total.AnyMeasured());
+  ASSERT_EQ(total.counts[PerfCounters::kInstructions], 4000);
+}
+
+TEST(PerfCountersTest, ThreadCountersAreMonotonic) {
+  // The counters may not be available (e.g., in a VM or with a restrictive
+  // `perf_event_paranoid` setting); reading them must still work.
+  const auto& group = impl::PerfEventGroup::ForThisThread();
+  ASSERT_EQ(&group, &impl::PerfEventGroup::ForThisThread());
+  const PerfCounters before = group.Read();
+  std::vector<int> values(1 << 20, 1);
+  volatile long sum = 0;
+  for (const int value : values) sum += value;
+  const PerfCounters after = group.Read();
+  for (size_t i = 0; i < PerfCounters::kNumEvents; ++i) {
+    ASSERT_EQ(before.measured[i], after.measured[i]);
+    if (!group.IsOpen()) {
+      ASSERT_FALSE(after.measured[i]);
+    }
+  }
+  if (after.Measured(PerfCounters::kInstructions)) {
+    ASSERT_GT(after.counts[PerfCounters::kInstructions],
+              before.counts[PerfCounters::kInstructions]);
+  }
+}
+
+}  // namespace
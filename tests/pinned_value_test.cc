@@ -0,0 +1,55 @@
+#include "ycsbr/pinned_value.h"
+
+#include <string>
+#include <utility>
+
+#include "db_interface.h"
+#include "gtest/gtest.h"
+#include "workloads/fixtures.h"
+#include "ycsbr/ycsbr.h"
+
+namespace {
+
+using namespace ycsbr;
+
+void CountRelease(void* token) { ++*static_cast<int*>(token); }
+
+TEST(PinnedValueTest, ReleasesOnce) {
+  const std::string data = "hello";
+  int releases = 0;
+  {
+    PinnedValue value;
+    value.Pin(data, &CountRelease, &releases);
+    ASSERT_EQ(value.value(), "hello");
+
+    // Pinning another value releases the first one.
+    value.Pin(data, &CountRelease, &releases);
+    ASSERT_EQ(releases, 1);
+
+    // Moving transfers the release.
+    PinnedValue other(std::move(value));
+    ASSERT_TRUE(value.value().empty());
+    ASSERT_EQ(other.value(), "hello");
+    ASSERT_EQ(releases, 1);
+  }
+  ASSERT_EQ(releases, 2);
+}
+
+TEST_F(TraceReplayA, SessionPinnedReads) {
+  const Trace trace = Trace::LoadFromFile(trace_file, Trace::Options());
+  Session<PinnedReadInterface> session(1);
+  session.Initialize();
+  const BenchmarkResult result = session.RunWorkload(TraceWorkload(&trace));
+  session.Terminate();
+
+  const PinnedReadInterface& db = session.db();
+  ASSERT_EQ(db.read_calls, 0);
+  ASSERT_GT(db.pinned_read_calls, 0);
+  ASSERT_EQ(result.Reads().NumRequests(), db.pinned_read_calls);
+  // Every pinned value was released.
+  ASSERT_EQ(db.pinned, 0);
+  ASSERT_EQ(result.Reads().TotalBytes(),
+            db.pinned_read_calls * sizeof(db.value));
+}
+
+}  // namespace
@@ -0,0 +1,165 @@
+#include "ycsbr/impl/progress_reporter.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "gtest/gtest.h"
+#include "temp_file.h"
+#include "ycsbr/run_options.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::impl;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+bool Contains(const std::string& text, const std::string& line) {
+  return text.find(line) != std::string::npos;
+}
+
+// Returns a loopback port that was free when this was called (the kernel picks
+// an unused ephemeral port), or 0 on failure.
+uint16_t UnusedPort() {
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  if (fd < 0) return 0;
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = 0;
+  socklen_t length = sizeof(address);
+  uint16_t port = 0;
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+      getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length) == 0) {
+    port = ntohs(address.sin_port);
+  }
+  close(fd);
+  return port;
+}
+
+TEST(ProgressReporterTest, RendersPrometheusText) {
+  auto workers = std::make_unique<LiveMetrics[]>(2);
+  workers[0].Record(LiveMetrics::kRead, nanoseconds(100), 1, true);
+  workers[0].Record(LiveMetrics::kRead, std::nullopt, 0, false);
+  workers[1].Record(LiveMetrics::kScan, nanoseconds(5000), 10, true);
+  workers[1].SetPhase(3);
+
+  RunOptions options;
+  options.report_interval = milliseconds(10);
+  options.report_file = TestTempFile(".prom");
+  ProgressReporter reporter(workers.get(), 2, options);
+  const std::string text = reporter.Render();
+
+  ASSERT_TRUE(Contains(text, "ycsbr_workers 2\n"));
+  ASSERT_TRUE(Contains(
+      text,
+      "ycsbr_requests_total{worker=\"0\",op=\"read\",status=\"ok\"} 1\n"));
+  ASSERT_TRUE(Contains(
+      text,
+      "ycsbr_requests_total{worker=\"0\",op=\"read\",status=\"failed\"} 1\n"));
+  ASSERT_TRUE(Contains(text, "ycsbr_records_total{worker=\"1\"} 10\n"));
+  ASSERT_TRUE(Contains(text, "ycsbr_phase{worker=\"1\"} 3\n"));
+  ASSERT_FALSE(Contains(text, "ycsbr_phase{worker=\"0\"}"));
+  ASSERT_TRUE(Contains(
+      text, "ycsbr_request_latency_ns_bucket{worker=\"0\",le=\"127\"} 1\n"));
+  ASSERT_TRUE(Contains(
+      text, "ycsbr_request_latency_ns_bucket{worker=\"1\",le=\"+Inf\"} 1\n"));
+  ASSERT_TRUE(
+      Contains(text, "ycsbr_request_latency_ns_sum{worker=\"1\"} 5000\n"));
+  ASSERT_TRUE(
+      Contains(text, "ycsbr_request_latency_ns_count{worker=\"0\"} 1\n"));
+  std::filesystem::remove(options.report_file);
+}
+
+TEST(ProgressReporterTest, WritesReportFile) {
+  auto workers = std::make_unique<LiveMetrics[]>(1);
+  RunOptions options;
+  options.report_interval = milliseconds(5);
+  options.report_file = TestTempFile(".prom");
+  {
+    ProgressReporter reporter(workers.get(), 1, options);
+    reporter.Start(std::chrono::steady_clock::now());
+    workers[0].Record(LiveMetrics::kWrite, nanoseconds(100), 1, true);
+    std::this_thread::sleep_for(milliseconds(20));
+    workers[0].Record(LiveMetrics::kWrite, nanoseconds(100), 1, true);
+    reporter.Stop();
+  }
+  std::ifstream in(options.report_file);
+  std::stringstream contents;
+  contents << in.rdbuf();
+  // The final report includes all requests.
+  ASSERT_TRUE(Contains(
+      contents.str(),
+      "ycsbr_requests_total{worker=\"0\",op=\"write\",status=\"ok\"} 2\n"));
+  std::filesystem::remove(options.report_file);
+}
+
+TEST(ProgressReporterTest, ServesMetricsOverHttp) {
+  auto workers = std::make_unique<LiveMetrics[]>(1);
+  workers[0].Record(LiveMetrics::kDelete, nanoseconds(100), 1, true);
+  RunOptions options;
+  options.report_interval = milliseconds(10);
+  // Another process may take the port before the reporter binds to it, so
+  // retry with a new one a few times.
+  std::unique_ptr<ProgressReporter> reporter;
+  for (int attempt = 0; attempt < 10 && reporter == nullptr; ++attempt) {
+    options.report_port = UnusedPort();
+    ASSERT_NE(options.report_port, 0);
+    try {
+      reporter = std::make_unique<ProgressReporter>(workers.get(), 1, options);
+    } catch (const std::invalid_argument&) {
+      // The port was taken in the meantime.
+    }
+  }
+  ASSERT_NE(reporter, nullptr);
+  reporter->Start(std::chrono::steady_clock::now());
+
+  const int fd = socket(AF_INET, SOCK_STREAM, 0);
+  ASSERT_GE(fd, 0);
+  sockaddr_in address;
+  std::memset(&address, 0, sizeof(address));
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  address.sin_port = htons(options.report_port);
+  ASSERT_EQ(
+      connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)), 0);
+  const std::string request = "GET /metrics HTTP/1.1\r\n\r\n";
+  ASSERT_EQ(send(fd, request.data(), request.size(), 0), request.size());
+  std::string response;
+  char buffer[4096];
+  ssize_t received = 0;
+  while ((received = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+    response.append(buffer, received);
+  }
+  close(fd);
+  reporter->Stop();
+
+  ASSERT_EQ(response.rfind("HTTP/1.1 200 OK", 0), 0);
+  ASSERT_TRUE(Contains(
+      response,
+      "ycsbr_requests_total{worker=\"0\",op=\"delete\",status=\"ok\"} 1\n"));
+}
+
+TEST(ProgressReporterTest, NeedsAnOutput) {
+  auto workers = std::make_unique<LiveMetrics[]>(1);
+  RunOptions options;
+  options.report_interval = milliseconds(10);
+  ASSERT_THROW(ProgressReporter(workers.get(), 1, options),
+               std::invalid_argument);
+}
+
+}  // namespace
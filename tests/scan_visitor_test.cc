@@ -0,0 +1,58 @@
+#include "ycsbr/scan_visitor.h"
+
+#include <limits>
+#include <string>
+
+#include "db_interface.h"
+#include "gtest/gtest.h"
+#include "workloads/fixtures.h"
+#include "ycsbr/ycsbr.h"
+
+namespace {
+
+using namespace ycsbr;
+
+TEST(ScanVisitorTest, StopsAfterAmount) {
+  const std::string value(8, 'v');
+  ScanVisitor visitor(/*amount=*/3);
+  ASSERT_TRUE(visitor(1, value));
+  ASSERT_TRUE(visitor(2, value));
+  ASSERT_FALSE(visitor(3, value));
+  ASSERT_EQ(visitor.NumRecords(), 3);
+  ASSERT_EQ(visitor.NumBytes(), 3 * (sizeof(Request::Key) + value.size()));
+}
+
+TEST(ScanVisitorTest, SkipsTombstones) {
+  const std::string value(16, 'v');
+  const std::string tombstone(16, 't');
+  impl::TombstoneMatcher matcher;
+  matcher.SetTombstone(tombstone);
+
+  ScanVisitor visitor(/*amount=*/2, &matcher);
+  ASSERT_TRUE(visitor(1, tombstone));
+  ASSERT_TRUE(visitor(2, value));
+  ASSERT_TRUE(visitor(3, tombstone));
+  ASSERT_FALSE(visitor(4, value));
+  ASSERT_EQ(visitor.NumRecords(), 2);
+  ASSERT_EQ(visitor.NumBytes(), 2 * (sizeof(Request::Key) + value.size()));
+}
+
+TEST_F(TraceReplayE, SessionVisitScan) {
+  const Trace trace = Trace::LoadFromFile(trace_file, Trace::Options());
+  Session<VisitScanInterface> session(1);
+  session.db().num_keys = std::numeric_limits<Request::Key>::max();
+  session.Initialize();
+  const BenchmarkResult result = session.RunWorkload(TraceWorkload(&trace));
+  session.Terminate();
+
+  const VisitScanInterface& db = session.db();
+  ASSERT_EQ(db.scan_calls, 0);
+  ASSERT_GT(db.visit_scan_calls, 0);
+  ASSERT_EQ(result.Scans().NumRequests(), db.visit_scan_calls);
+  // Every visited record counts towards the results.
+  ASSERT_EQ(result.Scans().NumRecords(), db.visited_records);
+  ASSERT_EQ(result.Scans().TotalBytes(),
+            db.visited_records * (2 * sizeof(Request::Key)));
+}
+
+}  // namespace
@@ -1,4 +1,6 @@
+#include <algorithm>
 #include <chrono>
+#include <vector>
 
 #include "db_interface.h"
 #include "gtest/gtest.h"
@@ -30,6 +32,60 @@ TEST_F(TraceReplayA, SessionSimpleRun) {
   ASSERT_EQ(session.db().read_calls + session.db().update_calls, kTraceSize);
 }
 
+TEST_F(TraceReplayA, SessionStartWaitPolicies) {
+  const Trace trace = Trace::LoadFromFile(trace_file, Trace::Options());
+  for (const auto policy : {WaitPolicy::kSpin, WaitPolicy::kSpinThenYield,
+                            WaitPolicy::kSpinThenPark}) {
+    Session<TestDatabaseInterface> session(4);
+    session.Initialize();
+    RunOptions options;
+    options.start_wait_policy = policy;
+    const BenchmarkResult result = session.ReplayTrace(trace, options);
+    session.Terminate();
+    ASSERT_EQ(session.db().read_calls + session.db().update_calls, kTraceSize);
+    ASSERT_GE(result.StartSkew<std::chrono::nanoseconds>().count(), 0);
+    ASSERT_LE(result.StartSkew<std::chrono::nanoseconds>(),
+              result.RunTime<std::chrono::nanoseconds>());
+  }
+}
+
+TEST_F(TraceReplayA, SessionSharedChunks) {
+  const Trace trace = Trace::LoadFromFile(trace_file, Trace::Options());
+  // Chunk sizes that do and do not evenly divide the trace.
+  for (const size_t chunk_size : {size_t(1), size_t(7), kTraceSize * 2}) {
+    Session<TestDatabaseInterface> session(3);
+    session.Initialize();
+    const TraceWorkload workload(&trace, WorkDistribution::kSharedChunks,
+                                 chunk_size);
+    session.RunWorkload(workload);
+    session.Terminate();
+    ASSERT_EQ(session.db().read_calls + session.db().update_calls, kTraceSize);
+  }
+}
+
+TEST_F(TraceReplayA, SessionPerThreadResults) {
+  const Trace trace = Trace::LoadFromFile(trace_file, Trace::Options());
+  const std::vector<size_t> core_map = {0, 0};
+  Session<TestDatabaseInterface> session(2, core_map);
+  session.Initialize();
+  const auto result = session.RunWorkload(TraceWorkload(&trace));
+  session.Terminate();
+  ASSERT_EQ(result.PerThread().size(), 2);
+  size_t total_requests = 0;
+  for (size_t i = 0; i < result.PerThread().size(); ++i) {
+    const auto& thread = result.PerThread()[i];
+    ASSERT_EQ(thread.worker_id, i);
+    ASSERT_EQ(thread.core, 0);
+    total_requests += thread.reads.NumRequests() +
+                      thread.writes.NumRequests() + thread.num_failed;
+  }
+  ASSERT_EQ(total_requests, kTraceSize);
+  const auto fairness = result.ThreadFairness();
+  ASSERT_GE(fairness.max_min_ratio, 1.0);
+  ASSERT_GE(fairness.jains_index, 0.5);
+  ASSERT_LE(fairness.jains_index, 1.0);
+}
+
 TEST_F(TraceLoadA, SessionBulkLoad) {
   const BulkLoadTrace load = BulkLoadTrace::LoadFromFile(trace_file, Trace::Options());
   Session<TestDatabaseInterface> session(1);
@@ -42,6 +98,60 @@ TEST_F(TraceLoadA, SessionBulkLoad) {
   ASSERT_TRUE(result.RunTime<std::chrono::nanoseconds>().count() > 0);
 }
 
+TEST_F(TraceLoadA, SessionParallelBulkLoad) {
+  const BulkLoadTrace load =
+      BulkLoadTrace::LoadFromFile(trace_file, Trace::Options());
+  for (const auto partitioning : {BulkLoadTrace::Partitioning::kKeyRange,
+                                  BulkLoadTrace::Partitioning::kRoundRobin}) {
+    Session<TestDatabaseInterface> session(4);
+    session.Initialize();
+    const auto result = session.ReplayBulkLoadTraceParallel(load, partitioning);
+    session.Terminate();
+    ASSERT_EQ(session.db().bulk_load_calls, 0);
+    ASSERT_EQ(session.db().bulk_load_partition_calls, 4);
+    ASSERT_EQ(session.db().bulk_loaded_records, load.size());
+    ASSERT_EQ(result.Writes().NumRecords(), load.size());
+    ASSERT_EQ(result.Writes().TotalBytes(), load.DatasetSizeBytes());
+    ASSERT_EQ(result.PerThread().size(), 4);
+    size_t records = 0;
+    for (const auto& thread : result.PerThread()) {
+      records += thread.writes.NumRecords();
+    }
+    ASSERT_EQ(records, load.size());
+  }
+}
+
+TEST_F(TraceLoadA, BulkLoadSplit) {
+  Trace::Options options;
+  const BulkLoadTrace load = BulkLoadTrace::LoadFromFile(trace_file, options);
+
+  // Key range partitions are disjoint, sorted, and cover every record.
+  const auto ranges = load.Split(4, BulkLoadTrace::Partitioning::kKeyRange);
+  ASSERT_EQ(ranges.size(), 4);
+  size_t total = 0;
+  Request::Key prev_max = 0;
+  for (const auto& partition : ranges) {
+    ASSERT_EQ(partition.num_partitions(), 4);
+    ASSERT_TRUE(partition.size() == 6 || partition.size() == 7);
+    ASSERT_TRUE(std::is_sorted(partition.begin(), partition.end()));
+    if (partition.id() > 0) {
+      ASSERT_LT(prev_max, partition[0].key);
+    }
+    prev_max = partition[partition.size() - 1].key;
+    total += partition.size();
+  }
+  ASSERT_EQ(total, load.size());
+
+  // Round robin partitions follow the trace order.
+  const auto rr = load.Split(3, BulkLoadTrace::Partitioning::kRoundRobin);
+  ASSERT_EQ(rr[0].size() + rr[1].size() + rr[2].size(), load.size());
+  for (size_t i = 0; i < load.size(); ++i) {
+    ASSERT_EQ(rr[i % 3][i / 3].key, load[i].key);
+  }
+  ASSERT_THROW(load.Split(0, BulkLoadTrace::Partitioning::kRoundRobin),
+               std::invalid_argument);
+}
+
 TEST(SessionTest, NoThreads) {
   ASSERT_THROW(Session<TestDatabaseInterface> session(0), std::invalid_argument);
 }
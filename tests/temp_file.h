@@ -0,0 +1,19 @@
+#pragma once
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <string>
+
+#include "gtest/gtest.h"
+
+// Returns a path in the temporary directory for a file used by the running
+// test. The name includes the test's name and the process ID, so concurrent
+// runs of the test binary do not overwrite each other's files.
+inline std::filesystem::path TestTempFile(const std::string& extension) {
+  const testing::TestInfo* const test =
+      testing::UnitTest::GetInstance()->current_test_info();
+  return std::filesystem::temp_directory_path() /
+         ("ycsbr_" + std::string(test->test_suite_name()) + "_" +
+          test->name() + "_" + std::to_string(getpid()) + extension);
+}
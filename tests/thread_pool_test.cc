@@ -0,0 +1,87 @@
+#include "ycsbr/impl/thread_pool.h"
+
+#include <array>
+#include <atomic>
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace ycsbr::impl;
+
+TEST(ThreadPoolTest, StartAndShutdownHooks) {
+  std::atomic<size_t> started = 0, stopped = 0;
+  {
+    ThreadPool pool(
+        4, [&started]() { ++started; }, [&stopped]() { ++stopped; });
+    ASSERT_EQ(pool.NumThreads(), 4);
+  }
+  ASSERT_EQ(started, 4);
+  ASSERT_EQ(stopped, 4);
+}
+
+TEST(ThreadPoolTest, SubmitReturnsResult) {
+  ThreadPool pool(
+      2, []() {}, []() {});
+  auto future = pool.Submit([](int a, int b) { return a + b; }, 3, 4);
+  ASSERT_EQ(future.get(), 7);
+}
+
+TEST(ThreadPoolTest, ManySmallAndLargeTasks) {
+  // More tasks than the per-worker queues can hold, so the overflow path is
+  // also exercised.
+  constexpr size_t kNumTasks = 20000;
+  std::atomic<size_t> small_sum = 0, large_sum = 0;
+  {
+    ThreadPool pool(
+        3, []() {}, []() {});
+    for (size_t i = 0; i < kNumTasks; ++i) {
+      pool.SubmitNoWait([&small_sum, i]() { small_sum += i; });
+      // Captures more state than fits in the inline task storage.
+      std::array<size_t, 32> payload;
+      payload.fill(1);
+      pool.SubmitNoWait([&large_sum, payload]() { large_sum += payload[31]; });
+    }
+    // The destructor waits for all submitted tasks to run.
+  }
+  ASSERT_EQ(small_sum, kNumTasks * (kNumTasks - 1) / 2);
+  ASSERT_EQ(large_sum, kNumTasks);
+}
+
+TEST(ThreadPoolTest, BlockingTasksRunOnDistinctWorkers) {
+  // The session submits one blocking executor per worker; every task must be
+  // picked up even if workers are parked when the tasks arrive.
+  constexpr size_t kNumThreads = 6;
+  ThreadPool pool(
+      kNumThreads, []() {}, []() {});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  std::promise<void> release;
+  std::shared_future<void> can_finish = release.get_future().share();
+  std::atomic<size_t> running = 0;
+  for (size_t i = 0; i < kNumThreads; ++i) {
+    pool.SubmitNoWait([&running, can_finish]() {
+      ++running;
+      can_finish.wait();
+    });
+  }
+  while (running < kNumThreads) {
+    std::this_thread::yield();
+  }
+  release.set_value();
+}
+
+TEST(ThreadPoolTest, MoveOnlyArguments) {
+  ThreadPool pool(
+      1, []() {}, []() {});
+  auto value = std::make_unique<int>(42);
+  auto future =
+      pool.Submit([](std::unique_ptr<int> v) { return *v; }, std::move(value));
+  ASSERT_EQ(future.get(), 42);
+}
+
+}  // namespace
@@ -0,0 +1,95 @@
+#include "ycsbr/impl/time_series.h"
+
+#include <chrono>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::impl;
+using std::chrono::milliseconds;
+using std::chrono::nanoseconds;
+
+TEST(TimeSeriesTest, LatencyHistogramPercentiles) {
+  LatencyHistogram histogram;
+  ASSERT_EQ(histogram.Percentile(0.5), nanoseconds(0));
+  for (int i = 0; i < 99; ++i) {
+    histogram.Record(nanoseconds(100));
+  }
+  histogram.Record(nanoseconds(5000));
+  ASSERT_EQ(histogram.NumSamples(), 100);
+  // Percentiles are reported as the upper edge of their bucket.
+  ASSERT_EQ(histogram.Percentile(0.5), nanoseconds(127));
+  ASSERT_EQ(histogram.Percentile(0.99), nanoseconds(127));
+  ASSERT_EQ(histogram.Percentile(1.0), nanoseconds(8191));
+
+  LatencyHistogram other;
+  other.Record(nanoseconds(5000));
+  histogram.Merge(other);
+  ASSERT_EQ(histogram.NumSamples(), 101);
+  histogram.Reset();
+  ASSERT_EQ(histogram.NumSamples(), 0);
+}
+
+TEST(TimeSeriesTest, RecorderKeepsMostRecentSamples) {
+  using Clock = TimeSeriesRecorder::Clock;
+  TimeSeriesRecorder disabled;
+  ASSERT_FALSE(disabled.IsEnabled());
+
+  TimeSeriesRecorder recorder(milliseconds(1), /*capacity=*/3);
+  ASSERT_TRUE(recorder.IsEnabled());
+  const auto start = Clock::now();
+  recorder.Start(start);
+  size_t total_requests = 0;
+  while (Clock::now() - start < milliseconds(10)) {
+    recorder.Record(nanoseconds(100), 1);
+    recorder.MaybeTakeSample();
+    ++total_requests;
+  }
+  recorder.Finish(Clock::now());
+
+  const auto samples = recorder.GetSamples(start);
+  ASSERT_EQ(samples.size(), 3);
+  size_t retained_requests = 0;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    retained_requests += samples[i].num_requests;
+    ASSERT_EQ(samples[i].num_requests, samples[i].num_records);
+    ASSERT_EQ(samples[i].latency.NumSamples(), samples[i].num_requests);
+    if (i > 0) {
+      ASSERT_EQ(samples[i].elapsed - samples[i].interval,
+                samples[i - 1].elapsed);
+    }
+  }
+  ASSERT_LT(retained_requests, total_requests);
+  ASSERT_GE(samples.back().elapsed, milliseconds(10));
+}
+
+TEST(TimeSeriesTest, MergeAcrossWorkers) {
+  const auto sample = [](int end_ms, int length_ms, size_t requests) {
+    LatencyHistogram latency;
+    latency.Record(nanoseconds(100));
+    return TimeSeriesSample{milliseconds(end_ms), milliseconds(length_ms),
+                            requests, requests, latency};
+  };
+  // The second worker started 3 ms later than the first.
+  const std::vector<std::vector<TimeSeriesSample>> per_worker = {
+      {sample(10, 10, 100), sample(20, 10, 200), sample(25, 5, 50)},
+      {sample(13, 10, 10), sample(23, 10, 20)}};
+  const auto merged = MergeTimeSeries(per_worker, milliseconds(10));
+  ASSERT_EQ(merged.size(), 3);
+  ASSERT_EQ(merged[0].elapsed, milliseconds(10));
+  ASSERT_EQ(merged[0].num_requests, 110);
+  ASSERT_EQ(merged[1].elapsed, milliseconds(20));
+  ASSERT_EQ(merged[1].num_requests, 220);
+  ASSERT_EQ(merged[1].latency.NumSamples(), 2);
+  // The last interval ends with the run.
+  ASSERT_EQ(merged[2].elapsed, milliseconds(25));
+  ASSERT_EQ(merged[2].interval, milliseconds(5));
+  ASSERT_EQ(merged[2].num_requests, 50);
+
+  ASSERT_TRUE(MergeTimeSeries(per_worker, milliseconds(0)).empty());
+}
+
+}  // namespace
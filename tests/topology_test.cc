@@ -0,0 +1,64 @@
+#include "ycsbr/impl/topology.h"
+
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::impl;
+
+CpuTopology TwoSockets() {
+  return CpuTopology({CpuTopology::Node{0, {0, 1, 2, 3}},
+                      CpuTopology::Node{1, {4, 5, 6, 7}}});
+}
+
+TEST(TopologyTest, ParseCpuList) {
+  ASSERT_EQ(ParseCpuList("0"), std::vector<size_t>({0}));
+  ASSERT_EQ(ParseCpuList("0-3"), std::vector<size_t>({0, 1, 2, 3}));
+  ASSERT_EQ(ParseCpuList("0-1,8,10-11\n"),
+            std::vector<size_t>({0, 1, 8, 10, 11}));
+  ASSERT_TRUE(ParseCpuList("").empty());
+  ASSERT_THROW(ParseCpuList("3-1"), std::invalid_argument);
+}
+
+TEST(TopologyTest, Discover) {
+  const CpuTopology topology = CpuTopology::Discover();
+  ASSERT_GE(topology.NumNodes(), 1);
+  for (const auto& node : topology.nodes()) {
+    ASSERT_FALSE(node.cpus.empty());
+    ASSERT_EQ(topology.NodeOfCpu(node.cpus.front()), node.id);
+  }
+}
+
+TEST(TopologyTest, Compact) {
+  const auto core_map =
+      TwoSockets().MakeCoreMap(6, PlacementPolicy::kCompact);
+  ASSERT_EQ(core_map, std::vector<size_t>({0, 1, 2, 3, 4, 5}));
+}
+
+TEST(TopologyTest, Scatter) {
+  const CpuTopology topology = TwoSockets();
+  const auto core_map = topology.MakeCoreMap(5, PlacementPolicy::kScatter);
+  ASSERT_EQ(core_map, std::vector<size_t>({0, 4, 1, 5, 2}));
+  ASSERT_EQ(topology.NodeOfCpu(core_map[1]), 1);
+}
+
+TEST(TopologyTest, OnePerNode) {
+  const CpuTopology topology = TwoSockets();
+  ASSERT_EQ(topology.MakeCoreMap(2, PlacementPolicy::kOnePerNode),
+            std::vector<size_t>({0, 4}));
+  ASSERT_THROW(topology.MakeCoreMap(3, PlacementPolicy::kOnePerNode),
+               std::invalid_argument);
+}
+
+TEST(TopologyTest, MoreThreadsThanCores) {
+  const auto core_map =
+      TwoSockets().MakeCoreMap(10, PlacementPolicy::kCompact);
+  ASSERT_EQ(core_map.size(), 10);
+  ASSERT_EQ(core_map[8], 0);
+  ASSERT_EQ(core_map[9], 1);
+}
+
+}  // namespace
@@ -0,0 +1,161 @@
+#include "ycsbr/workload_snapshot.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "db_interface.h"
+#include "gtest/gtest.h"
+#include "temp_file.h"
+#include "ycsbr/gen.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::gen;
+
+const std::string kConfig =
+    "record_size_bytes: 32\n"
+    "load:\n"
+    "  num_records: 1000\n"
+    "  distribution:\n"
+    "    type: uniform\n"
+    "    range_min: 1\n"
+    "    range_max: 100000000\n"
+    "run:\n"
+    "- num_requests: 400\n"
+    "  read:\n"
+    "    proportion_pct: 40\n"
+    "    distribution:\n"
+    "      type: zipfian\n"
+    "      theta: 0.99\n"
+    "  update:\n"
+    "    proportion_pct: 20\n"
+    "    distribution:\n"
+    "      type: uniform\n"
+    "  scan:\n"
+    "    max_length: 20\n"
+    "    proportion_pct: 20\n"
+    "    distribution:\n"
+    "      type: uniform\n"
+    "  delete:\n"
+    "    proportion_pct: 20\n"
+    "    distribution:\n"
+    "      type: uniform\n"
+    "- num_requests: 200\n"
+    "  insert:\n"
+    "    proportion_pct: 100\n"
+    "    distribution:\n"
+    "      type: uniform\n"
+    "      range_min: 1\n"
+    "      range_max: 100000000\n";
+
+class WorkloadSnapshotTest : public testing::Test {
+ protected:
+  void TearDown() override { std::filesystem::remove(snapshot_file); }
+
+  const std::filesystem::path snapshot_file = TestTempFile(".snap");
+};
+
+TEST_F(WorkloadSnapshotTest, MatchesGeneratedRequests) {
+  constexpr size_t kNumProducers = 2;
+  PhasedWorkload::LoadFromString(kConfig)->ExportSnapshot(snapshot_file,
+                                                          kNumProducers);
+  const WorkloadSnapshot snapshot = WorkloadSnapshot::Open(snapshot_file);
+  ASSERT_EQ(snapshot.NumProducers(), kNumProducers);
+  std::vector<WorkloadSnapshot::Producer> replayed =
+      snapshot.GetProducers(kNumProducers);
+
+  // The same seed generates the same requests.
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(kConfig);
+  std::vector<PhasedWorkload::Producer> generated =
+      workload->GetProducers(kNumProducers);
+  for (auto& producer : generated) producer.Prepare();
+  for (auto& producer : generated) producer.FinishPrepare();
+
+  for (size_t id = 0; id < kNumProducers; ++id) {
+    replayed[id].Prepare();
+    ASSERT_EQ(replayed[id].TombstoneValue(), generated[id].TombstoneValue());
+    size_t num_requests = 0;
+    while (generated[id].HasNext()) {
+      ASSERT_TRUE(replayed[id].HasNext());
+      ASSERT_EQ(replayed[id].CurrentPhase(), generated[id].CurrentPhase());
+      const Request expected = generated[id].Next();
+      const Request actual = replayed[id].Next();
+      ASSERT_EQ(actual.op, expected.op);
+      ASSERT_EQ(actual.key, expected.key);
+      ASSERT_EQ(actual.scan_amount, expected.scan_amount);
+      ASSERT_EQ(actual.value_size, expected.value_size);
+      if (expected.value != nullptr) {
+        ASSERT_EQ(memcmp(actual.value, expected.value, expected.value_size),
+                  0);
+      }
+      ++num_requests;
+    }
+    ASSERT_FALSE(replayed[id].HasNext());
+    ASSERT_EQ(num_requests, 300);
+  }
+}
+
+TEST_F(WorkloadSnapshotTest, RunSnapshot) {
+  constexpr size_t kNumProducers = 2;
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(kConfig);
+  const BulkLoadTrace load = workload->GetLoadTrace();
+  workload->ExportSnapshot(snapshot_file, kNumProducers);
+  const WorkloadSnapshot snapshot = WorkloadSnapshot::Open(snapshot_file);
+
+  Session<TombstoneInterface> session(kNumProducers);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(load);
+  const BenchmarkResult result = session.RunWorkload(snapshot);
+  session.Terminate();
+
+  const TombstoneInterface& db = session.db();
+  ASSERT_EQ(db.delete_calls, 80);
+  ASSERT_EQ(db.deleted.size(), 80);
+  ASSERT_EQ(result.PerPhase().size(), 2);
+  // The inserted keys are new.
+  ASSERT_EQ(db.records.size(), load.size() + 200);
+
+  ASSERT_THROW(snapshot.GetProducers(kNumProducers + 1),
+               std::invalid_argument);
+}
+
+TEST_F(WorkloadSnapshotTest, RejectsDurationPhases) {
+  const std::string config =
+      "record_size_bytes: 16\n"
+      "load:\n"
+      "  num_records: 100\n"
+      "  distribution:\n"
+      "    type: uniform\n"
+      "    range_min: 1\n"
+      "    range_max: 100000\n"
+      "run:\n"
+      "- duration_s: 0.1\n"
+      "  read:\n"
+      "    proportion_pct: 100\n"
+      "    distribution:\n"
+      "      type: uniform\n";
+  std::unique_ptr<PhasedWorkload> workload =
+      PhasedWorkload::LoadFromString(config);
+  ASSERT_THROW(WorkloadSnapshot::Export(*workload, 2, snapshot_file),
+               std::invalid_argument);
+  ASSERT_FALSE(std::filesystem::exists(snapshot_file));
+}
+
+TEST_F(WorkloadSnapshotTest, InvalidFile) {
+  ASSERT_THROW(WorkloadSnapshot::Open(snapshot_file), std::runtime_error);
+  {
+    std::ofstream out(snapshot_file);
+    out << "not a snapshot file";
+  }
+  ASSERT_THROW(WorkloadSnapshot::Open(snapshot_file), std::runtime_error);
+}
+
+}  // namespace
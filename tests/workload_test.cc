@@ -1,7 +1,15 @@
 #include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
 #include <stdexcept>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
+#include "db_interface.h"
 #include "gtest/gtest.h"
+#include "temp_file.h"
 #include "workloads/fixtures.h"
 #include "ycsbr/ycsbr.h"
 
@@ -200,4 +208,243 @@ TEST(TraceTest, BulkLoadFromKeys) {
   }
 }
 
+std::vector<Request::Key> SequentialKeys(size_t num_keys) {
+  std::vector<Request::Key> keys(num_keys);
+  std::iota(keys.begin(), keys.end(), 0);
+  return keys;
+}
+
+TEST(TraceTest, UniqueValues) {
+  Trace::Options options;
+  options.value_size = 16;
+  options.num_unique_values = 8;
+  const BulkLoadTrace load =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(100), options);
+  std::unordered_set<const char*> values;
+  for (const auto& req : load) {
+    values.insert(req.value);
+  }
+  ASSERT_EQ(values.size(), 8);
+
+  // Every write gets its own value.
+  options.num_unique_values = 0;
+  const BulkLoadTrace unique =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(100), options);
+  values.clear();
+  for (const auto& req : unique) {
+    values.insert(req.value);
+  }
+  ASSERT_EQ(values.size(), unique.size());
+}
+
+TEST(TraceTest, VariableValueSizes) {
+  Trace::Options options;
+  options.value_size = 16;
+  options.max_value_size = 64;
+  options.num_unique_values = 0;
+  const BulkLoadTrace load =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(1000), options);
+  size_t min_size = options.max_value_size;
+  size_t max_size = 0;
+  for (const auto& req : load) {
+    min_size = std::min(min_size, req.value_size);
+    max_size = std::max(max_size, req.value_size);
+  }
+  ASSERT_GE(min_size, options.value_size);
+  ASSERT_LE(max_size, options.max_value_size);
+  ASSERT_LT(min_size, max_size);
+}
+
+TEST(TraceTest, ValueContent) {
+  Trace::Options options;
+  options.value_size = 256;
+  options.value_content = Trace::Options::ValueContent::kZeros;
+  const BulkLoadTrace zeros =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(10), options);
+  for (const auto& req : zeros) {
+    for (size_t i = 0; i < req.value_size; ++i) {
+      ASSERT_EQ(req.value[i], 0);
+    }
+  }
+
+  // Each 128 byte fragment of a compressible value repeats a 32 byte chunk.
+  options.value_content = Trace::Options::ValueContent::kCompressible;
+  options.value_compression_ratio = 4.0;
+  options.memory.use_huge_pages = false;
+  const BulkLoadTrace compressible =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(10), options);
+  for (const auto& req : compressible) {
+    for (size_t i = 32; i < 128; ++i) {
+      ASSERT_EQ(req.value[i], req.value[i % 32]);
+    }
+  }
+
+  options.value_compression_ratio = 0.5;
+  ASSERT_THROW(BulkLoadTrace::LoadFromKeys(SequentialKeys(10), options),
+               std::invalid_argument);
+}
+
+// Writes `requests` to a trace file in the format `Trace::LoadFromFile()`
+// reads. `amounts` holds the counts that follow the scans, range deletes, and
+// transactions in `requests`, in order. Returns the file's path.
+std::filesystem::path WriteTraceFile(
+    const std::vector<Request::Encoded>& requests,
+    const std::vector<uint32_t>& amounts = {}) {
+  const std::filesystem::path trace_file = TestTempFile(".ycsb");
+  std::ofstream out(trace_file, std::ios::binary | std::ios::trunc);
+  auto next_amount = amounts.begin();
+  for (const auto& request : requests) {
+    out.write(reinterpret_cast<const char*>(&request), sizeof(request));
+    if (request.op == Request::Operation::kScan ||
+        request.op == Request::Operation::kDeleteRange ||
+        request.op == Request::Operation::kTransaction) {
+      EXPECT_NE(next_amount, amounts.end());
+      const uint32_t amount = next_amount != amounts.end() ? *next_amount++ : 0;
+      out.write(reinterpret_cast<const char*>(&amount), sizeof(amount));
+    }
+  }
+  return trace_file;
+}
+
+TEST(TraceTest, Deletes) {
+  using Op = Request::Operation;
+  const std::filesystem::path trace_file =
+      WriteTraceFile({Request::Encoded(Op::kInsert, 1),
+                      Request::Encoded(Op::kDelete, 1),
+                      Request::Encoded(Op::kRead, 1),
+                      Request::Encoded(Op::kDelete, 2),
+                      Request::Encoded(Op::kRead, 3)});
+  Trace::Options options;
+  options.value_size = 16;
+  options.value_content = Trace::Options::ValueContent::kZeros;
+  const Trace trace = Trace::LoadFromFile(trace_file, options);
+  ASSERT_THROW(BulkLoadTrace::LoadFromFile(trace_file, options),
+               std::invalid_argument);
+  std::filesystem::remove(trace_file);
+
+  // Every delete passes the trace's tombstone, which differs from the values.
+  const std::string_view tombstone = trace.TombstoneValue();
+  ASSERT_EQ(tombstone.size(), options.value_size);
+  ASSERT_NE(tombstone, std::string_view(trace[0].value, trace[0].value_size));
+  for (const auto& req : trace) {
+    if (req.op != Op::kDelete) continue;
+    ASSERT_EQ(req.value, tombstone.data());
+    ASSERT_EQ(req.value_size, tombstone.size());
+  }
+
+  // Reading key 1's tombstone is reported as a failed read.
+  Session<TombstoneInterface> session(1);
+  session.Initialize();
+  session.ReplayBulkLoadTrace(
+      BulkLoadTrace::LoadFromKeys(std::vector<Request::Key>{2, 3}, options));
+  const BenchmarkResult result = session.ReplayTrace(trace);
+  session.Terminate();
+  ASSERT_EQ(session.db().delete_calls, 2);
+  ASSERT_EQ(result.Deletes().NumRequests(), 2);
+  // Only the read of key 3 succeeds.
+  ASSERT_EQ(result.Reads().NumRequests(), 1);
+  ASSERT_EQ(result.NumFailedReads(), 1);
+
+  // Traces without deletes have no tombstone.
+  const BulkLoadTrace load =
+      BulkLoadTrace::LoadFromKeys(SequentialKeys(10), options);
+  ASSERT_TRUE(load.TombstoneValue().empty());
+}
+
+TEST(TraceTest, Transactions) {
+  using Op = Request::Operation;
+  // A transaction's request count follows it, like a scan's length.
+  const std::filesystem::path trace_file = WriteTraceFile(
+      {Request::Encoded(Op::kTransaction, 0), Request::Encoded(Op::kRead, 1),
+       Request::Encoded(Op::kUpdate, 2), Request::Encoded(Op::kRead, 3)},
+      /*amounts=*/{2});
+  Trace::Options options;
+  options.value_size = 16;
+  const Trace trace = Trace::LoadFromFile(trace_file, options);
+  std::filesystem::remove(trace_file);
+  ASSERT_EQ(trace.size(), 4);
+  ASSERT_TRUE(trace.HasTransactions());
+  ASSERT_EQ(trace[0].op, Op::kTransaction);
+  ASSERT_EQ(trace[0].scan_amount, 2);
+  ASSERT_EQ(trace[3].key, 3);
+
+  Session<TransactionInterface> session(1);
+  session.Initialize();
+  const BenchmarkResult result = session.ReplayTrace(trace);
+  session.Terminate();
+  ASSERT_EQ(session.db().begin_calls, 1);
+  ASSERT_EQ(session.db().txn_reads, 1);
+  ASSERT_EQ(session.db().txn_writes, 1);
+  ASSERT_EQ(result.Transactions().NumRequests(), 1);
+  ASSERT_EQ(result.Transactions().NumRecords(), 2);
+  ASSERT_EQ(result.Reads().NumRequests(), 1);
+  ASSERT_EQ(result.Writes().NumRequests(), 0);
+}
+
+TEST(TraceTest, TransactionsAreNotSplitBetweenProducers) {
+  using Op = Request::Operation;
+  // One read, then 25 transactions of three requests each. An even split of
+  // the 101 requests between two producers falls inside a transaction.
+  constexpr size_t kNumTxns = 25;
+  std::vector<Request::Encoded> requests = {Request::Encoded(Op::kRead, 0)};
+  for (size_t i = 0; i < kNumTxns; ++i) {
+    requests.emplace_back(Op::kTransaction, 0);
+    requests.emplace_back(Op::kRead, i);
+    requests.emplace_back(Op::kUpdate, i);
+    requests.emplace_back(Op::kRead, i + 1);
+  }
+  const std::filesystem::path trace_file =
+      WriteTraceFile(requests, std::vector<uint32_t>(kNumTxns, 3));
+  Trace::Options options;
+  options.value_size = 16;
+  const Trace trace = Trace::LoadFromFile(trace_file, options);
+  std::filesystem::remove(trace_file);
+  ASSERT_EQ(trace.size(), 1 + 4 * kNumTxns);
+
+  // Chunk sizes smaller than, equal to, and larger than a transaction.
+  const std::vector<TraceWorkload> workloads = {
+      TraceWorkload(&trace),
+      TraceWorkload(&trace, WorkDistribution::kSharedChunks, 2),
+      TraceWorkload(&trace, WorkDistribution::kSharedChunks, 4),
+      TraceWorkload(&trace, WorkDistribution::kSharedChunks, 7)};
+  for (const auto& workload : workloads) {
+    // Each producer gets whole transactions.
+    auto producers = workload.GetProducers(2);
+    size_t num_requests = 0;
+    for (auto& producer : producers) {
+      producer.Prepare();
+      while (producer.HasNext()) {
+        const Request req = producer.Next();
+        ++num_requests;
+        if (req.op != Op::kTransaction) continue;
+        for (size_t i = 0; i < req.scan_amount; ++i) {
+          ASSERT_TRUE(producer.HasNext());
+          ASSERT_NE(producer.Next().op, Op::kTransaction);
+          ++num_requests;
+        }
+      }
+    }
+    ASSERT_EQ(num_requests, trace.size());
+
+    Session<TransactionInterface> session(2);
+    session.Initialize();
+    const BenchmarkResult result = session.RunWorkload(workload);
+    session.Terminate();
+    ASSERT_EQ(session.db().begin_calls, kNumTxns);
+    ASSERT_EQ(session.db().txn_reads, 2 * kNumTxns);
+    ASSERT_EQ(session.db().txn_writes, kNumTxns);
+    ASSERT_EQ(result.Transactions().NumRequests(), kNumTxns);
+    ASSERT_EQ(result.Reads().NumRequests(), 1);
+  }
+}
+
+TEST(TraceTest, UnknownOperationInvalid) {
+  const std::filesystem::path trace_file = WriteTraceFile(
+      {Request::Encoded(Request::Operation::kRead, 1),
+       Request::Encoded(static_cast<Request::Operation>(200), 2)});
+  const Trace::Options options;
+  ASSERT_THROW(Trace::LoadFromFile(trace_file, options), std::invalid_argument);
+  std::filesystem::remove(trace_file);
+}
+
 }  // namespace
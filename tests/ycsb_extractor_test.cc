@@ -0,0 +1,116 @@
+#include "../extractors/ycsb_parser.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "temp_file.h"
+#include "ycsbr/trace.h"
+
+namespace {
+
+using namespace ycsbr;
+using namespace ycsbr::extractors;
+
+const std::string kYCSBOutput =
+    "Loading workload...\n"
+    "READ usertable user6284781860667377211 [ <all fields>]\n"
+    "UPDATE usertable user8517097267634966620 [ field1=abc ]\n"
+    "INSERT usertable user1 [ field0=xyz field1=123 ]\n"
+    "SCAN usertable user4052466453699787802 82 [ <all fields>]\n"
+    "DELETE usertable user42\n"
+    "READMODIFYWRITE usertable user7 [ <all fields>] [ field2=def ]\n"
+    "[OVERALL], RunTime(ms), 1234\n"
+    "READ usertable user99";
+
+std::vector<ParsedRequest> ParseAll(const std::string& input) {
+  std::vector<ParsedRequest> requests;
+  ParseLines(input.data(), input.data() + input.size(), &requests);
+  return requests;
+}
+
+TEST(YCSBExtractorTest, ParseLines) {
+  const std::vector<ParsedRequest> requests = ParseAll(kYCSBOutput);
+  ASSERT_EQ(requests.size(), 7);
+
+  ASSERT_EQ(requests[0].op, Request::Operation::kRead);
+  ASSERT_EQ(requests[0].key, 6284781860667377211ULL);
+  ASSERT_EQ(requests[1].op, Request::Operation::kUpdate);
+  ASSERT_EQ(requests[1].key, 8517097267634966620ULL);
+  ASSERT_EQ(requests[2].op, Request::Operation::kInsert);
+  ASSERT_EQ(requests[2].key, 1);
+  ASSERT_EQ(requests[3].op, Request::Operation::kScan);
+  ASSERT_EQ(requests[3].key, 4052466453699787802ULL);
+  ASSERT_EQ(requests[3].scan_amount, 82);
+  ASSERT_EQ(requests[4].op, Request::Operation::kDelete);
+  ASSERT_EQ(requests[4].key, 42);
+  ASSERT_EQ(requests[5].op, Request::Operation::kReadModifyWrite);
+  ASSERT_EQ(requests[5].key, 7);
+  // The last line has no trailing newline.
+  ASSERT_EQ(requests[6].op, Request::Operation::kRead);
+  ASSERT_EQ(requests[6].key, 99);
+}
+
+TEST(YCSBExtractorTest, SplitAtNewlines) {
+  const char* begin = kYCSBOutput.data();
+  const char* end = begin + kYCSBOutput.size();
+  for (size_t num_slices = 1; num_slices <= 16; ++num_slices) {
+    const std::vector<std::string_view> slices =
+        SplitAtNewlines(begin, end, num_slices);
+    ASSERT_LE(slices.size(), num_slices);
+
+    // The slices cover the input and only split it after a newline.
+    const char* expected_begin = begin;
+    for (const auto& slice : slices) {
+      ASSERT_EQ(slice.data(), expected_begin);
+      ASSERT_FALSE(slice.empty());
+      if (slice.data() + slice.size() < end) {
+        ASSERT_EQ(slice.back(), '\n');
+      }
+      expected_begin = slice.data() + slice.size();
+    }
+    ASSERT_EQ(expected_begin, end);
+
+    // Parsing the slices separately finds the same requests.
+    std::vector<ParsedRequest> requests;
+    for (const auto& slice : slices) {
+      ParseLines(slice.data(), slice.data() + slice.size(), &requests);
+    }
+    ASSERT_EQ(requests.size(), 7);
+  }
+}
+
+TEST(YCSBExtractorTest, EncodedTraceLoads) {
+  const std::filesystem::path trace_file = TestTempFile(".ycsb");
+  std::string encoded;
+  ASSERT_EQ(ParseAndEncodeLines(kYCSBOutput.data(),
+                                kYCSBOutput.data() + kYCSBOutput.size(),
+                                &encoded),
+            7);
+  {
+    std::ofstream out(trace_file, std::ios::binary | std::ios::trunc);
+    out.write(encoded.data(), encoded.size());
+  }
+
+  Trace::Options options;
+  options.value_size = 16;
+  const Trace trace = Trace::LoadFromFile(trace_file, options);
+  std::filesystem::remove(trace_file);
+
+  const std::vector<ParsedRequest> expected = ParseAll(kYCSBOutput);
+  ASSERT_EQ(trace.size(), expected.size());
+  for (size_t i = 0; i < trace.size(); ++i) {
+    ASSERT_EQ(trace[i].op, expected[i].op);
+    ASSERT_EQ(trace[i].key, expected[i].key);
+    ASSERT_EQ(trace[i].scan_amount, expected[i].scan_amount);
+  }
+  // Read-modify-writes write a value, just like updates.
+  ASSERT_NE(trace[5].value, nullptr);
+  ASSERT_EQ(trace[5].value_size, options.value_size);
+  // Deletes pass the trace's tombstone.
+  ASSERT_EQ(trace[4].value, trace.TombstoneValue().data());
+}
+
+}  // namespace